@@ -0,0 +1,115 @@
+/**
+ * @file ArithmeticBenchmark.cpp
+ * @brief Measures the InfiniteInt kernels: add, subtract, multiply, divide,
+ *    remainder, powmod and decimal text conversion, at several operand sizes.
+ *    Also the training workload for profile-guided builds.
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "../InfiniteInt.h"    // kernels being measured
+#include "../NumberTheory.h"   // powmod
+#include <chrono>              // timing
+#include <iomanip>             // table formatting
+#include <iostream>            // results
+#include <sstream>             // building operands from text
+#include <string>              // operand text
+#include <vector>              // operand lists
+
+static unsigned long long benchmarkSeed = 12345;   // state of the operand generator
+
+/** randomOperand(int, bool)
+ * @brief   Builds a pseudo-random InfiniteInt with exactly the requested number of digits.
+ * @param   numDigits   The number of decimal digits
+ * @param   negative    True if the result should be negative
+ * @return  The generated value.
+*/
+static InfiniteInt randomOperand(int numDigits, bool negative) {
+   std::string text = negative ? "-" : "";
+   for (int i = 0; i < numDigits; ++i) {
+      benchmarkSeed = benchmarkSeed * 6364136223846793005ULL + 1442695040888963407ULL;
+      int digit = static_cast<int>((benchmarkSeed >> 33) % 10);
+      if (i == 0 && digit == 0) {
+         digit = 1;
+      }
+      text += static_cast<char>('0' + digit);
+   }
+   std::stringstream stream(text);
+   InfiniteInt value;
+   stream >> value;
+   return value;
+}
+
+/** timePerOperation(int, Operation)
+ * @brief   Runs an operation repeatedly and times it.
+ * @param   repetitions   The number of times to run the operation
+ * @param   operation     Callable taking the repetition index and returning
+ *                        the number of digits of its result
+ * @return  The average wall-clock microseconds per call.
+*/
+template <typename Operation>
+static double timePerOperation(int repetitions, Operation operation) {
+   static long long digitSink = 0;   // keeps results observable so they are computed
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < repetitions; ++i) {
+      digitSink += operation(i);
+   }
+   auto elapsed = std::chrono::steady_clock::now() - start;
+   return std::chrono::duration<double, std::micro>(elapsed).count() / repetitions;
+}
+
+int main() {
+   const int operandDigits[] = {20, 100, 400};
+   const int numOperands = 8;
+
+   std::cout << std::setw(8) << "digits" << std::setw(12) << "add us" << std::setw(12) << "sub us"
+             << std::setw(12) << "mul us" << std::setw(12) << "div us" << std::setw(12) << "mod us"
+             << std::setw(12) << "text us" << std::setw(12) << "powmod us" << '\n';
+   for (int digits : operandDigits) {
+      // Mixed signs; divisors are half as long so quotients are not trivial
+      std::vector<InfiniteInt> lhs;
+      std::vector<InfiniteInt> rhs;
+      std::vector<InfiniteInt> divisors;
+      for (int i = 0; i < numOperands; ++i) {
+         lhs.push_back(randomOperand(digits, i % 2 == 1));
+         rhs.push_back(randomOperand(digits, i % 3 == 1));
+         divisors.push_back(randomOperand(digits / 2, i % 4 == 1));
+      }
+      int repetitions = 40000 / digits;
+
+      double addUs = timePerOperation(repetitions, [&](int i) {
+         return (lhs[i % numOperands] + rhs[(i + 1) % numOperands]).numDigits();
+      });
+      double subtractUs = timePerOperation(repetitions, [&](int i) {
+         return (lhs[i % numOperands] - rhs[(i + 1) % numOperands]).numDigits();
+      });
+      double multiplyUs = timePerOperation(repetitions / 10 + 1, [&](int i) {
+         return (lhs[i % numOperands] * rhs[(i + 1) % numOperands]).numDigits();
+      });
+      double divideUs = timePerOperation(repetitions / 10 + 1, [&](int i) {
+         return (lhs[i % numOperands] / divisors[(i + 1) % numOperands]).numDigits();
+      });
+      double remainderUs = timePerOperation(repetitions / 10 + 1, [&](int i) {
+         return (lhs[i % numOperands] % divisors[(i + 1) % numOperands]).numDigits();
+      });
+      double textUs = timePerOperation(repetitions, [&](int i) {
+         // A fresh sum has no cached text, so every call converts
+         InfiniteInt copy(lhs[i % numOperands] + rhs[i % numOperands]);
+         return static_cast<int>(copy.toString().size());
+      });
+
+      // powmod with a modulus of the operand size and a 16-digit exponent
+      InfiniteInt modulus = randomOperand(digits, false);
+      InfiniteInt exponent = randomOperand(16, false);
+      double powmodUs = timePerOperation(digits <= 100 ? 2 : 1, [&](int i) {
+         return powmod(rhs[i % numOperands], exponent, modulus).numDigits();
+      });
+
+      std::cout << std::setw(8) << digits << std::fixed << std::setprecision(1)
+                << std::setw(12) << addUs << std::setw(12) << subtractUs
+                << std::setw(12) << multiplyUs << std::setw(12) << divideUs
+                << std::setw(12) << remainderUs << std::setw(12) << textUs
+                << std::setw(12) << powmodUs << '\n';
+   }
+   return 0;
+}
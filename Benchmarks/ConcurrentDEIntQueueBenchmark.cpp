@@ -0,0 +1,125 @@
+/** 
+ * @file ConcurrentDEIntQueueBenchmark.cpp
+ * @brief Compares ConcurrentDEIntQueue against a std::deque guarded by a std::mutex
+ *    with 1 to 64 threads pushing and popping at both ends
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "../ConcurrentDEIntQueue.h"  // queue being measured
+#include <chrono>                     // timing
+#include <deque>                      // baseline container
+#include <iomanip>                    // table formatting
+#include <iostream>                   // results
+#include <mutex>                      // baseline lock
+#include <thread>                     // worker threads
+#include <vector>                     // worker list
+
+/** MutexDeque
+ * @brief   Baseline: std::deque with every operation under one std::mutex
+*/
+class MutexDeque {
+public:
+   void pushFront(int newItem) {
+      std::lock_guard<std::mutex> guard(lock_);
+      items_.push_front(newItem);
+   }
+
+   void pushBack(int newItem) {
+      std::lock_guard<std::mutex> guard(lock_);
+      items_.push_back(newItem);
+   }
+
+   bool tryPopFront(int& item) {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (items_.empty()) {
+         return false;
+      }
+      item = items_.front();
+      items_.pop_front();
+      return true;
+   }
+
+   bool tryPopBack(int& item) {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (items_.empty()) {
+         return false;
+      }
+      item = items_.back();
+      items_.pop_back();
+      return true;
+   }
+
+private:
+   std::mutex lock_;        // guards items_
+   std::deque<int> items_;  // the entries
+};
+
+/** runMixedWorkload(Queue&, int, int, int)
+ * @brief   Runs the same push/pop mix on every thread and times it.
+ * @param   queue          The queue shared by all threads
+ * @param   numThreads     The number of threads to run
+ * @param   opsPerThread   The number of push/pop pairs each thread performs
+ * @param   prefill        The number of entries pushed at each end before timing
+ * @return  The average wall-clock nanoseconds per operation.
+*/
+template <typename Queue>
+double runMixedWorkload(Queue& queue, int numThreads, int opsPerThread, int prefill) {
+   for (int i = 0; i < prefill; ++i) {
+      queue.pushFront(i);
+      queue.pushBack(i);
+   }
+
+   std::vector<std::thread> workers;
+   auto start = std::chrono::steady_clock::now();
+   for (int t = 0; t < numThreads; ++t) {
+      workers.emplace_back([&queue, opsPerThread]() {
+         int item;
+         for (int i = 0; i < opsPerThread; ++i) {
+            // Alternate ends so both sides of the queue see traffic
+            if (i % 2 == 0) {
+               queue.pushBack(i);
+               queue.tryPopFront(item);
+            } else {
+               queue.pushFront(i);
+               queue.tryPopBack(item);
+            }
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join();
+   }
+   auto elapsed = std::chrono::steady_clock::now() - start;
+
+   double totalOps = 2.0 * numThreads * opsPerThread;
+   return std::chrono::duration<double, std::nano>(elapsed).count() / totalOps;
+}
+
+int main() {
+   const int totalPairs = 2000000;  // push/pop pairs split across the threads
+   const int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+   // A near-empty queue makes both ends meet on every pop; a pre-filled one
+   // keeps them apart, which is where per-end locking pays off
+   for (int prefill : {0, 1000}) {
+      std::cout << "prefill " << prefill << " entries at each end\n";
+      std::cout << std::setw(8) << "threads"
+                << std::setw(28) << "ConcurrentDEIntQueue ns/op"
+                << std::setw(28) << "mutex+std::deque ns/op" << '\n';
+      for (int numThreads : threadCounts) {
+         int opsPerThread = totalPairs / numThreads;
+
+         ConcurrentDEIntQueue concurrentQueue;
+         double concurrentNs = runMixedWorkload(concurrentQueue, numThreads, opsPerThread, prefill);
+
+         MutexDeque mutexDeque;
+         double baselineNs = runMixedWorkload(mutexDeque, numThreads, opsPerThread, prefill);
+
+         std::cout << std::setw(8) << numThreads
+                   << std::setw(28) << std::fixed << std::setprecision(1) << concurrentNs
+                   << std::setw(28) << baselineNs << '\n';
+      }
+   }
+   return 0;
+}
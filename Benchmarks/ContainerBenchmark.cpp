@@ -0,0 +1,486 @@
+/** 
+ * @file ContainerBenchmark.cpp
+ * @brief Measures DEIntQueue, std::deque, std::list, std::vector and prototype
+ *    pooled, unrolled and ring-buffer layouts on the digit access patterns
+ *    InfiniteInt uses: building with pushFront (add()), walking from last()
+ *    to the front, deep copies (copy()) and clear().
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "../DEIntQueue.h"  // container being measured
+#include <algorithm>        // std::max
+#include <chrono>           // timing
+#include <cstddef>          // std::max_align_t
+#include <cstdint>          // std::uintptr_t
+#include <cstdlib>          // std::malloc and std::free
+#include <cstring>          // std::memset
+#include <deque>            // baseline container
+#include <iomanip>          // table formatting
+#include <iostream>         // results
+#include <list>             // baseline container
+#include <new>              // std::bad_alloc
+#include <string>           // layout names
+#include <vector>           // baseline container
+
+#ifdef __linux__
+#include <linux/perf_event.h>  // hardware cache-miss counter
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ALLOCATION TRACKING
+// Every allocation records its size in a header so live bytes can be reported.
+
+static long long liveBytes = 0;   // bytes currently allocated through operator new
+
+void* operator new(std::size_t size) {
+   void* block = std::malloc(size + sizeof(std::max_align_t));
+   if (block == nullptr) {
+      throw std::bad_alloc();
+   }
+   *static_cast<std::size_t*>(block) = size;
+   liveBytes += static_cast<long long>(size);
+   return static_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* memory) noexcept {
+   if (memory != nullptr) {
+      void* block = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(memory) - sizeof(std::max_align_t));
+      liveBytes -= static_cast<long long>(*static_cast<std::size_t*>(block));
+      std::free(block);
+   }
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+   operator delete(memory);
+}
+
+// CACHE MISS COUNTER
+
+/** CacheMissCounter
+ * @brief   Counts hardware cache misses on Linux through perf_event_open.
+ *          Reports nothing when the counter is unavailable (other platforms,
+ *          containers or perf_event_paranoid restrictions).
+*/
+class CacheMissCounter {
+public:
+   CacheMissCounter() : fd_(-1) {
+#ifdef __linux__
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+   }
+
+   ~CacheMissCounter() {
+#ifdef __linux__
+      if (fd_ >= 0) {
+         close(fd_);
+      }
+#endif
+   }
+
+   bool available() const { return fd_ >= 0; }
+
+   void start() {
+#ifdef __linux__
+      if (fd_ >= 0) {
+         ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   long long stop() {
+      long long count{0};
+#ifdef __linux__
+      if (fd_ >= 0) {
+         ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+         if (read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+            count = 0;
+         }
+      }
+#endif
+      return count;
+   }
+
+private:
+   int fd_;   // perf event file descriptor, or -1 if unavailable
+};
+
+// LAYOUTS
+// Each layout stores a number's digits and supports the four measured patterns.
+// pushFront adds a more significant digit; reverseSum walks from the ones digit up.
+
+/** QueueLayout
+ * @brief   DEIntQueue as InfiniteInt uses it today
+*/
+struct QueueLayout {
+   static const char* name() { return "DEIntQueue"; }
+   DEIntQueue digits_;
+   void pushFront(int digit) { digits_.pushFront(digit); }
+   long long reverseSum() const {
+      long long sum{0};
+      for (auto cur = digits_.last(); cur != digits_.end(); --cur) {
+         sum += *cur;
+      }
+      return sum;
+   }
+   void clear() { digits_.clear(); }
+};
+
+/** DequeLayout
+ * @brief   std::deque, highest digit first
+*/
+struct DequeLayout {
+   static const char* name() { return "std::deque"; }
+   std::deque<int> digits_;
+   void pushFront(int digit) { digits_.push_front(digit); }
+   long long reverseSum() const {
+      long long sum{0};
+      for (auto cur = digits_.rbegin(); cur != digits_.rend(); ++cur) {
+         sum += *cur;
+      }
+      return sum;
+   }
+   void clear() { digits_.clear(); }
+};
+
+/** ListLayout
+ * @brief   std::list, highest digit first
+*/
+struct ListLayout {
+   static const char* name() { return "std::list"; }
+   std::list<int> digits_;
+   void pushFront(int digit) { digits_.push_front(digit); }
+   long long reverseSum() const {
+      long long sum{0};
+      for (auto cur = digits_.rbegin(); cur != digits_.rend(); ++cur) {
+         sum += *cur;
+      }
+      return sum;
+   }
+   void clear() { digits_.clear(); }
+};
+
+/** VectorLayout
+ * @brief   std::vector stored ones digit first, so pushFront is push_back and
+ *          the walk from the ones digit is a forward scan
+*/
+struct VectorLayout {
+   static const char* name() { return "std::vector (low first)"; }
+   std::vector<int> digits_;
+   void pushFront(int digit) { digits_.push_back(digit); }
+   long long reverseSum() const {
+      long long sum{0};
+      for (int digit : digits_) {
+         sum += digit;
+      }
+      return sum;
+   }
+   void clear() { digits_.clear(); digits_.shrink_to_fit(); }
+};
+
+/** PooledLayout
+ * @brief   Prototype: doubly linked list whose nodes come from 4 KiB slabs owned
+ *          by the list, so building and clearing avoid one allocation per digit
+*/
+struct PooledLayout {
+   static const char* name() { return "pooled list"; }
+
+   struct Node { int data_; Node* prev_; Node* next_; };
+   static const int NODES_PER_SLAB = 4096 / sizeof(Node);
+
+   std::vector<Node*> slabs_;   // every slab allocated so far
+   int usedInLastSlab_;         // nodes handed out from the last slab
+   Node* head_;
+   Node* tail_;
+
+   PooledLayout() : usedInLastSlab_(NODES_PER_SLAB), head_(nullptr), tail_(nullptr) { }
+   PooledLayout(const PooledLayout& toCopy) : PooledLayout() {
+      for (Node* cur = toCopy.tail_; cur != nullptr; cur = cur->prev_) {
+         pushFront(cur->data_);
+      }
+   }
+   ~PooledLayout() { clear(); }
+
+   void pushFront(int digit) {
+      if (usedInLastSlab_ == NODES_PER_SLAB) {
+         slabs_.push_back(new Node[NODES_PER_SLAB]);
+         usedInLastSlab_ = 0;
+      }
+      Node* newNode = &slabs_.back()[usedInLastSlab_++];
+      *newNode = Node{ digit, nullptr, head_ };
+      if (head_ == nullptr) {
+         tail_ = newNode;
+      } else {
+         head_->prev_ = newNode;
+      }
+      head_ = newNode;
+   }
+   long long reverseSum() const {
+      long long sum{0};
+      for (Node* cur = tail_; cur != nullptr; cur = cur->prev_) {
+         sum += cur->data_;
+      }
+      return sum;
+   }
+   void clear() {
+      for (Node* slab : slabs_) {
+         delete[] slab;
+      }
+      slabs_.clear();
+      usedInLastSlab_ = NODES_PER_SLAB;
+      head_ = tail_ = nullptr;
+   }
+};
+
+/** UnrolledLayout
+ * @brief   Prototype: doubly linked list of fixed-size digit blocks
+*/
+struct UnrolledLayout {
+   static const char* name() { return "unrolled list (32/block)"; }
+
+   static const int BLOCK_SIZE = 32;
+   struct Block { int digits_[BLOCK_SIZE]; int first_; Block* prev_; Block* next_; };
+
+   Block* head_;
+   Block* tail_;
+
+   UnrolledLayout() : head_(nullptr), tail_(nullptr) { }
+   UnrolledLayout(const UnrolledLayout& toCopy) : UnrolledLayout() {
+      for (Block* cur = toCopy.head_; cur != nullptr; cur = cur->next_) {
+         Block* copy = new Block(*cur);
+         copy->prev_ = tail_;
+         copy->next_ = nullptr;
+         if (tail_ == nullptr) {
+            head_ = copy;
+         } else {
+            tail_->next_ = copy;
+         }
+         tail_ = copy;
+      }
+   }
+   ~UnrolledLayout() { clear(); }
+
+   void pushFront(int digit) {
+      // Blocks fill from their end so the front block grows toward index 0
+      if (head_ == nullptr || head_->first_ == 0) {
+         Block* newBlock = new Block;
+         newBlock->first_ = BLOCK_SIZE;
+         newBlock->prev_ = nullptr;
+         newBlock->next_ = head_;
+         if (head_ == nullptr) {
+            tail_ = newBlock;
+         } else {
+            head_->prev_ = newBlock;
+         }
+         head_ = newBlock;
+      }
+      head_->digits_[--head_->first_] = digit;
+   }
+   long long reverseSum() const {
+      long long sum{0};
+      for (Block* cur = tail_; cur != nullptr; cur = cur->prev_) {
+         for (int i = BLOCK_SIZE - 1; i >= cur->first_; --i) {
+            sum += cur->digits_[i];
+         }
+      }
+      return sum;
+   }
+   void clear() {
+      while (head_ != nullptr) {
+         Block* next = head_->next_;
+         delete head_;
+         head_ = next;
+      }
+      tail_ = nullptr;
+   }
+};
+
+/** RingLayout
+ * @brief   Prototype: growable circular array with O(1) pushes at both ends
+*/
+struct RingLayout {
+   static const char* name() { return "ring buffer"; }
+
+   std::vector<int> slots_;   // capacity is always a power of two
+   std::size_t first_;        // slot of the highest digit
+   std::size_t count_;        // # of digits
+
+   RingLayout() : slots_(16), first_(0), count_(0) { }
+
+   void pushFront(int digit) {
+      if (count_ == slots_.size()) {
+         // Unroll into a buffer twice as large
+         std::vector<int> bigger(slots_.size() * 2);
+         for (std::size_t i = 0; i < count_; ++i) {
+            bigger[i] = slots_[(first_ + i) & (slots_.size() - 1)];
+         }
+         slots_.swap(bigger);
+         first_ = 0;
+      }
+      first_ = (first_ + slots_.size() - 1) & (slots_.size() - 1);
+      slots_[first_] = digit;
+      ++count_;
+   }
+   long long reverseSum() const {
+      long long sum{0};
+      std::size_t mask = slots_.size() - 1;
+      for (std::size_t i = count_; i > 0; --i) {
+         sum += slots_[(first_ + i - 1) & mask];
+      }
+      return sum;
+   }
+   void clear() {
+      std::vector<int>(16).swap(slots_);
+      first_ = count_ = 0;
+   }
+};
+
+// MEASUREMENT
+
+/** Measurement
+ * @brief   Result of running one access pattern
+*/
+struct Measurement {
+   double nsPerElement;   // wall-clock nanoseconds per digit
+   double missesPerElement;  // cache misses per digit, or -1 if unavailable
+};
+
+volatile long long sink;   // keeps results alive so the optimizer cannot drop work
+
+/** measure(Operation, int, int, CacheMissCounter&)
+ * @brief   Times an operation that touches numDigits digits per repetition.
+*/
+template <typename Operation>
+Measurement measure(Operation operation, int numDigits, int repetitions, CacheMissCounter& misses) {
+   misses.start();
+   auto start = std::chrono::steady_clock::now();
+   for (int rep = 0; rep < repetitions; ++rep) {
+      operation();
+   }
+   auto elapsed = std::chrono::steady_clock::now() - start;
+   long long missCount = misses.stop();
+
+   double elements = static_cast<double>(numDigits) * repetitions;
+   Measurement result;
+   result.nsPerElement = std::chrono::duration<double, std::nano>(elapsed).count() / elements;
+   result.missesPerElement = misses.available() ? missCount / elements : -1.0;
+   return result;
+}
+
+/** printRow(const std::string&, const Measurement&)
+ * @brief   Prints one row of the results table.
+*/
+void printRow(const std::string& pattern, const Measurement& result) {
+   std::cout << "   " << std::left << std::setw(16) << pattern << std::right
+             << std::setw(12) << std::fixed << std::setprecision(2) << result.nsPerElement;
+   if (result.missesPerElement >= 0) {
+      std::cout << std::setw(16) << std::setprecision(3) << result.missesPerElement;
+   } else {
+      std::cout << std::setw(16) << "n/a";
+   }
+   std::cout << '\n';
+}
+
+/** runLayout(int)
+ * @brief   Runs every access pattern on one layout at one number size.
+ * @param   numDigits   The number of digits in each number built
+*/
+template <typename Layout>
+void runLayout(int numDigits) {
+   const int totalDigits = 4000000;   // digits touched per pattern
+   int repetitions = std::max(1, totalDigits / numDigits);
+   CacheMissCounter misses;
+
+   // Bytes per element, measured from a single live number (requested bytes;
+   // allocator headers and rounding are not included)
+   long long bytesBefore = liveBytes;
+   {
+      Layout sample;
+      for (int i = 0; i < numDigits; ++i) {
+         sample.pushFront(i % 10);
+      }
+      double bytesPerDigit = static_cast<double>(liveBytes - bytesBefore + sizeof(Layout)) / numDigits;
+      std::cout << Layout::name() << "  (" << numDigits << " digits, "
+                << std::setprecision(1) << std::fixed << bytesPerDigit << " bytes/digit)\n";
+   }
+   std::cout << "   " << std::left << std::setw(16) << "pattern" << std::right
+             << std::setw(12) << "ns/digit" << std::setw(16) << "misses/digit" << '\n';
+
+   // pushFront-heavy building, as in InfiniteInt::add()
+   printRow("build pushFront", measure([numDigits]() {
+      Layout number;
+      for (int i = 0; i < numDigits; ++i) {
+         number.pushFront(i % 10);
+      }
+      sink = number.reverseSum() & 1;
+   }, numDigits, repetitions, misses));
+
+   Layout source;
+   for (int i = 0; i < numDigits; ++i) {
+      source.pushFront(i % 10);
+   }
+
+   // Reverse traversal from the ones digit, as every arithmetic loop does
+   printRow("walk from last", measure([&source]() {
+      sink = source.reverseSum();
+   }, numDigits, repetitions, misses));
+
+   // Deep copies, as InfiniteInt's copy constructor and operator= make
+   printRow("deep copy", measure([&source]() {
+      Layout copy(source);
+      sink = copy.reverseSum() & 1;
+   }, numDigits, repetitions, misses));
+
+   // clear(), timed on its own; the numbers are rebuilt between repetitions
+   std::chrono::steady_clock::duration clearTime{0};
+   long long clearMisses{0};
+   for (int rep = 0; rep < repetitions; ++rep) {
+      Layout number;
+      for (int i = 0; i < numDigits; ++i) {
+         number.pushFront(i % 10);
+      }
+      misses.start();
+      auto start = std::chrono::steady_clock::now();
+      number.clear();
+      clearTime += std::chrono::steady_clock::now() - start;
+      clearMisses += misses.stop();
+   }
+   double elements = static_cast<double>(numDigits) * repetitions;
+   Measurement clearOnly;
+   clearOnly.nsPerElement = std::chrono::duration<double, std::nano>(clearTime).count() / elements;
+   clearOnly.missesPerElement = misses.available() ? clearMisses / elements : -1.0;
+   printRow("clear", clearOnly);
+   std::cout << '\n';
+}
+
+int main() {
+   const int sizes[] = {1000, 100000, 1000000};
+
+   for (int numDigits : sizes) {
+      std::cout << "==== " << numDigits << " digits ====\n\n";
+      runLayout<QueueLayout>(numDigits);
+      runLayout<DequeLayout>(numDigits);
+      runLayout<ListLayout>(numDigits);
+      runLayout<VectorLayout>(numDigits);
+      runLayout<PooledLayout>(numDigits);
+      runLayout<UnrolledLayout>(numDigits);
+      runLayout<RingLayout>(numDigits);
+   }
+
+   CacheMissCounter probe;
+   if (!probe.available()) {
+      std::cout << "Cache-miss counter unavailable on this system (check perf_event_paranoid).\n";
+   }
+   return 0;
+}
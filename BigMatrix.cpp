@@ -0,0 +1,873 @@
+/** 
+ * @file BigMatrix.cpp
+ * @brief Implementation for BigMatrix, a dense matrix of InfiniteInts whose
+ *    products are computed modulo word-sized primes, tile by tile in parallel,
+ *    and rebuilt by Chinese remaindering
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "BigMatrix.h"
+#include "ParallelFor.h"  // Computing tiles and residue products in parallel
+#include <algorithm>      // std::max, std::min and std::swap
+#include <cmath>          // Estimating Hadamard bounds
+#include <iomanip>        // Zero-padding rebuilt words
+#include <sstream>        // Reading rebuilt entries into InfiniteInts
+#include <string>         // Decimal text of the entries
+#include <utility>        // std::move
+
+// PRIVATE HELPERS
+
+const long long PRIME_CEILING = 1000000000LL;       // multi-modular primes are the largest below this
+const int PRIME_DIGITS = 8;                         // each such prime exceeds 10^PRIME_DIGITS
+const int CACHED_PRIMES = 64;                       // primes kept between products, covering 511-digit bounds
+const unsigned long long WORD_BASE = 1000000000ULL; // base of the words entries are rebuilt in
+const int LAZY_TERMS = 15;                          // products summed before reducing; 15 (10^9)^2 + 10^9 < 2^64
+
+/** decimalWidth(int)
+ * @brief   Returns the number of decimal digits in a non-negative value.
+*/
+static int decimalWidth(int value) {
+   int width = 1;
+   while (value >= 10) {
+      value /= 10;
+      ++width;
+   }
+   return width;
+}
+
+/** findWordPrimes(int)
+ * @brief   Returns the count largest primes below PRIME_CEILING, found by trial division.
+*/
+static std::vector<long long> findWordPrimes(int count) {
+   std::vector<long long> primes;
+   for (long long candidate = PRIME_CEILING - 1; static_cast<int>(primes.size()) < count; candidate -= 2) {
+      bool isPrime = true;
+      for (long long factor = 3; factor * factor <= candidate; factor += 2) {
+         if (candidate % factor == 0) {
+            isPrime = false;
+            break;
+         }
+      }
+      if (isPrime) {
+         primes.push_back(candidate);
+      }
+   }
+   return primes;
+}
+
+/** wordPrimes(int)
+ * @brief   Returns the count largest primes below PRIME_CEILING. The first
+ *          CACHED_PRIMES are found once and shared by every product.
+*/
+static std::vector<long long> wordPrimes(int count) {
+   static const std::vector<long long> cached = findWordPrimes(CACHED_PRIMES);
+   if (count > CACHED_PRIMES) {
+      return findWordPrimes(count);
+   }
+   return std::vector<long long>(cached.begin(), cached.begin() + count);
+}
+
+/** powerMod(long long, long long, long long)
+ * @brief   Returns base^exponent mod modulus for word-sized operands.
+*/
+static long long powerMod(long long base, long long exponent, long long modulus) {
+   unsigned long long result = 1;
+   unsigned long long square = static_cast<unsigned long long>(base % modulus);
+   while (exponent > 0) {
+      if (exponent & 1) {
+         result = result * square % modulus;
+      }
+      square = square * square % modulus;
+      exponent >>= 1;
+   }
+   return static_cast<long long>(result);
+}
+
+/** residues(const InfiniteInt&, const std::vector<long long>&)
+ * @brief   Returns value mod each prime, between 0 and the prime - 1, read off
+ *          the value's decimal text nine digits at a time.
+*/
+static std::vector<unsigned long long> residues(const InfiniteInt& value, const std::vector<long long>& primes) {
+   std::string text = value.toString();
+   bool isNegative = text[0] == '-';
+   std::size_t start = isNegative ? 1 : 0;
+   std::vector<unsigned long long> result(primes.size(), 0);
+   while (start < text.size()) {
+      // Take the leading digits so that the rest splits into whole nine-digit chunks
+      std::size_t length = (text.size() - start) % 9 == 0 ? 9 : (text.size() - start) % 9;
+      unsigned long long chunk = 0;
+      unsigned long long scale = 1;
+      for (std::size_t i = start; i < start + length; ++i) {
+         chunk = chunk * 10 + static_cast<unsigned long long>(text[i] - '0');
+         scale *= 10;
+      }
+      for (std::size_t p = 0; p < primes.size(); ++p) {
+         result[p] = (result[p] * scale + chunk) % static_cast<unsigned long long>(primes[p]);
+      }
+      start += length;
+   }
+   if (isNegative) {
+      for (std::size_t p = 0; p < primes.size(); ++p) {
+         if (result[p] != 0) {
+            result[p] = static_cast<unsigned long long>(primes[p]) - result[p];
+         }
+      }
+   }
+   return result;
+}
+
+/** multiplyAddWords(std::vector<unsigned long long>&, unsigned long long, unsigned long long)
+ * @brief   Sets words = words * factor + addend, where words holds a number in
+ *          base WORD_BASE, lowest word first.
+ * @pre     factor and addend are less than WORD_BASE.
+*/
+static void multiplyAddWords(std::vector<unsigned long long>& words, unsigned long long factor,
+                             unsigned long long addend) {
+   unsigned long long carry = addend;
+   for (unsigned long long& word : words) {
+      unsigned long long total = word * factor + carry;
+      word = total % WORD_BASE;
+      carry = total / WORD_BASE;
+   }
+   while (carry > 0) {
+      words.push_back(carry % WORD_BASE);
+      carry /= WORD_BASE;
+   }
+}
+
+/** compareWords(const std::vector<unsigned long long>&, const std::vector<unsigned long long>&)
+ * @brief   Returns -1, 0 or 1 as lhs is less than, equal to or greater than rhs,
+ *          both in base WORD_BASE with no high zero words.
+*/
+static int compareWords(const std::vector<unsigned long long>& lhs, const std::vector<unsigned long long>& rhs) {
+   if (lhs.size() != rhs.size()) {
+      return lhs.size() < rhs.size() ? -1 : 1;
+   }
+   for (std::size_t i = lhs.size(); i-- > 0; ) {
+      if (lhs[i] != rhs[i]) {
+         return lhs[i] < rhs[i] ? -1 : 1;
+      }
+   }
+   return 0;
+}
+
+/** subtractWords(std::vector<unsigned long long>&, const std::vector<unsigned long long>&)
+ * @brief   Sets lhs = lhs - rhs, both in base WORD_BASE, dropping high zero words.
+ * @pre     lhs is at least rhs.
+*/
+static void subtractWords(std::vector<unsigned long long>& lhs, const std::vector<unsigned long long>& rhs) {
+   unsigned long long borrow = 0;
+   for (std::size_t i = 0; i < lhs.size(); ++i) {
+      unsigned long long subtrahend = (i < rhs.size() ? rhs[i] : 0) + borrow;
+      borrow = lhs[i] < subtrahend ? 1 : 0;
+      lhs[i] = lhs[i] + borrow * WORD_BASE - subtrahend;
+   }
+   while (lhs.size() > 1 && lhs.back() == 0) {
+      lhs.pop_back();
+   }
+}
+
+/** wordsToInfiniteInt(const std::vector<unsigned long long>&, bool)
+ * @brief   Returns the InfiniteInt whose magnitude is words, in base WORD_BASE,
+ *          negated if isNegative is true.
+*/
+static InfiniteInt wordsToInfiniteInt(const std::vector<unsigned long long>& words, bool isNegative) {
+   std::ostringstream text;
+   text << (isNegative ? "-" : "") << words.back();
+   for (std::size_t i = words.size() - 1; i-- > 0; ) {
+      text << std::setw(9) << std::setfill('0') << words[i];
+   }
+   std::istringstream stream(text.str());
+   InfiniteInt result;
+   stream >> result;
+   return result;
+}
+
+/** hadamardDigits(const std::vector<std::vector<InfiniteInt>>&)
+ * @brief   Returns an upper bound on log10 of the Hadamard bound of a matrix
+ *          (the product of its rows' Euclidean lengths), or a negative value if
+ *          some row is zero. Each entry's size is estimated from its leading
+ *          fifteen digits.
+*/
+static double hadamardDigits(const std::vector<std::vector<InfiniteInt>>& rows) {
+   double total = 0;
+   for (const std::vector<InfiniteInt>& row : rows) {
+      // log10 of each nonzero entry's magnitude, then log10 of the row's length
+      std::vector<double> logs;
+      double largest = 0;
+      for (const InfiniteInt& value : row) {
+         std::string text = value.toString();
+         std::size_t start = text[0] == '-' ? 1 : 0;
+         if (text[start] == '0') {
+            continue;
+         }
+         std::size_t leading = std::min<std::size_t>(15, text.size() - start);
+         double magnitude = std::log10(std::stod(text.substr(start, leading))) + (text.size() - start - leading);
+         logs.push_back(magnitude);
+         largest = std::max(largest, magnitude);
+      }
+      if (logs.empty()) {
+         return -1;
+      }
+      double sumOfSquares = 0;
+      for (double magnitude : logs) {
+         sumOfSquares += std::pow(10.0, 2 * (magnitude - largest));
+      }
+      total += largest + std::log10(sumOfSquares) / 2;
+   }
+   // Allow for rounding in the estimates
+   return total + 1e-6 * (rows.size() + 1);
+}
+
+/** primesForBound(double)
+ * @brief   Returns how many primes below PRIME_CEILING are needed for their
+ *          product to exceed twice 10^boundDigits.
+*/
+static int primesForBound(double boundDigits) {
+   return boundDigits < 0 ? 1 : static_cast<int>(std::ceil(boundDigits + 1)) / PRIME_DIGITS + 1;
+}
+
+/** solveModPrime(std::vector<unsigned long long>, std::size_t, std::size_t, unsigned long long, std::vector<unsigned long long>&)
+ * @brief   Gauss-Jordan elimination of an n-row augmented matrix mod prime.
+ *          The first n of its width columns are the square matrix, the rest
+ *          right-hand sides. When there are no right-hand sides only the rows
+ *          below each pivot are cleared.
+ * @return  The determinant of the square part mod prime. When it is nonzero,
+ *          scaled is set to determinant * solution mod prime, row by row.
+*/
+static unsigned long long solveModPrime(std::vector<unsigned long long> augmented, std::size_t n,
+                                        std::size_t width, unsigned long long prime,
+                                        std::vector<unsigned long long>& scaled) {
+   unsigned long long determinant = 1;
+   for (std::size_t c = 0; c < n; ++c) {
+      std::size_t pivotRow = c;
+      while (pivotRow < n && augmented[pivotRow * width + c] == 0) {
+         ++pivotRow;
+      }
+      if (pivotRow == n) {
+         return 0;
+      }
+      if (pivotRow != c) {
+         for (std::size_t j = c; j < width; ++j) {
+            std::swap(augmented[pivotRow * width + j], augmented[c * width + j]);
+         }
+         determinant = (prime - determinant) % prime;
+      }
+      unsigned long long* pivot = &augmented[c * width];
+      determinant = determinant * pivot[c] % prime;
+      unsigned long long inverse = static_cast<unsigned long long>(
+         powerMod(static_cast<long long>(pivot[c]), static_cast<long long>(prime) - 2, static_cast<long long>(prime)));
+      for (std::size_t j = c; j < width; ++j) {
+         pivot[j] = pivot[j] * inverse % prime;
+      }
+      for (std::size_t i = (width > n ? 0 : c + 1); i < n; ++i) {
+         unsigned long long* row = &augmented[i * width];
+         if (i == c || row[c] == 0) {
+            continue;
+         }
+         unsigned long long factor = row[c];
+         for (std::size_t j = c; j < width; ++j) {
+            row[j] = (row[j] + prime - factor * pivot[j] % prime) % prime;
+         }
+      }
+   }
+
+   scaled.clear();
+   for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = n; j < width; ++j) {
+         scaled.push_back(augmented[i * width + j] * determinant % prime);
+      }
+   }
+   return determinant;
+}
+
+/** BigMatrix(int, int)
+ * @brief   Constructor. Creates a matrix of zeroes.
+ * @param   rows     The number of rows
+ * @param   cols     The number of columns
+ * @pre     rows and cols are not negative.
+ * @throw   std::invalid_argument if rows or cols is negative.
+*/
+BigMatrix::BigMatrix(int rows, int cols) : rows_(rows), cols_(cols) {
+   if (rows < 0 || cols < 0) {
+      throw std::invalid_argument("BigMatrix dimensions must not be negative.");
+   }
+   entries_.assign(static_cast<std::size_t>(rows) * cols, InfiniteInt(0));
+}
+
+/** BigMatrix(const std::vector<std::vector<InfiniteInt>>&)
+ * @brief   Constructor.
+ * @param   entries  The rows of the matrix
+ * @pre     Every row has the same length.
+ * @throw   std::invalid_argument if the rows differ in length.
+*/
+BigMatrix::BigMatrix(const std::vector<std::vector<InfiniteInt>>& entries)
+   : rows_(static_cast<int>(entries.size())),
+     cols_(entries.empty() ? 0 : static_cast<int>(entries[0].size())) {
+   for (const std::vector<InfiniteInt>& row : entries) {
+      if (static_cast<int>(row.size()) != cols_) {
+         throw std::invalid_argument("BigMatrix rows must all have the same length.");
+      }
+      entries_.insert(entries_.end(), row.begin(), row.end());
+   }
+}
+
+/** identity(int)
+ * @brief   Returns the size-by-size identity matrix.
+ * @throw   std::invalid_argument if size is negative.
+*/
+BigMatrix BigMatrix::identity(int size) {
+   BigMatrix result(size, size);
+   for (int i = 0; i < size; ++i) {
+      result.at(i, i) = InfiniteInt(1);
+   }
+   return result;
+}
+
+/** rows()
+ * @brief   Returns the number of rows.
+*/
+int BigMatrix::rows() const {
+   return rows_;
+}
+
+/** cols()
+ * @brief   Returns the number of columns.
+*/
+int BigMatrix::cols() const {
+   return cols_;
+}
+
+/** at(int, int)
+ * @brief   Returns the entry in a given row and column.
+ * @throw   std::out_of_range if row or col is outside the matrix.
+*/
+InfiniteInt& BigMatrix::at(int row, int col) {
+   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+      throw std::out_of_range("BigMatrix::at() index out of range.");
+   }
+   return entries_[static_cast<std::size_t>(row) * cols_ + col];
+}
+
+/** at(int, int)
+ * @brief   Returns the entry in a given row and column.
+ * @throw   std::out_of_range if row or col is outside the matrix.
+*/
+const InfiniteInt& BigMatrix::at(int row, int col) const {
+   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+      throw std::out_of_range("BigMatrix::at() index out of range.");
+   }
+   return entries_[static_cast<std::size_t>(row) * cols_ + col];
+}
+
+/** operator+(const BigMatrix&)
+ * @brief   Returns the entrywise sum of this matrix and rhs.
+ * @throw   std::invalid_argument if the dimensions differ.
+*/
+BigMatrix BigMatrix::operator+(const BigMatrix& rhs) const {
+   checkSameShape(rhs);
+   BigMatrix sum(rows_, cols_);
+   for (std::size_t i = 0; i < entries_.size(); ++i) {
+      sum.entries_[i] = entries_[i] + rhs.entries_[i];
+   }
+   return sum;
+}
+
+/** operator-(const BigMatrix&)
+ * @brief   Returns the entrywise difference of this matrix and rhs.
+ * @throw   std::invalid_argument if the dimensions differ.
+*/
+BigMatrix BigMatrix::operator-(const BigMatrix& rhs) const {
+   checkSameShape(rhs);
+   BigMatrix difference(rows_, cols_);
+   for (std::size_t i = 0; i < entries_.size(); ++i) {
+      difference.entries_[i] = entries_[i] - rhs.entries_[i];
+   }
+   return difference;
+}
+
+/** multiply(const BigMatrix&, int)
+ * @brief   Returns the product of this matrix and rhs by multi-modular
+ *          arithmetic: the entries are reduced modulo enough word-sized primes
+ *          to cover twice the largest possible product entry, the product is
+ *          formed modulo each prime in machine words, and every entry is
+ *          rebuilt from its residues by Chinese remaindering. The modular
+ *          products are split into TILE_SIZE-square output tiles, one tile of
+ *          one prime per parallel task, and each tile walks the shared
+ *          dimension TILE_SIZE at a time with lazily reduced word accumulators.
+ * @param   rhs         The matrix to multiply this one by
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     cols() equals rhs.rows() and numThreads is not negative.
+ * @return  The product, with rows() rows and rhs.cols() columns.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+BigMatrix BigMatrix::multiply(const BigMatrix& rhs, int numThreads) const {
+   if (cols_ != rhs.rows_) {
+      throw std::invalid_argument("BigMatrix product needs cols() of the left to equal rows() of the right.");
+   }
+   if (numThreads < 0) {
+      throw std::invalid_argument("BigMatrix::multiply() called with a negative thread count.");
+   }
+   BigMatrix product(rows_, rhs.cols_);
+   if (product.entries_.empty() || cols_ == 0) {
+      return product;
+   }
+
+   int lhsDigits = 0;
+   for (const InfiniteInt& value : entries_) {
+      lhsDigits = std::max(lhsDigits, value.numDigits());
+   }
+   int rhsDigits = 0;
+   for (const InfiniteInt& value : rhs.entries_) {
+      rhsDigits = std::max(rhsDigits, value.numDigits());
+   }
+
+   // Every product entry is a sum of cols_ terms, each under 10^(lhsDigits + rhsDigits),
+   // and the primes' product must exceed twice that to recover signed entries
+   const int boundDigits = lhsDigits + rhsDigits + decimalWidth(cols_);
+   const std::vector<long long> primes = wordPrimes(boundDigits / PRIME_DIGITS + 1);
+   std::vector<std::vector<unsigned long long>> residues = multiplyModPrimes(rhs, primes, numThreads);
+   reconstruct(residues, primes, numThreads, product);
+   return product;
+}
+
+/** operator*(const BigMatrix&)
+ * @brief   Returns multiply(rhs) with one thread per hardware thread.
+ * @throw   std::invalid_argument if cols() differs from rhs.rows().
+*/
+BigMatrix BigMatrix::operator*(const BigMatrix& rhs) const {
+   return multiply(rhs);
+}
+
+/** operator==(const BigMatrix&)
+ * @brief   Returns true if both matrices have the same dimensions and entries.
+*/
+bool BigMatrix::operator==(const BigMatrix& rhs) const {
+   return rows_ == rhs.rows_ && cols_ == rhs.cols_ && entries_ == rhs.entries_;
+}
+
+/** operator!=(const BigMatrix&)
+ * @brief   Returns true if the matrices differ in dimensions or some entry.
+*/
+bool BigMatrix::operator!=(const BigMatrix& rhs) const {
+   return !(*this == rhs);
+}
+
+/** multiplyModPrimes(const BigMatrix&, const std::vector<long long>&, int)
+ * @brief   Returns this matrix times rhs modulo each prime, entry [p][e] being
+ *          product entry e mod primes[p]. One output tile of one prime is
+ *          computed per parallel task.
+*/
+std::vector<std::vector<unsigned long long>> BigMatrix::multiplyModPrimes(const BigMatrix& rhs,
+                                                                        const std::vector<long long>& primes,
+                                                                        int numThreads) const {
+   const std::size_t numPrimes = primes.size();
+
+   // lhsResidues[p][e] is entry e of this matrix mod primes[p]; each entry's text is read once
+   std::vector<std::vector<unsigned long long>> lhsResidues(numPrimes, std::vector<unsigned long long>(entries_.size()));
+   parallelFor(entries_.size(), numThreads, [&](std::size_t e) {
+      std::vector<unsigned long long> entryResidues = residues(entries_[e], primes);
+      for (std::size_t p = 0; p < numPrimes; ++p) {
+         lhsResidues[p][e] = entryResidues[p];
+      }
+   });
+   std::vector<std::vector<unsigned long long>> rhsResidues(numPrimes, std::vector<unsigned long long>(rhs.entries_.size()));
+   parallelFor(rhs.entries_.size(), numThreads, [&](std::size_t e) {
+      std::vector<unsigned long long> entryResidues = residues(rhs.entries_[e], primes);
+      for (std::size_t p = 0; p < numPrimes; ++p) {
+         rhsResidues[p][e] = entryResidues[p];
+      }
+   });
+
+   const std::size_t outCols = static_cast<std::size_t>(rhs.cols_);
+   const std::size_t tileRows = (rows_ + TILE_SIZE - 1) / TILE_SIZE;
+   const std::size_t tileCols = (outCols + TILE_SIZE - 1) / TILE_SIZE;
+   const std::size_t tilesPerPrime = tileRows * tileCols;
+   std::vector<std::vector<unsigned long long>> products(numPrimes,
+      std::vector<unsigned long long>(static_cast<std::size_t>(rows_) * outCols, 0));
+
+   parallelFor(numPrimes * tilesPerPrime, numThreads, [&](std::size_t task) {
+      const std::size_t p = task / tilesPerPrime;
+      const std::size_t tile = task % tilesPerPrime;
+      const unsigned long long prime = static_cast<unsigned long long>(primes[p]);
+      const std::vector<unsigned long long>& lhs = lhsResidues[p];
+      const std::vector<unsigned long long>& right = rhsResidues[p];
+      const std::size_t rowStart = tile / tileCols * TILE_SIZE;
+      const std::size_t colStart = tile % tileCols * TILE_SIZE;
+      const std::size_t rowEnd = std::min(rowStart + TILE_SIZE, static_cast<std::size_t>(rows_));
+      const std::size_t colEnd = std::min(colStart + TILE_SIZE, outCols);
+      const std::size_t depth = static_cast<std::size_t>(cols_);
+
+      // Walk the shared dimension one block at a time so the rhs rows in use stay hot.
+      // Products are summed into word accumulators, reduced every LAZY_TERMS terms.
+      for (std::size_t depthStart = 0; depthStart < depth; depthStart += TILE_SIZE) {
+         const std::size_t depthEnd = std::min(depthStart + TILE_SIZE, depth);
+         for (std::size_t i = rowStart; i < rowEnd; ++i) {
+            unsigned long long* sums = &products[p][i * outCols];
+            for (std::size_t k = depthStart; k < depthEnd; ++k) {
+               const unsigned long long factor = lhs[i * depth + k];
+               const unsigned long long* row = &right[k * outCols];
+               for (std::size_t j = colStart; j < colEnd; ++j) {
+                  sums[j] += factor * row[j];
+               }
+               if ((k + 1) % LAZY_TERMS == 0 || k + 1 == depth) {
+                  for (std::size_t j = colStart; j < colEnd; ++j) {
+                     sums[j] %= prime;
+                  }
+               }
+            }
+         }
+      }
+   });
+   return products;
+}
+
+/** reconstruct(const std::vector<std::vector<unsigned long long>>&, const std::vector<long long>&, int, BigMatrix&)
+ * @brief   Fills product with the entries whose residues modulo the primes are
+ *          given, choosing the representative of least absolute value (Garner's
+ *          algorithm, then rebuilding each entry in base 10^9 words).
+*/
+void BigMatrix::reconstruct(const std::vector<std::vector<unsigned long long>>& residues,
+                            const std::vector<long long>& primes, int numThreads, BigMatrix& product) {
+   const std::size_t numPrimes = primes.size();
+
+   // inverses[i][j] is primes[j]^-1 mod primes[i], for j < i
+   std::vector<std::vector<unsigned long long>> inverses(numPrimes);
+   for (std::size_t i = 0; i < numPrimes; ++i) {
+      for (std::size_t j = 0; j < i; ++j) {
+         inverses[i].push_back(static_cast<unsigned long long>(powerMod(primes[j], primes[i] - 2, primes[i])));
+      }
+   }
+   std::vector<unsigned long long> modulus(1, 1);
+   for (long long prime : primes) {
+      multiplyAddWords(modulus, static_cast<unsigned long long>(prime), 0);
+   }
+
+   parallelFor(product.entries_.size(), numThreads, [&](std::size_t e) {
+      // Mixed-radix digits: entry = digits[0] + digits[1] p0 + digits[2] p0 p1 + ...
+      std::vector<unsigned long long> digits(numPrimes);
+      for (std::size_t i = 0; i < numPrimes; ++i) {
+         const unsigned long long prime = static_cast<unsigned long long>(primes[i]);
+         unsigned long long digit = residues[i][e];
+         for (std::size_t j = 0; j < i; ++j) {
+            digit = (digit + prime - digits[j] % prime) % prime * inverses[i][j] % prime;
+         }
+         digits[i] = digit;
+      }
+
+      // Rebuild the entry in base 10^9 words, then move it to the symmetric range
+      std::vector<unsigned long long> value(1, digits[numPrimes - 1]);
+      for (std::size_t i = numPrimes - 1; i-- > 0; ) {
+         multiplyAddWords(value, static_cast<unsigned long long>(primes[i]), digits[i]);
+      }
+      std::vector<unsigned long long> doubled = value;
+      multiplyAddWords(doubled, 2, 0);
+      bool isNegative = compareWords(doubled, modulus) > 0;
+      if (isNegative) {
+         std::vector<unsigned long long> magnitude = modulus;
+         subtractWords(magnitude, value);
+         value.swap(magnitude);
+      }
+      product.entries_[e] = wordsToInfiniteInt(value, isNegative);
+   });
+}
+
+/** determinant()
+ * @brief   Returns the determinant by Bareiss fraction-free elimination:
+ *          every entry stays an integer minor of the matrix, so each
+ *          elimination step ends with an exact division (divExact) by the
+ *          previous pivot rather than introducing fractions.
+ * @pre     The matrix is square.
+ * @return  InfiniteInt representing the determinant (1 for a 0-by-0 matrix).
+ * @throw   std::invalid_argument if the matrix is not square.
+*/
+InfiniteInt BigMatrix::determinant() const {
+   checkSquare();
+   if (rows_ == 0) {
+      return InfiniteInt(1);
+   }
+   std::vector<std::vector<InfiniteInt>> rows = rowsOf(nullptr);
+   bool oddSwaps = false;
+   if (eliminate(rows, cols_, oddSwaps) < rows_) {
+      return InfiniteInt(0);
+   }
+   const InfiniteInt& lastPivot = rows[rows_ - 1][cols_ - 1];
+   return oddSwaps ? InfiniteInt(0) - lastPivot : lastPivot;
+}
+
+/** rank()
+ * @brief   Returns the rank, the number of pivots Bareiss elimination finds.
+*/
+int BigMatrix::rank() const {
+   std::vector<std::vector<InfiniteInt>> rows = rowsOf(nullptr);
+   bool oddSwaps = false;
+   return eliminate(rows, cols_, oddSwaps);
+}
+
+/** solve(const BigMatrix&, BigMatrix&, InfiniteInt&)
+ * @brief   Solves this * x = rhs exactly by Bareiss elimination of the
+ *          augmented matrix and fraction-free back substitution. The solution
+ *          is returned as x = numerators / denominator with denominator the
+ *          determinant, so by Cramer's rule every numerator is an integer.
+ * @param   rhs            The right-hand sides, one per column
+ * @param   numerators     Set to determinant() * x
+ * @param   denominator    Set to determinant()
+ * @pre     The matrix is square and nonsingular, and rhs has as many rows.
+ * @post    this * numerators = denominator * rhs.
+ * @throw   std::invalid_argument if the matrix is not square or rhs has the
+ *          wrong number of rows.
+ * @throw   std::domain_error if the matrix is singular.
+*/
+void BigMatrix::solve(const BigMatrix& rhs, BigMatrix& numerators, InfiniteInt& denominator) const {
+   checkSquare();
+   if (rhs.rows_ != rows_) {
+      throw std::invalid_argument("BigMatrix::solve() needs as many right-hand side rows as matrix rows.");
+   }
+   const int n = rows_;
+   std::vector<std::vector<InfiniteInt>> rows = rowsOf(&rhs);
+   bool oddSwaps = false;
+   if (eliminate(rows, n, oddSwaps) < n) {
+      throw std::domain_error("BigMatrix::solve() called on a singular matrix.");
+   }
+
+   // The last pivot is the determinant of the row-swapped matrix, and
+   // scaled = lastPivot * x is integral, so each back substitution divides exactly
+   const InfiniteInt lastPivot = n > 0 ? rows[n - 1][n - 1] : InfiniteInt(1);
+   BigMatrix scaled(n, rhs.cols_);
+   for (int j = 0; j < rhs.cols_; ++j) {
+      for (int i = n - 1; i >= 0; --i) {
+         InfiniteInt sum = lastPivot * rows[i][n + j];
+         for (int k = i + 1; k < n; ++k) {
+            sum = sum - rows[i][k] * scaled.at(k, j);
+         }
+         scaled.at(i, j) = sum.divExact(rows[i][i]);
+      }
+   }
+
+   if (oddSwaps) {
+      denominator = InfiniteInt(0) - lastPivot;
+      numerators = BigMatrix(n, rhs.cols_) - scaled;
+   } else {
+      denominator = lastPivot;
+      numerators = scaled;
+   }
+}
+
+/** determinantMultimodular(int)
+ * @brief   Returns the determinant by elimination modulo word-sized primes,
+ *          one prime per parallel task, and Chinese remaindering. Primes are
+ *          added only until their product exceeds twice the Hadamard bound
+ *          (the product of the rows' Euclidean lengths), which no
+ *          determinant can exceed.
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     The matrix is square and numThreads is not negative.
+ * @return  InfiniteInt representing the determinant, equal to determinant().
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt BigMatrix::determinantMultimodular(int numThreads) const {
+   checkSquare();
+   if (numThreads < 0) {
+      throw std::invalid_argument("BigMatrix::determinantMultimodular() called with a negative thread count.");
+   }
+   if (rows_ == 0) {
+      return InfiniteInt(1);
+   }
+   double boundDigits = hadamardDigits(rowsOf(nullptr));
+   if (boundDigits < 0) {
+      return InfiniteInt(0);
+   }
+
+   const std::vector<long long> primes = wordPrimes(primesForBound(boundDigits));
+   std::vector<std::vector<unsigned long long>> entryResidues(entries_.size());
+   parallelFor(entries_.size(), numThreads, [&](std::size_t e) {
+      entryResidues[e] = residues(entries_[e], primes);
+   });
+   std::vector<std::vector<unsigned long long>> determinants(primes.size(), std::vector<unsigned long long>(1));
+   parallelFor(primes.size(), numThreads, [&](std::size_t p) {
+      std::vector<unsigned long long> reduced(entries_.size());
+      for (std::size_t e = 0; e < entries_.size(); ++e) {
+         reduced[e] = entryResidues[e][p];
+      }
+      std::vector<unsigned long long> unused;
+      determinants[p][0] = solveModPrime(reduced, rows_, cols_, static_cast<unsigned long long>(primes[p]), unused);
+   });
+
+   BigMatrix result(1, 1);
+   reconstruct(determinants, primes, numThreads, result);
+   return result.entries_[0];
+}
+
+/** solveMultimodular(const BigMatrix&, BigMatrix&, InfiniteInt&, int)
+ * @brief   Solves this * x = rhs modulo word-sized primes, one prime per
+ *          parallel task, and Chinese remainders the determinant and the
+ *          numerators. Primes that divide the determinant are skipped, and
+ *          primes are added only until their product exceeds twice the
+ *          Hadamard bound of the augmented matrix [this | rhs], which bounds
+ *          the determinant and every numerator. The matrix is singular once
+ *          every prime tried divides the determinant and their product
+ *          exceeds twice the Hadamard bound of this matrix; no separate
+ *          determinant pass is made.
+ * @param   rhs            The right-hand sides, one per column
+ * @param   numerators     Set to determinant() * x
+ * @param   denominator    Set to determinant()
+ * @param   numThreads     The number of worker threads, or 0 to use one per hardware thread
+ * @pre     The matrix is square and nonsingular, rhs has as many rows and
+ *          numThreads is not negative.
+ * @post    The results equal those of solve().
+ * @throw   std::invalid_argument if the matrix is not square, rhs has the
+ *          wrong number of rows or numThreads is negative.
+ * @throw   std::domain_error if the matrix is singular.
+*/
+void BigMatrix::solveMultimodular(const BigMatrix& rhs, BigMatrix& numerators, InfiniteInt& denominator,
+                                  int numThreads) const {
+   checkSquare();
+   if (rhs.rows_ != rows_) {
+      throw std::invalid_argument("BigMatrix::solveMultimodular() needs as many right-hand side rows as matrix rows.");
+   }
+   if (numThreads < 0) {
+      throw std::invalid_argument("BigMatrix::solveMultimodular() called with a negative thread count.");
+   }
+   const std::size_t n = static_cast<std::size_t>(rows_);
+   const std::size_t width = n + static_cast<std::size_t>(rhs.cols_);
+
+   // The determinant is zero exactly when it is zero modulo primes whose
+   // product exceeds twice the Hadamard bound of this matrix alone
+   const double boundDigits = hadamardDigits(rowsOf(nullptr));
+   if (boundDigits < 0) {
+      throw std::domain_error("BigMatrix::solveMultimodular() called on a singular matrix.");
+   }
+   const std::size_t singularAfter = static_cast<std::size_t>(primesForBound(boundDigits));
+
+   const std::vector<std::vector<InfiniteInt>> augmented = rowsOf(&rhs);
+   const int needed = primesForBound(hadamardDigits(augmented));
+   std::vector<long long> candidates = wordPrimes(needed);
+   std::vector<std::vector<unsigned long long>> entryResidues(n * width);
+   parallelFor(n * width, numThreads, [&](std::size_t e) {
+      entryResidues[e] = residues(augmented[e / width][e % width], candidates);
+   });
+
+   // Each prime yields the determinant followed by the scaled solution, row by row.
+   // A prime dividing the determinant is useless, so more are drawn until enough work.
+   std::vector<long long> lucky;
+   std::vector<std::vector<unsigned long long>> results;
+   std::size_t tried = 0;
+   while (static_cast<int>(lucky.size()) < needed) {
+      if (tried == candidates.size()) {
+         candidates = wordPrimes(static_cast<int>(candidates.size()) + needed);
+         parallelFor(n * width, numThreads, [&](std::size_t e) {
+            entryResidues[e] = residues(augmented[e / width][e % width], candidates);
+         });
+      }
+      const std::size_t batchEnd = std::min(candidates.size(), tried + (needed - lucky.size()));
+      std::vector<std::vector<unsigned long long>> batch(batchEnd - tried);
+      parallelFor(batch.size(), numThreads, [&](std::size_t b) {
+         std::size_t p = tried + b;
+         std::vector<unsigned long long> reduced(n * width);
+         for (std::size_t e = 0; e < reduced.size(); ++e) {
+            reduced[e] = entryResidues[e][p];
+         }
+         std::vector<unsigned long long> scaled;
+         unsigned long long determinant = solveModPrime(reduced, n, width,
+                                                        static_cast<unsigned long long>(candidates[p]), scaled);
+         if (determinant != 0) {
+            batch[b].push_back(determinant);
+            batch[b].insert(batch[b].end(), scaled.begin(), scaled.end());
+         }
+      });
+      for (std::size_t b = 0; b < batch.size(); ++b) {
+         if (!batch[b].empty()) {
+            lucky.push_back(candidates[tried + b]);
+            results.push_back(std::move(batch[b]));
+         }
+      }
+      tried = batchEnd;
+      if (lucky.empty() && tried >= singularAfter) {
+         throw std::domain_error("BigMatrix::solveMultimodular() called on a singular matrix.");
+      }
+   }
+
+   BigMatrix combined(1, static_cast<int>(1 + n * rhs.cols_));
+   reconstruct(results, lucky, numThreads, combined);
+   denominator = combined.entries_[0];
+   numerators = BigMatrix(rows_, rhs.cols_);
+   for (std::size_t e = 0; e < n * rhs.cols_; ++e) {
+      numerators.entries_[e] = combined.entries_[e + 1];
+   }
+}
+
+/** eliminate(std::vector<std::vector<InfiniteInt>>&, int, bool&)
+ * @brief   Runs Bareiss elimination on rows, choosing pivots from the first
+ *          pivotCols columns and skipping columns with no nonzero candidate.
+ * @param   rows        The matrix being reduced, changed in place to echelon form
+ * @param   pivotCols   The number of leading columns pivots are taken from
+ * @param   oddSwaps    Set to true if an odd number of row swaps were made
+ * @return  The number of pivots found.
+*/
+int BigMatrix::eliminate(std::vector<std::vector<InfiniteInt>>& rows, int pivotCols, bool& oddSwaps) {
+   const InfiniteInt zero(0);
+   const std::size_t numRows = rows.size();
+   InfiniteInt previousPivot(1);
+   std::size_t rank = 0;
+   oddSwaps = false;
+   for (int c = 0; c < pivotCols && rank < numRows; ++c) {
+      std::size_t pivotRow = rank;
+      while (pivotRow < numRows && rows[pivotRow][c] == zero) {
+         ++pivotRow;
+      }
+      if (pivotRow == numRows) {
+         continue;
+      }
+      if (pivotRow != rank) {
+         rows[pivotRow].swap(rows[rank]);
+         oddSwaps = !oddSwaps;
+      }
+
+      // rows[i][j] = (pivot rows[i][j] - rows[i][c] rows[rank][j]) / previousPivot, exactly
+      const std::vector<InfiniteInt>& pivot = rows[rank];
+      for (std::size_t i = rank + 1; i < numRows; ++i) {
+         std::vector<InfiniteInt>& row = rows[i];
+         for (std::size_t j = c + 1; j < row.size(); ++j) {
+            row[j] = (pivot[c] * row[j] - row[c] * pivot[j]).divExact(previousPivot);
+         }
+         row[c] = zero;
+      }
+      previousPivot = pivot[c];
+      ++rank;
+   }
+   return static_cast<int>(rank);
+}
+
+/** rowsOf(const BigMatrix*)
+ * @brief   Returns this matrix's rows, each followed by the matching row of
+ *          extra if it is not null.
+*/
+std::vector<std::vector<InfiniteInt>> BigMatrix::rowsOf(const BigMatrix* extra) const {
+   std::vector<std::vector<InfiniteInt>> rows(rows_);
+   for (int i = 0; i < rows_; ++i) {
+      rows[i].assign(entries_.begin() + static_cast<std::size_t>(i) * cols_,
+                     entries_.begin() + static_cast<std::size_t>(i + 1) * cols_);
+      if (extra != nullptr) {
+         rows[i].insert(rows[i].end(), extra->entries_.begin() + static_cast<std::size_t>(i) * extra->cols_,
+                        extra->entries_.begin() + static_cast<std::size_t>(i + 1) * extra->cols_);
+      }
+   }
+   return rows;
+}
+
+/** checkSquare()
+ * @brief   Throws std::invalid_argument if the matrix is not square.
+*/
+void BigMatrix::checkSquare() const {
+   if (rows_ != cols_) {
+      throw std::invalid_argument("BigMatrix operation needs a square matrix.");
+   }
+}
+
+/** checkSameShape(const BigMatrix&)
+ * @brief   Throws std::invalid_argument if rhs has different dimensions.
+*/
+void BigMatrix::checkSameShape(const BigMatrix& rhs) const {
+   if (rows_ != rhs.rows_ || cols_ != rhs.cols_) {
+      throw std::invalid_argument("BigMatrix dimensions differ.");
+   }
+}
@@ -0,0 +1,232 @@
+/** 
+ * @file BigMatrix.h
+ * @brief Class definition for BigMatrix, a dense matrix of InfiniteInts whose
+ *    products are computed modulo word-sized primes, tile by tile in parallel,
+ *    and rebuilt by Chinese remaindering
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef BIGMATRIX_H
+#define BIGMATRIX_H
+
+#include "InfiniteInt.h" // Type of the entries
+#include <stdexcept>     // std::invalid_argument and std::out_of_range
+#include <vector>        // Entry storage
+
+class BigMatrix {
+public:
+   static const int TILE_SIZE = 16;   // rows and columns per output tile and depth per pass
+
+   //PUBLIC METHODS
+   /** BigMatrix(int, int)
+    * @brief   Constructor. Creates a matrix of zeroes.
+    * @param   rows     The number of rows
+    * @param   cols     The number of columns
+    * @pre     rows and cols are not negative.
+    * @throw   std::invalid_argument if rows or cols is negative.
+   */
+   BigMatrix(int rows, int cols);
+
+   /** BigMatrix(const std::vector<std::vector<InfiniteInt>>&)
+    * @brief   Constructor.
+    * @param   entries  The rows of the matrix
+    * @pre     Every row has the same length.
+    * @throw   std::invalid_argument if the rows differ in length.
+   */
+   explicit BigMatrix(const std::vector<std::vector<InfiniteInt>>& entries);
+
+   /** identity(int)
+    * @brief   Returns the size-by-size identity matrix.
+    * @throw   std::invalid_argument if size is negative.
+   */
+   static BigMatrix identity(int size);
+
+   /** rows()
+    * @brief   Returns the number of rows.
+   */
+   int rows() const;
+
+   /** cols()
+    * @brief   Returns the number of columns.
+   */
+   int cols() const;
+
+   /** at(int, int)
+    * @brief   Returns the entry in a given row and column.
+    * @throw   std::out_of_range if row or col is outside the matrix.
+   */
+   InfiniteInt& at(int row, int col);
+
+   /** at(int, int)
+    * @brief   Returns the entry in a given row and column.
+    * @throw   std::out_of_range if row or col is outside the matrix.
+   */
+   const InfiniteInt& at(int row, int col) const;
+
+   /** operator+(const BigMatrix&)
+    * @brief   Returns the entrywise sum of this matrix and rhs.
+    * @throw   std::invalid_argument if the dimensions differ.
+   */
+   BigMatrix operator+(const BigMatrix& rhs) const;
+
+   /** operator-(const BigMatrix&)
+    * @brief   Returns the entrywise difference of this matrix and rhs.
+    * @throw   std::invalid_argument if the dimensions differ.
+   */
+   BigMatrix operator-(const BigMatrix& rhs) const;
+
+   /** multiply(const BigMatrix&, int)
+    * @brief   Returns the product of this matrix and rhs by multi-modular
+    *          arithmetic: the entries are reduced modulo enough word-sized primes
+    *          to cover twice the largest possible product entry, the product is
+    *          formed modulo each prime in machine words, and every entry is
+    *          rebuilt from its residues by Chinese remaindering. The modular
+    *          products are split into TILE_SIZE-square output tiles, one tile of
+    *          one prime per parallel task, and each tile walks the shared
+    *          dimension TILE_SIZE at a time with lazily reduced word accumulators.
+    * @param   rhs         The matrix to multiply this one by
+    * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+    * @pre     cols() equals rhs.rows() and numThreads is not negative.
+    * @return  The product, with rows() rows and rhs.cols() columns.
+    * @throw   std::invalid_argument if the preconditions are not met.
+   */
+   BigMatrix multiply(const BigMatrix& rhs, int numThreads = 0) const;
+
+   /** operator*(const BigMatrix&)
+    * @brief   Returns multiply(rhs) with one thread per hardware thread.
+    * @throw   std::invalid_argument if cols() differs from rhs.rows().
+   */
+   BigMatrix operator*(const BigMatrix& rhs) const;
+
+   /** operator==(const BigMatrix&)
+    * @brief   Returns true if both matrices have the same dimensions and entries.
+   */
+   bool operator==(const BigMatrix& rhs) const;
+
+   /** operator!=(const BigMatrix&)
+    * @brief   Returns true if the matrices differ in dimensions or some entry.
+   */
+   bool operator!=(const BigMatrix& rhs) const;
+
+   /** determinant()
+    * @brief   Returns the determinant by Bareiss fraction-free elimination:
+    *          every entry stays an integer minor of the matrix, so each
+    *          elimination step ends with an exact division (divExact) by the
+    *          previous pivot rather than introducing fractions.
+    * @pre     The matrix is square.
+    * @return  InfiniteInt representing the determinant (1 for a 0-by-0 matrix).
+    * @throw   std::invalid_argument if the matrix is not square.
+   */
+   InfiniteInt determinant() const;
+
+   /** rank()
+    * @brief   Returns the rank, the number of pivots Bareiss elimination finds.
+   */
+   int rank() const;
+
+   /** solve(const BigMatrix&, BigMatrix&, InfiniteInt&)
+    * @brief   Solves this * x = rhs exactly by Bareiss elimination of the
+    *          augmented matrix and fraction-free back substitution. The solution
+    *          is returned as x = numerators / denominator with denominator the
+    *          determinant, so by Cramer's rule every numerator is an integer.
+    * @param   rhs            The right-hand sides, one per column
+    * @param   numerators     Set to determinant() * x
+    * @param   denominator    Set to determinant()
+    * @pre     The matrix is square and nonsingular, and rhs has as many rows.
+    * @post    this * numerators = denominator * rhs.
+    * @throw   std::invalid_argument if the matrix is not square or rhs has the
+    *          wrong number of rows.
+    * @throw   std::domain_error if the matrix is singular.
+   */
+   void solve(const BigMatrix& rhs, BigMatrix& numerators, InfiniteInt& denominator) const;
+
+   /** determinantMultimodular(int)
+    * @brief   Returns the determinant by elimination modulo word-sized primes,
+    *          one prime per parallel task, and Chinese remaindering. Primes are
+    *          added only until their product exceeds twice the Hadamard bound
+    *          (the product of the rows' Euclidean lengths), which no
+    *          determinant can exceed.
+    * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+    * @pre     The matrix is square and numThreads is not negative.
+    * @return  InfiniteInt representing the determinant, equal to determinant().
+    * @throw   std::invalid_argument if the preconditions are not met.
+   */
+   InfiniteInt determinantMultimodular(int numThreads = 0) const;
+
+   /** solveMultimodular(const BigMatrix&, BigMatrix&, InfiniteInt&, int)
+    * @brief   Solves this * x = rhs modulo word-sized primes, one prime per
+    *          parallel task, and Chinese remainders the determinant and the
+    *          numerators. Primes that divide the determinant are skipped, and
+    *          primes are added only until their product exceeds twice the
+    *          Hadamard bound of the augmented matrix [this | rhs], which bounds
+    *          the determinant and every numerator. The matrix is singular once
+    *          every prime tried divides the determinant and their product
+    *          exceeds twice the Hadamard bound of this matrix; no separate
+    *          determinant pass is made.
+    * @param   rhs            The right-hand sides, one per column
+    * @param   numerators     Set to determinant() * x
+    * @param   denominator    Set to determinant()
+    * @param   numThreads     The number of worker threads, or 0 to use one per hardware thread
+    * @pre     The matrix is square and nonsingular, rhs has as many rows and
+    *          numThreads is not negative.
+    * @post    The results equal those of solve().
+    * @throw   std::invalid_argument if the matrix is not square, rhs has the
+    *          wrong number of rows or numThreads is negative.
+    * @throw   std::domain_error if the matrix is singular.
+   */
+   void solveMultimodular(const BigMatrix& rhs, BigMatrix& numerators, InfiniteInt& denominator,
+                          int numThreads = 0) const;
+
+private:
+   // PRIVATE FUNCTIONS
+   /** multiplyModPrimes(const BigMatrix&, const std::vector<long long>&, int)
+    * @brief   Returns this matrix times rhs modulo each prime, entry [p][e] being
+    *          product entry e mod primes[p]. One output tile of one prime is
+    *          computed per parallel task.
+   */
+   std::vector<std::vector<unsigned long long>> multiplyModPrimes(const BigMatrix& rhs,
+                                                                  const std::vector<long long>& primes,
+                                                                  int numThreads) const;
+
+   /** reconstruct(const std::vector<std::vector<unsigned long long>>&, const std::vector<long long>&, int, BigMatrix&)
+    * @brief   Fills product with the entries whose residues modulo the primes are
+    *          given, choosing the representative of least absolute value (Garner's
+    *          algorithm, then rebuilding each entry in base 10^9 words).
+   */
+   static void reconstruct(const std::vector<std::vector<unsigned long long>>& residues,
+                           const std::vector<long long>& primes, int numThreads, BigMatrix& product);
+
+   /** eliminate(std::vector<std::vector<InfiniteInt>>&, int, bool&)
+    * @brief   Runs Bareiss elimination on rows, choosing pivots from the first
+    *          pivotCols columns and skipping columns with no nonzero candidate.
+    * @param   rows        The matrix being reduced, changed in place to echelon form
+    * @param   pivotCols   The number of leading columns pivots are taken from
+    * @param   oddSwaps    Set to true if an odd number of row swaps were made
+    * @return  The number of pivots found.
+   */
+   static int eliminate(std::vector<std::vector<InfiniteInt>>& rows, int pivotCols, bool& oddSwaps);
+
+   /** rowsOf(const BigMatrix*)
+    * @brief   Returns this matrix's rows, each followed by the matching row of
+    *          extra if it is not null.
+   */
+   std::vector<std::vector<InfiniteInt>> rowsOf(const BigMatrix* extra) const;
+
+   /** checkSquare()
+    * @brief   Throws std::invalid_argument if the matrix is not square.
+   */
+   void checkSquare() const;
+
+   /** checkSameShape(const BigMatrix&)
+    * @brief   Throws std::invalid_argument if rhs has different dimensions.
+   */
+   void checkSameShape(const BigMatrix& rhs) const;
+
+   // DATA MEMBERS
+   int rows_;                         // number of rows
+   int cols_;                         // number of columns
+   std::vector<InfiniteInt> entries_; // entries, row by row
+};
+
+#endif // BIGMATRIX_H
@@ -0,0 +1,359 @@
+/** 
+ * @file BigPoly.cpp
+ * @brief Implementation for BigPoly, a polynomial with InfiniteInt
+ *    coefficients, multiplied by Karatsuba's method and evaluated at many
+ *    points with a subproduct tree
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "BigPoly.h"
+#include "Divisor.h"      // Dividing by the divisor's leading coefficient
+#include "ParallelFor.h"  // Building and reducing the nodes of a level in parallel
+#include <algorithm>      // std::max and std::min
+#include <utility>        // std::move
+
+// PRIVATE HELPERS
+
+const std::size_t KARATSUBA_THRESHOLD = 2;  // operands with fewer coefficients than this are multiplied term by term
+
+/** addShifted(std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, std::size_t, bool)
+ * @brief   Adds (or subtracts) the terms of a coefficient list into target,
+ *          starting at coefficient offset.
+ * @pre     target has at least offset + terms.size() coefficients.
+*/
+static void addShifted(std::vector<InfiniteInt>& target, const std::vector<InfiniteInt>& terms,
+                       std::size_t offset, bool subtract) {
+   for (std::size_t i = 0; i < terms.size(); ++i) {
+      target[offset + i] = subtract ? target[offset + i] - terms[i] : target[offset + i] + terms[i];
+   }
+}
+
+/** sumOfHalves(const std::vector<InfiniteInt>&, std::size_t)
+ * @brief   Returns the coefficient list low + high, where low is the first half
+ *          coefficients of terms and high the rest.
+ * @pre     terms.size() - half <= half.
+*/
+static std::vector<InfiniteInt> sumOfHalves(const std::vector<InfiniteInt>& terms, std::size_t half) {
+   std::vector<InfiniteInt> sum(terms.begin(), terms.begin() + half);
+   for (std::size_t i = half; i < terms.size(); ++i) {
+      sum[i - half] = sum[i - half] + terms[i];
+   }
+   return sum;
+}
+
+/** karatsubaProduct(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&)
+ * @brief   Multiplies two coefficient lists, constant term first, by
+ *          Karatsuba's method, multiplying term by term below
+ *          KARATSUBA_THRESHOLD coefficients. An operand no longer than half
+ *          the other is multiplied against equal-length pieces of the longer one.
+ * @pre     Neither list is empty.
+ * @return  The lhs.size() + rhs.size() - 1 coefficients of the product.
+*/
+static std::vector<InfiniteInt> karatsubaProduct(const std::vector<InfiniteInt>& lhs,
+                                                 const std::vector<InfiniteInt>& rhs) {
+   std::vector<InfiniteInt> product(lhs.size() + rhs.size() - 1, InfiniteInt(0));
+   const std::vector<InfiniteInt>& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+   const std::vector<InfiniteInt>& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+   if (shorter.size() < KARATSUBA_THRESHOLD) {
+      for (std::size_t i = 0; i < lhs.size(); ++i) {
+         for (std::size_t j = 0; j < rhs.size(); ++j) {
+            product[i + j] = product[i + j] + lhs[i] * rhs[j];
+         }
+      }
+      return product;
+   }
+   std::size_t half = (longer.size() + 1) / 2;
+
+   // Unbalanced operands: multiply the shorter one by each piece of the longer
+   if (shorter.size() <= half) {
+      for (std::size_t offset = 0; offset < longer.size(); offset += shorter.size()) {
+         std::size_t end = std::min(offset + shorter.size(), longer.size());
+         std::vector<InfiniteInt> piece(longer.begin() + offset, longer.begin() + end);
+         addShifted(product, karatsubaProduct(piece, shorter), offset, false);
+      }
+      return product;
+   }
+
+   // (l0 + l1 x^h)(r0 + r1 x^h) = low + (middle - low - high) x^h + high x^2h
+   std::vector<InfiniteInt> lhsLow(lhs.begin(), lhs.begin() + half);
+   std::vector<InfiniteInt> lhsHigh(lhs.begin() + half, lhs.end());
+   std::vector<InfiniteInt> rhsLow(rhs.begin(), rhs.begin() + half);
+   std::vector<InfiniteInt> rhsHigh(rhs.begin() + half, rhs.end());
+   std::vector<InfiniteInt> low = karatsubaProduct(lhsLow, rhsLow);
+   std::vector<InfiniteInt> high = karatsubaProduct(lhsHigh, rhsHigh);
+   std::vector<InfiniteInt> middle = karatsubaProduct(sumOfHalves(lhs, half), sumOfHalves(rhs, half));
+   addShifted(middle, low, 0, true);
+   addShifted(middle, high, 0, true);
+
+   addShifted(product, low, 0, false);
+   addShifted(product, middle, half, false);
+   addShifted(product, high, 2 * half, false);
+   return product;
+}
+
+/** BigPoly()
+ * @brief   Default constructor. Creates the zero polynomial.
+*/
+BigPoly::BigPoly() { }
+
+/** BigPoly(const std::vector<InfiniteInt>&)
+ * @brief   Constructor.
+ * @param   coefficients   The coefficients, constant term first
+ * @post    Zero coefficients above the highest nonzero one are dropped.
+*/
+BigPoly::BigPoly(const std::vector<InfiniteInt>& coefficients) : coefficients_(coefficients) {
+   trim();
+}
+
+/** degree()
+ * @brief   Returns the degree of this polynomial, or -1 for the zero polynomial.
+*/
+int BigPoly::degree() const {
+   return static_cast<int>(coefficients_.size()) - 1;
+}
+
+/** coefficient(int)
+ * @brief   Returns the coefficient of x^power.
+ * @param   power    The power of x
+ * @return  The coefficient, which is zero for powers above the degree.
+ * @throw   std::out_of_range if power is negative.
+*/
+InfiniteInt BigPoly::coefficient(int power) const {
+   if (power < 0) {
+      throw std::out_of_range("BigPoly::coefficient() called with a negative power.");
+   }
+   return power <= degree() ? coefficients_[power] : InfiniteInt(0);
+}
+
+/** coefficients()
+ * @brief   Returns the coefficients, constant term first, with no zero
+ *          coefficients above the highest nonzero one.
+*/
+const std::vector<InfiniteInt>& BigPoly::coefficients() const {
+   return coefficients_;
+}
+
+/** operator+(const BigPoly&)
+ * @brief   Returns the sum of this polynomial and rhs.
+*/
+BigPoly BigPoly::operator+(const BigPoly& rhs) const {
+   std::vector<InfiniteInt> sum(std::max(coefficients_.size(), rhs.coefficients_.size()));
+   for (std::size_t i = 0; i < sum.size(); ++i) {
+      sum[i] = coefficient(static_cast<int>(i)) + rhs.coefficient(static_cast<int>(i));
+   }
+   return BigPoly(sum);
+}
+
+/** operator-(const BigPoly&)
+ * @brief   Returns the difference of this polynomial and rhs.
+*/
+BigPoly BigPoly::operator-(const BigPoly& rhs) const {
+   std::vector<InfiniteInt> difference(std::max(coefficients_.size(), rhs.coefficients_.size()));
+   for (std::size_t i = 0; i < difference.size(); ++i) {
+      difference[i] = coefficient(static_cast<int>(i)) - rhs.coefficient(static_cast<int>(i));
+   }
+   return BigPoly(difference);
+}
+
+/** operator*(const BigPoly&)
+ * @brief   Multiplies two polynomials by Karatsuba's method on the
+ *          coefficient lists: each operand is split into a low and a high
+ *          half and the product is built from three half-size products, so
+ *          the number of coefficient multiplications grows as n^1.58 rather
+ *          than n^2. Packing the operands into single InfiniteInts (Kronecker
+ *          substitution) is not used: the padding each digit slot needs
+ *          makes the packed schoolbook product several times larger than
+ *          the coefficient products it replaces.
+ * @param   rhs   The polynomial to multiply this one by
+ * @return  The product of this polynomial and rhs.
+*/
+BigPoly BigPoly::operator*(const BigPoly& rhs) const {
+   if (coefficients_.empty() || rhs.coefficients_.empty()) {
+      return BigPoly();
+   }
+   return BigPoly(karatsubaProduct(coefficients_, rhs.coefficients_));
+}
+
+/** divmod(const BigPoly&, BigPoly&, BigPoly&)
+ * @brief   Divides this polynomial by divisor with integer coefficients,
+ *          which always succeeds when divisor is monic.
+ * @param   divisor     The polynomial to divide this one by
+ * @param   quotient    Set to the quotient
+ * @param   remainder   Set to the remainder
+ * @pre     divisor is not zero, and its leading coefficient divides the
+ *          leading coefficient of every partial remainder of degree at least
+ *          divisor's.
+ * @post    *this = quotient * divisor + remainder, with remainder's degree
+ *          less than divisor's.
+ * @throw   std::domain_error if divisor is zero or the quotient does not have
+ *          integer coefficients.
+*/
+void BigPoly::divmod(const BigPoly& divisor, BigPoly& quotient, BigPoly& remainder) const {
+   if (divisor.coefficients_.empty()) {
+      throw std::domain_error("BigPoly division by the zero polynomial.");
+   }
+   std::vector<InfiniteInt> rest = coefficients_;
+   const std::vector<InfiniteInt>& terms = divisor.coefficients_;
+   const InfiniteInt& leading = terms.back();
+   bool isMonic = leading == InfiniteInt(1);
+   bool isNegatedMonic = leading == InfiniteInt(-1);
+   const Divisor leadingDivisor(leading);   // prepared once for every quotient term
+
+   std::vector<InfiniteInt> quotientTerms;
+   if (rest.size() >= terms.size()) {
+      quotientTerms.resize(rest.size() - terms.size() + 1, InfiniteInt(0));
+   }
+   for (std::size_t shift = quotientTerms.size(); shift-- > 0; ) {
+      const InfiniteInt& top = rest[shift + terms.size() - 1];
+      if (top == InfiniteInt(0)) {
+         continue;
+      }
+      InfiniteInt factor;
+      if (isMonic) {
+         factor = top;
+      } else if (isNegatedMonic) {
+         factor = InfiniteInt(0) - top;
+      } else {
+         // One division gives both the quotient term and the exactness check
+         InfiniteInt leftover;
+         leadingDivisor.divide(top, factor, leftover);
+         if (leftover != InfiniteInt(0)) {
+            throw std::domain_error("BigPoly quotient does not have integer coefficients.");
+         }
+      }
+      for (std::size_t j = 0; j < terms.size(); ++j) {
+         rest[shift + j] = rest[shift + j] - factor * terms[j];
+      }
+      quotientTerms[shift] = factor;
+   }
+
+   quotient = BigPoly(quotientTerms);
+   remainder = BigPoly(rest);
+}
+
+/** operator/(const BigPoly&)
+ * @brief   Returns the quotient of this polynomial divided by rhs.
+ * @throw   std::domain_error as divmod().
+*/
+BigPoly BigPoly::operator/(const BigPoly& rhs) const {
+   BigPoly quotient;
+   BigPoly remainder;
+   divmod(rhs, quotient, remainder);
+   return quotient;
+}
+
+/** operator%(const BigPoly&)
+ * @brief   Returns the remainder of this polynomial divided by rhs.
+ * @throw   std::domain_error as divmod().
+*/
+BigPoly BigPoly::operator%(const BigPoly& rhs) const {
+   BigPoly quotient;
+   BigPoly remainder;
+   divmod(rhs, quotient, remainder);
+   return remainder;
+}
+
+/** operator==(const BigPoly&)
+ * @brief   Returns true if this polynomial and rhs have the same coefficients.
+*/
+bool BigPoly::operator==(const BigPoly& rhs) const {
+   return coefficients_ == rhs.coefficients_;
+}
+
+/** operator!=(const BigPoly&)
+ * @brief   Returns true if this polynomial and rhs differ in some coefficient.
+*/
+bool BigPoly::operator!=(const BigPoly& rhs) const {
+   return !(*this == rhs);
+}
+
+/** evaluate(const InfiniteInt&)
+ * @brief   Evaluates this polynomial at x by Horner's rule.
+ * @param   x     The point to evaluate at
+ * @return  InfiniteInt representing this polynomial's value at x.
+*/
+InfiniteInt BigPoly::evaluate(const InfiniteInt& x) const {
+   InfiniteInt value(0);
+   for (std::size_t i = coefficients_.size(); i-- > 0; ) {
+      value = value * x + coefficients_[i];
+   }
+   return value;
+}
+
+/** evaluate(const std::vector<InfiniteInt>&, int)
+ * @brief   Evaluates this polynomial at many points with a subproduct tree:
+ *          the products of (x - point) over ever larger runs of points are
+ *          built bottom up, then this polynomial is reduced modulo the root
+ *          and each remainder modulo its children, so the value at each point
+ *          is the constant left at its leaf. The nodes of each level are
+ *          handled in parallel.
+ * @param   points      The points to evaluate at
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     numThreads is not negative.
+ * @post    Entry i equals evaluate(points[i]).
+ * @return  The values, in the same order as the points.
+ * @throw   std::invalid_argument if numThreads is negative.
+*/
+std::vector<InfiniteInt> BigPoly::evaluate(const std::vector<InfiniteInt>& points, int numThreads) const {
+   if (numThreads < 0) {
+      throw std::invalid_argument("BigPoly::evaluate() called with a negative thread count.");
+   }
+   if (points.empty()) {
+      return std::vector<InfiniteInt>();
+   }
+
+   // Subproduct tree: levels[0] holds x - point, the root the product of them all
+   std::vector<std::vector<BigPoly>> levels(1);
+   for (const InfiniteInt& point : points) {
+      levels[0].push_back(BigPoly({ InfiniteInt(0) - point, InfiniteInt(1) }));
+   }
+   while (levels.back().size() > 1) {
+      const std::vector<BigPoly>& below = levels.back();
+      std::vector<BigPoly> above((below.size() + 1) / 2);
+      parallelFor(above.size(), numThreads, [&](std::size_t k) {
+         above[k] = 2 * k + 1 < below.size() ? below[2 * k] * below[2 * k + 1] : below[2 * k];
+      });
+      levels.push_back(std::move(above));
+   }
+
+   // Remainder tree: every node is monic, so each division is exact over the integers
+   std::vector<BigPoly> current(1, *this % levels.back().front());
+   for (std::size_t level = levels.size() - 1; level-- > 0; ) {
+      const std::vector<BigPoly>& nodes = levels[level];
+      std::vector<BigPoly> next(nodes.size());
+      parallelFor(nodes.size(), numThreads, [&](std::size_t k) {
+         next[k] = current[k / 2] % nodes[k];
+      });
+      current.swap(next);
+   }
+
+   std::vector<InfiniteInt> values;
+   for (const BigPoly& leaf : current) {
+      values.push_back(leaf.coefficient(0));
+   }
+   return values;
+}
+
+/** compose(const BigPoly&)
+ * @brief   Returns this polynomial composed with inner, p(inner(x)), by
+ *          Horner's rule over polynomials.
+ * @param   inner    The polynomial substituted for x
+ * @return  The composition.
+*/
+BigPoly BigPoly::compose(const BigPoly& inner) const {
+   BigPoly result;
+   for (std::size_t i = coefficients_.size(); i-- > 0; ) {
+      result = result * inner + BigPoly({ coefficients_[i] });
+   }
+   return result;
+}
+
+/** trim()
+ * @brief   Drops zero coefficients above the highest nonzero one.
+*/
+void BigPoly::trim() {
+   while (!coefficients_.empty() && coefficients_.back() == InfiniteInt(0)) {
+      coefficients_.pop_back();
+   }
+}
+
@@ -0,0 +1,155 @@
+/** 
+ * @file BigPoly.h
+ * @brief Class definition for BigPoly, a polynomial with InfiniteInt
+ *    coefficients, multiplied by Karatsuba's method and evaluated at many
+ *    points with a subproduct tree
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef BIGPOLY_H
+#define BIGPOLY_H
+
+#include "InfiniteInt.h" // Type of the coefficients
+#include <stdexcept>     // std::invalid_argument, std::out_of_range and std::domain_error
+#include <vector>        // Coefficient lists and evaluation points
+
+class BigPoly {
+public:
+   //PUBLIC METHODS
+   /** BigPoly()
+    * @brief   Default constructor. Creates the zero polynomial.
+   */
+   BigPoly();
+
+   /** BigPoly(const std::vector<InfiniteInt>&)
+    * @brief   Constructor.
+    * @param   coefficients   The coefficients, constant term first
+    * @post    Zero coefficients above the highest nonzero one are dropped.
+   */
+   explicit BigPoly(const std::vector<InfiniteInt>& coefficients);
+
+   /** degree()
+    * @brief   Returns the degree of this polynomial, or -1 for the zero polynomial.
+   */
+   int degree() const;
+
+   /** coefficient(int)
+    * @brief   Returns the coefficient of x^power.
+    * @param   power    The power of x
+    * @return  The coefficient, which is zero for powers above the degree.
+    * @throw   std::out_of_range if power is negative.
+   */
+   InfiniteInt coefficient(int power) const;
+
+   /** coefficients()
+    * @brief   Returns the coefficients, constant term first, with no zero
+    *          coefficients above the highest nonzero one.
+   */
+   const std::vector<InfiniteInt>& coefficients() const;
+
+   /** operator+(const BigPoly&)
+    * @brief   Returns the sum of this polynomial and rhs.
+   */
+   BigPoly operator+(const BigPoly& rhs) const;
+
+   /** operator-(const BigPoly&)
+    * @brief   Returns the difference of this polynomial and rhs.
+   */
+   BigPoly operator-(const BigPoly& rhs) const;
+
+   /** operator*(const BigPoly&)
+    * @brief   Multiplies two polynomials by Karatsuba's method on the
+    *          coefficient lists: each operand is split into a low and a high
+    *          half and the product is built from three half-size products, so
+    *          the number of coefficient multiplications grows as n^1.58 rather
+    *          than n^2. Packing the operands into single InfiniteInts (Kronecker
+    *          substitution) is not used: the padding each digit slot needs
+    *          makes the packed schoolbook product several times larger than
+    *          the coefficient products it replaces.
+    * @param   rhs   The polynomial to multiply this one by
+    * @return  The product of this polynomial and rhs.
+   */
+   BigPoly operator*(const BigPoly& rhs) const;
+
+   /** divmod(const BigPoly&, BigPoly&, BigPoly&)
+    * @brief   Divides this polynomial by divisor with integer coefficients,
+    *          which always succeeds when divisor is monic.
+    * @param   divisor     The polynomial to divide this one by
+    * @param   quotient    Set to the quotient
+    * @param   remainder   Set to the remainder
+    * @pre     divisor is not zero, and its leading coefficient divides the
+    *          leading coefficient of every partial remainder of degree at least
+    *          divisor's.
+    * @post    *this = quotient * divisor + remainder, with remainder's degree
+    *          less than divisor's.
+    * @throw   std::domain_error if divisor is zero or the quotient does not have
+    *          integer coefficients.
+   */
+   void divmod(const BigPoly& divisor, BigPoly& quotient, BigPoly& remainder) const;
+
+   /** operator/(const BigPoly&)
+    * @brief   Returns the quotient of this polynomial divided by rhs.
+    * @throw   std::domain_error as divmod().
+   */
+   BigPoly operator/(const BigPoly& rhs) const;
+
+   /** operator%(const BigPoly&)
+    * @brief   Returns the remainder of this polynomial divided by rhs.
+    * @throw   std::domain_error as divmod().
+   */
+   BigPoly operator%(const BigPoly& rhs) const;
+
+   /** operator==(const BigPoly&)
+    * @brief   Returns true if this polynomial and rhs have the same coefficients.
+   */
+   bool operator==(const BigPoly& rhs) const;
+
+   /** operator!=(const BigPoly&)
+    * @brief   Returns true if this polynomial and rhs differ in some coefficient.
+   */
+   bool operator!=(const BigPoly& rhs) const;
+
+   /** evaluate(const InfiniteInt&)
+    * @brief   Evaluates this polynomial at x by Horner's rule.
+    * @param   x     The point to evaluate at
+    * @return  InfiniteInt representing this polynomial's value at x.
+   */
+   InfiniteInt evaluate(const InfiniteInt& x) const;
+
+   /** evaluate(const std::vector<InfiniteInt>&, int)
+    * @brief   Evaluates this polynomial at many points with a subproduct tree:
+    *          the products of (x - point) over ever larger runs of points are
+    *          built bottom up, then this polynomial is reduced modulo the root
+    *          and each remainder modulo its children, so the value at each point
+    *          is the constant left at its leaf. The nodes of each level are
+    *          handled in parallel.
+    * @param   points      The points to evaluate at
+    * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+    * @pre     numThreads is not negative.
+    * @post    Entry i equals evaluate(points[i]).
+    * @return  The values, in the same order as the points.
+    * @throw   std::invalid_argument if numThreads is negative.
+   */
+   std::vector<InfiniteInt> evaluate(const std::vector<InfiniteInt>& points, int numThreads = 0) const;
+
+   /** compose(const BigPoly&)
+    * @brief   Returns this polynomial composed with inner, p(inner(x)), by
+    *          Horner's rule over polynomials.
+    * @param   inner    The polynomial substituted for x
+    * @return  The composition.
+   */
+   BigPoly compose(const BigPoly& inner) const;
+
+private:
+   // PRIVATE FUNCTIONS
+   /** trim()
+    * @brief   Drops zero coefficients above the highest nonzero one.
+   */
+   void trim();
+
+   // DATA MEMBERS
+   std::vector<InfiniteInt> coefficients_;  // coefficients, constant term first; empty for zero
+};
+
+#endif // BIGPOLY_H
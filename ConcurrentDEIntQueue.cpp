@@ -0,0 +1,333 @@
+/** 
+ * @file ConcurrentDEIntQueue.cpp
+ * @brief Implementation for ConcurrentDEIntQueue, a link-based double-ended queue
+ *    of integers that any number of threads may push to and pop from at once
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "ConcurrentDEIntQueue.h"
+
+/* The entries are split into a front chain guarded by frontLock_ and a back
+   chain guarded by backLock_. Pushes and pops at one end only take that end's
+   lock while the end's chain is not empty. A pop that finds its own chain
+   empty takes both locks and splices the whole other chain over, so the two
+   ends only meet when the queue is nearly empty. Locks are always taken front
+   first, then back, so that no two threads wait on each other.
+
+   Nodes are allocated before a lock is taken and deleted after it is
+   released, so the allocator never runs inside a critical section. */
+
+/** ~ConcurrentDEIntQueue()
+ * @brief   Destructor.
+ * @pre     No other thread is using this queue.
+ * @post    This queue is empty and all dynamically allocated memory has been
+ *          returned to the system.
+*/
+ConcurrentDEIntQueue::~ConcurrentDEIntQueue() {
+   clear();
+}
+
+/** pushFront(int)
+ * @brief   Adds an integer to the front of this queue.
+ * @param   newItem  The integer being added to this queue.
+ * @post    A new node has been inserted at the front of this
+ *          queue with newItem as its data entry.
+*/
+void ConcurrentDEIntQueue::pushFront(int newItem) {
+   // Create the new node before locking
+   Node* newNode = new Node{ newItem, nullptr, nullptr };
+
+   std::lock_guard<std::mutex> guard(frontLock_);
+   if (frontSize_ == 0) {
+      // The front chain is empty - need to update its inner end as well as head
+      frontInner_ = newNode;
+   } else {
+      // The front chain is not empty - need to update previous head_'s prev pointer
+      head_->prev_ = newNode;
+      newNode->next_ = head_;
+   }
+   head_ = newNode;
+   ++frontSize_;
+}
+
+/** pushBack(int)
+ * @brief   Adds an integer to the back of this queue.
+ * @param   newItem  The integer being added to this queue.
+ * @post    A new node has been inserted at the back of this
+ *          queue with newItem as its data entry.
+*/
+void ConcurrentDEIntQueue::pushBack(int newItem) {
+   // Create the new node before locking
+   Node* newNode = new Node{ newItem, nullptr, nullptr };
+
+   std::lock_guard<std::mutex> guard(backLock_);
+   if (backSize_ == 0) {
+      // The back chain is empty - need to update its inner end as well as tail
+      backInner_ = newNode;
+   } else {
+      // The back chain is not empty - need to update previous tail's next pointer
+      tail_->next_ = newNode;
+      newNode->prev_ = tail_;
+   }
+   tail_ = newNode;
+   ++backSize_;
+}
+
+/** front()
+ * @brief   Returns the first integer in this queue.
+ * @pre     There is at least one integer in this queue.
+ * @post    The returned value was the first integer in this queue at some
+ *          instant during the call. Another thread may have removed it since.
+ * @return  The first integer in this queue.
+ * @throw   std::logic_error if this queue is empty.
+*/
+int ConcurrentDEIntQueue::front() const {
+   std::lock_guard<std::mutex> frontGuard(frontLock_);
+   if (frontSize_ > 0) {
+      return head_->data_;
+   }
+
+   // The front chain is empty - the first entry, if any, starts the back chain
+   std::lock_guard<std::mutex> backGuard(backLock_);
+   if (backSize_ <= 0) {
+      throw std::logic_error("ConcurrentDEIntQueue::front() called on empty queue.");
+   }
+   return backInner_->data_;
+}
+
+/** back()
+ * @brief   Returns the last integer in this queue.
+ * @pre     There is at least one integer in this queue.
+ * @post    The returned value was the last integer in this queue at some
+ *          instant during the call. Another thread may have removed it since.
+ * @return  The last integer in this queue.
+ * @throw   std::logic_error if this queue is empty.
+*/
+int ConcurrentDEIntQueue::back() const {
+   {
+      std::lock_guard<std::mutex> backGuard(backLock_);
+      if (backSize_ > 0) {
+         return tail_->data_;
+      }
+   }
+
+   // The back chain was empty - look again holding both locks, front first
+   std::lock_guard<std::mutex> frontGuard(frontLock_);
+   std::lock_guard<std::mutex> backGuard(backLock_);
+   if (backSize_ > 0) {
+      return tail_->data_;
+   }
+   if (frontSize_ <= 0) {
+      throw std::logic_error("ConcurrentDEIntQueue::back() called on empty queue.");
+   }
+   return frontInner_->data_;
+}
+
+/** popFront()
+ * @brief   Removes one integer from the front of this queue.
+ * @post    The first integer in this queue has been removed and its associated
+ *          dynamic memory has been deallocated.
+ * @throw   std::logic_error if this queue is empty.
+*/
+void ConcurrentDEIntQueue::popFront() {
+   int discarded;  // the removed entry, which the caller does not want
+   if (!tryPopFront(discarded)) {
+      throw std::logic_error("ConcurrentDEIntQueue::popFront() called on empty queue.");
+   }
+}
+
+/** popBack()
+ * @brief   Removes one integer from the back of this queue.
+ * @post    The last integer in this queue has been removed and its associated
+ *          dynamic memory has been deallocated.
+ * @throw   std::logic_error if this queue is empty.
+*/
+void ConcurrentDEIntQueue::popBack() {
+   int discarded;  // the removed entry, which the caller does not want
+   if (!tryPopBack(discarded)) {
+      throw std::logic_error("ConcurrentDEIntQueue::popBack() called on empty queue.");
+   }
+}
+
+/** tryPopFront(int&)
+ * @brief   Removes the first integer from this queue, if there is one.
+ * @param   item     Set to the removed integer
+ * @post    If this queue was not empty, its first integer has been removed
+ *          and stored in item. Otherwise item is unchanged.
+ * @return  True if an integer was removed and false if this queue was empty.
+*/
+bool ConcurrentDEIntQueue::tryPopFront(int& item) {
+   Node* toDelete;  // the node to delete
+   {
+      std::lock_guard<std::mutex> frontGuard(frontLock_);
+      toDelete = unlinkFront();
+      if (toDelete == nullptr) {
+         // The front chain is empty - take over the back chain
+         std::lock_guard<std::mutex> backGuard(backLock_);
+         moveBackChainToFront();
+         toDelete = unlinkFront();
+      }
+   }
+
+   // Deallocate outside the lock
+   if (toDelete == nullptr) {
+      return false;
+   }
+   item = toDelete->data_;
+   delete toDelete;
+   return true;
+}
+
+/** tryPopBack(int&)
+ * @brief   Removes the last integer from this queue, if there is one.
+ * @param   item     Set to the removed integer
+ * @post    If this queue was not empty, its last integer has been removed
+ *          and stored in item. Otherwise item is unchanged.
+ * @return  True if an integer was removed and false if this queue was empty.
+*/
+bool ConcurrentDEIntQueue::tryPopBack(int& item) {
+   Node* toDelete;  // the node to delete
+   {
+      std::lock_guard<std::mutex> backGuard(backLock_);
+      toDelete = unlinkBack();
+   }
+   if (toDelete == nullptr) {
+      // The back chain was empty - take over the front chain holding both
+      // locks, front first. Another thread may have refilled the back meanwhile.
+      std::lock_guard<std::mutex> frontGuard(frontLock_);
+      std::lock_guard<std::mutex> backGuard(backLock_);
+      if (backSize_ == 0) {
+         moveFrontChainToBack();
+      }
+      toDelete = unlinkBack();
+   }
+
+   // Deallocate outside the lock
+   if (toDelete == nullptr) {
+      return false;
+   }
+   item = toDelete->data_;
+   delete toDelete;
+   return true;
+}
+
+/** numEntries()
+ * @brief   Returns the number of entries in this queue.
+ * @post    The returned value was the number of entries in this queue at some
+ *          instant during the call.
+ * @return  The number of entries in this queue.
+*/
+int ConcurrentDEIntQueue::numEntries() const {
+   std::lock_guard<std::mutex> frontGuard(frontLock_);
+   std::lock_guard<std::mutex> backGuard(backLock_);
+   return frontSize_ + backSize_;
+}
+
+/** clear
+ * @brief   Removes all the entries from this queue.
+ * @post    This queue is empty and all dynamically allocated memory has been
+ *          returned to the system.
+*/
+void ConcurrentDEIntQueue::clear() {
+   Node* toDelete;  // the first node of the detached chain
+   {
+      // Join the two chains and detach them at once
+      std::lock_guard<std::mutex> frontGuard(frontLock_);
+      std::lock_guard<std::mutex> backGuard(backLock_);
+      if (frontSize_ > 0) {
+         frontInner_->next_ = backInner_;
+         toDelete = head_;
+      } else {
+         toDelete = backInner_;
+      }
+      head_ = frontInner_ = backInner_ = tail_ = nullptr;
+      frontSize_ = backSize_ = 0;
+   }
+
+   // Deallocate the chain outside the locks
+   while (toDelete != nullptr) {
+      Node* next = toDelete->next_;
+      delete toDelete;
+      toDelete = next;
+   }
+}
+
+/** unlinkFront()
+ * @brief   Detaches the first node from the front chain.
+ * @pre     The caller holds frontLock_.
+ * @post    If the front chain was not empty, its first node is no longer
+ *          linked into it and the caller owns that node.
+ * @return  The detached node, or null if the front chain was empty.
+*/
+ConcurrentDEIntQueue::Node* ConcurrentDEIntQueue::unlinkFront() {
+   if (frontSize_ <= 0) {
+      return nullptr;
+   }
+
+   Node* detached = head_;  // the node being removed
+   if (frontSize_ == 1) {
+      // Need to update both ends of the front chain
+      head_ = frontInner_ = nullptr;
+   } else {
+      // Need to update prev pointer of next node in the chain
+      head_ = head_->next_;
+      head_->prev_ = nullptr;
+   }
+   detached->next_ = nullptr;
+   --frontSize_;
+   return detached;
+}
+
+/** unlinkBack()
+ * @brief   Detaches the last node from the back chain.
+ * @pre     The caller holds backLock_.
+ * @post    If the back chain was not empty, its last node is no longer
+ *          linked into it and the caller owns that node.
+ * @return  The detached node, or null if the back chain was empty.
+*/
+ConcurrentDEIntQueue::Node* ConcurrentDEIntQueue::unlinkBack() {
+   if (backSize_ <= 0) {
+      return nullptr;
+   }
+
+   Node* detached = tail_;  // the node being removed
+   if (backSize_ == 1) {
+      // Need to update both ends of the back chain
+      backInner_ = tail_ = nullptr;
+   } else {
+      // Need to update next pointer of previous node in the chain
+      tail_ = tail_->prev_;
+      tail_->next_ = nullptr;
+   }
+   detached->prev_ = nullptr;
+   --backSize_;
+   return detached;
+}
+
+/** moveBackChainToFront()
+ * @brief   Hands every entry of the back chain over to the front chain.
+ * @pre     The caller holds frontLock_ and backLock_, and the front chain is empty.
+ * @post    The front chain holds the entries the back chain held, in the same
+ *          order, and the back chain is empty.
+*/
+void ConcurrentDEIntQueue::moveBackChainToFront() {
+   head_ = backInner_;
+   frontInner_ = tail_;
+   frontSize_ = backSize_;
+   backInner_ = tail_ = nullptr;
+   backSize_ = 0;
+}
+
+/** moveFrontChainToBack()
+ * @brief   Hands every entry of the front chain over to the back chain.
+ * @pre     The caller holds frontLock_ and backLock_, and the back chain is empty.
+ * @post    The back chain holds the entries the front chain held, in the same
+ *          order, and the front chain is empty.
+*/
+void ConcurrentDEIntQueue::moveFrontChainToBack() {
+   backInner_ = head_;
+   tail_ = frontInner_;
+   backSize_ = frontSize_;
+   head_ = frontInner_ = nullptr;
+   frontSize_ = 0;
+}
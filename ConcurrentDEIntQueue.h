@@ -0,0 +1,183 @@
+/** 
+ * @file ConcurrentDEIntQueue.h
+ * @brief Class definition for ConcurrentDEIntQueue, a link-based double-ended queue
+ *    of integers that any number of threads may push to and pop from at once
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef CONCURRENTDEINTQUEUE_H
+#define CONCURRENTDEINTQUEUE_H
+
+#include <mutex>     // Guards each end of the queue
+#include <exception> // Exceptions
+#include <stdexcept> // std::logic_error
+
+class ConcurrentDEIntQueue {
+public:
+   //PUBLIC METHODS
+   /** ConcurrentDEIntQueue()
+    * @brief   Default constructor.
+    * @post    This queue is empty and its size is 0.
+   */
+   ConcurrentDEIntQueue()
+      : frontSize_(0), head_(nullptr), frontInner_(nullptr),
+        backSize_(0), backInner_(nullptr), tail_(nullptr) { }
+
+   /** ~ConcurrentDEIntQueue()
+    * @brief   Destructor.
+    * @pre     No other thread is using this queue.
+    * @post    This queue is empty and all dynamically allocated memory has been
+    *          returned to the system.
+   */
+   ~ConcurrentDEIntQueue();
+
+   // Copying would need to lock two queues at once; share the queue instead
+   ConcurrentDEIntQueue(const ConcurrentDEIntQueue&) = delete;
+   ConcurrentDEIntQueue& operator=(const ConcurrentDEIntQueue&) = delete;
+
+   /** pushFront(int)
+    * @brief   Adds an integer to the front of this queue.
+    * @param   newItem  The integer being added to this queue.
+    * @post    A new node has been inserted at the front of this
+    *          queue with newItem as its data entry.
+   */
+   void pushFront(int newItem);
+
+   /** pushBack(int)
+    * @brief   Adds an integer to the back of this queue.
+    * @param   newItem  The integer being added to this queue.
+    * @post    A new node has been inserted at the back of this
+    *          queue with newItem as its data entry.
+   */
+   void pushBack(int newItem);
+
+   /** front()
+    * @brief   Returns the first integer in this queue.
+    * @pre     There is at least one integer in this queue.
+    * @post    The returned value was the first integer in this queue at some
+    *          instant during the call. Another thread may have removed it since.
+    * @return  The first integer in this queue.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   int front() const;
+
+   /** back()
+    * @brief   Returns the last integer in this queue.
+    * @pre     There is at least one integer in this queue.
+    * @post    The returned value was the last integer in this queue at some
+    *          instant during the call. Another thread may have removed it since.
+    * @return  The last integer in this queue.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   int back() const;
+
+   /** popFront()
+    * @brief   Removes one integer from the front of this queue.
+    * @post    The first integer in this queue has been removed and its associated
+    *          dynamic memory has been deallocated.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   void popFront();
+
+   /** popBack()
+    * @brief   Removes one integer from the back of this queue.
+    * @post    The last integer in this queue has been removed and its associated
+    *          dynamic memory has been deallocated.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   void popBack();
+
+   /** tryPopFront(int&)
+    * @brief   Removes the first integer from this queue, if there is one.
+    * @param   item     Set to the removed integer
+    * @post    If this queue was not empty, its first integer has been removed
+    *          and stored in item. Otherwise item is unchanged.
+    * @return  True if an integer was removed and false if this queue was empty.
+   */
+   bool tryPopFront(int& item);
+
+   /** tryPopBack(int&)
+    * @brief   Removes the last integer from this queue, if there is one.
+    * @param   item     Set to the removed integer
+    * @post    If this queue was not empty, its last integer has been removed
+    *          and stored in item. Otherwise item is unchanged.
+    * @return  True if an integer was removed and false if this queue was empty.
+   */
+   bool tryPopBack(int& item);
+
+   /** numEntries()
+    * @brief   Returns the number of entries in this queue.
+    * @post    The returned value was the number of entries in this queue at some
+    *          instant during the call.
+    * @return  The number of entries in this queue.
+   */
+   int numEntries() const;
+
+   /** clear
+    * @brief   Removes all the entries from this queue.
+    * @post    This queue is empty and all dynamically allocated memory has been
+    *          returned to the system.
+   */
+   void clear();
+
+private:
+   /** Node
+    * @brief   Node struct used by ConcurrentDEIntQueue
+   */
+   struct Node {
+      int data_;   // integer stored in this Node
+      Node* prev_; // pointer to the previous Node in the queue
+      Node* next_; // pointer to the next Node in the queue
+   };
+
+   // DATA MEMBERS
+   // The queue is split into a front chain and a back chain, each behind its own
+   // lock, so that threads working at opposite ends do not contend. In queue order
+   // the entries are head_ ... frontInner_ followed by backInner_ ... tail_.
+   mutable std::mutex frontLock_;  // guards frontSize_, head_, frontInner_ and the front chain
+   int frontSize_;                 // # of entries in the front chain
+   Node* head_;                    // pointer to the first Node in the queue
+   Node* frontInner_;              // pointer to the last Node in the front chain
+   mutable std::mutex backLock_;   // guards backSize_, backInner_, tail_ and the back chain
+   int backSize_;                  // # of entries in the back chain
+   Node* backInner_;               // pointer to the first Node in the back chain
+   Node* tail_;                    // pointer to the last Node in the queue
+
+   // PRIVATE FUNCTIONS
+   /** unlinkFront()
+    * @brief   Detaches the first node from the front chain.
+    * @pre     The caller holds frontLock_.
+    * @post    If the front chain was not empty, its first node is no longer
+    *          linked into it and the caller owns that node.
+    * @return  The detached node, or null if the front chain was empty.
+   */
+   Node* unlinkFront();
+
+   /** unlinkBack()
+    * @brief   Detaches the last node from the back chain.
+    * @pre     The caller holds backLock_.
+    * @post    If the back chain was not empty, its last node is no longer
+    *          linked into it and the caller owns that node.
+    * @return  The detached node, or null if the back chain was empty.
+   */
+   Node* unlinkBack();
+
+   /** moveBackChainToFront()
+    * @brief   Hands every entry of the back chain over to the front chain.
+    * @pre     The caller holds frontLock_ and backLock_, and the front chain is empty.
+    * @post    The front chain holds the entries the back chain held, in the same
+    *          order, and the back chain is empty.
+   */
+   void moveBackChainToFront();
+
+   /** moveFrontChainToBack()
+    * @brief   Hands every entry of the front chain over to the back chain.
+    * @pre     The caller holds frontLock_ and backLock_, and the back chain is empty.
+    * @post    The back chain holds the entries the front chain held, in the same
+    *          order, and the front chain is empty.
+   */
+   void moveFrontChainToBack();
+};
+
+#endif // CONCURRENTDEINTQUEUE_H
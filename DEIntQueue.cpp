@@ -5,6 +5,84 @@
  * @date 11/23/2020
 */
 #include "DEIntQueue.h"
+#include <condition_variable> // Waking the reclaimer thread
+#include <mutex>              // Guards the reclaimer's pending chains
+#include <thread>             // Reclaimer thread
+#include <vector>             // Pending chains
+
+/** Reclaimer
+ * @brief   Background thread that frees chains of nodes handed to it by clear().
+ *          A single instance is created on first use and never destroyed, so
+ *          queues destroyed during static destruction can still hand it chains.
+ *          Chains still pending when the program exits are returned with the
+ *          rest of the process's memory.
+*/
+class DEIntQueue::Reclaimer {
+public:
+   /** instance()
+    * @brief   Returns the process-wide reclaimer, starting its thread if needed.
+    * @return  Reference to the reclaimer.
+   */
+   static Reclaimer& instance() {
+      static Reclaimer* reclaimer = new Reclaimer;
+      return *reclaimer;
+   }
+
+   /** release(Node*)
+    * @brief   Hands a detached chain of nodes to the reclaimer thread.
+    * @param   chainHead   The first node in the chain, owned by no queue
+    * @post    The chain will be freed by the reclaimer thread.
+   */
+   void release(Node* chainHead) {
+      {
+         std::lock_guard<std::mutex> guard(lock_);
+         pending_.push_back(chainHead);
+      }
+      wake_.notify_one();
+   }
+
+   /** waitUntilIdle()
+    * @brief   Blocks until every chain released so far has been freed.
+   */
+   void waitUntilIdle() {
+      std::unique_lock<std::mutex> guard(lock_);
+      idle_.wait(guard, [this]() { return pending_.empty() && !busy_; });
+   }
+
+private:
+   Reclaimer() : busy_(false), worker_(&Reclaimer::run, this) { }
+
+   /** run()
+    * @brief   Reclaimer thread body. Frees chains for as long as the program runs.
+   */
+   void run() {
+      std::unique_lock<std::mutex> guard(lock_);
+      while (true) {
+         wake_.wait(guard, [this]() { return !pending_.empty(); });
+
+         // Free the chains without holding the lock
+         std::vector<Node*> toFree;
+         toFree.swap(pending_);
+         busy_ = true;
+         guard.unlock();
+         for (Node* chainHead : toFree) {
+            deleteChain(chainHead);
+         }
+         guard.lock();
+         busy_ = false;
+         idle_.notify_all();
+      }
+   }
+
+   std::mutex lock_;                  // guards pending_ and busy_
+   std::condition_variable wake_;     // signalled when there is work
+   std::condition_variable idle_;     // signalled when a batch of chains has been freed
+   std::vector<Node*> pending_;       // chains waiting to be freed
+   bool busy_;                        // true while chains are being freed outside the lock
+   std::thread worker_;               // the reclaimer thread; started last
+};
+
+std::atomic<int> DEIntQueue::deferredReleaseThreshold_(0);
 
 /** DEIntQueue(const DEIntQueue&)
  * @brief   Copy constructor.
@@ -15,6 +93,15 @@ DEIntQueue::DEIntQueue(const DEIntQueue& toCopy) {
    copy(toCopy);
 }
 
+/** DEIntQueue(std::initializer_list<int>)
+ * @brief   Constructs a queue containing the integers in a list.
+ * @param   items    The integers to store, ordered from front to back
+ * @post    This queue contains the entries of items in the same order.
+*/
+DEIntQueue::DEIntQueue(std::initializer_list<int> items) : size_(0), head_(nullptr), tail_(nullptr) {
+   insertBack(items.begin(), items.end());
+}
+
 /** operator=(const DEIntQueue&)
  * @brief   Assignment operator.
  * @param   toCopy   The queue being copied
@@ -197,13 +284,44 @@ int DEIntQueue::numEntries() const {
 /** clear
  * @brief   Removes all the entries from this queue.
  * @post    This queue is empty and all dynamically allocated memory has been
- *          returned to the system.
+ *          returned to the system, or handed to the background reclaimer if
+ *          this queue had at least the deferred release threshold of entries.
 */
 void DEIntQueue::clear() {
-   while (numEntries() > 0) {
-      popFront();
-   }
+   // Detach the whole chain at once instead of popping node by node
+   Node* toDelete = head_;
+   int numToDelete = size_;
+   head_ = tail_ = nullptr;
    size_ = 0;
+
+   // Free the chain here, or hand large chains to the reclaimer thread
+   int threshold = deferredReleaseThreshold_.load(std::memory_order_relaxed);
+   if (threshold > 0 && numToDelete >= threshold) {
+      Reclaimer::instance().release(toDelete);
+   } else {
+      deleteChain(toDelete);
+   }
+}
+
+/** setDeferredReleaseThreshold(int)
+ * @brief   Sets how large a queue must be for clear() and the destructor to
+ *          free its nodes on a background thread instead of the caller's.
+ * @param   minEntries  The smallest queue size whose nodes are freed in the
+ *                      background, or 0 to always free them immediately
+ * @post    Later calls to clear() and ~DEIntQueue() on any queue use the new
+ *          threshold. The default is 0.
+*/
+void DEIntQueue::setDeferredReleaseThreshold(int minEntries) {
+   deferredReleaseThreshold_.store(minEntries > 0 ? minEntries : 0, std::memory_order_relaxed);
+}
+
+/** waitForDeferredReleases()
+ * @brief   Blocks until the background reclaimer has freed every node handed
+ *          to it so far.
+ * @post    No nodes released by earlier calls to clear() are still allocated.
+*/
+void DEIntQueue::waitForDeferredReleases() {
+   Reclaimer::instance().waitUntilIdle();
 }
 
 /** copy
@@ -215,13 +333,48 @@ void DEIntQueue::clear() {
 */
 void DEIntQueue::copy(const DEIntQueue& toCopy) {
    size_ = 0;
-   if (toCopy.head_ == nullptr) {
-      // Other list is empty
-      head_ = tail_ = nullptr;
+   head_ = tail_ = nullptr;
+
+   // Copy the entries as one chain rather than pushing them one at a time
+   insertBack(toCopy.begin(), toCopy.end());
+}
+
+/** spliceBack(Node*, Node*, int)
+ * @brief   Links an already built chain of nodes onto the back of this queue.
+ * @param   chainHead   The first node in the chain (may be null)
+ * @param   chainTail   The last node in the chain (may be null)
+ * @param   chainSize   The number of nodes in the chain
+ * @pre     The chain is properly linked and owned by no other queue.
+ * @post    This queue owns the chain and its entries follow the previous back.
+*/
+void DEIntQueue::spliceBack(Node* chainHead, Node* chainTail, int chainSize) {
+   // Nothing to link
+   if (chainHead == nullptr) {
+      return;
+   }
+
+   if (numEntries() == 0) {
+      // The queue is empty - the chain becomes the whole queue
+      head_ = chainHead;
    } else {
-      for (Node* copyCur = toCopy.tail_; copyCur != nullptr; copyCur = copyCur->prev_) {
-         pushFront(copyCur->data_);
-      }
+      // The queue is not empty - attach the chain after the current tail
+      tail_->next_ = chainHead;
+      chainHead->prev_ = tail_;
+   }
+   tail_ = chainTail;
+   size_ += chainSize;
+}
+
+/** deleteChain(Node*)
+ * @brief   Deallocates every node in a chain, starting with the given node.
+ * @param   chainHead   The first node in the chain (may be null)
+ * @post    Every node reachable through next_ from chainHead has been deallocated.
+*/
+void DEIntQueue::deleteChain(Node* chainHead) {
+   while (chainHead != nullptr) {
+      Node* toDelete = chainHead;
+      chainHead = chainHead->next_;
+      delete toDelete;
    }
 }
 
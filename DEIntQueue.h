@@ -5,8 +5,13 @@
  * @date 11/23/2020
 */
 
-#include <iostream>  // Stream I/O
-#include <exception> // Exceptions
+#ifndef DEINTQUEUE_H
+#define DEINTQUEUE_H
+
+#include <iostream>         // Stream I/O
+#include <exception>        // Exceptions
+#include <initializer_list> // List construction
+#include <atomic>           // Deferred release threshold
 
 class DEIntQueue {
 public:
@@ -25,6 +30,22 @@ public:
    */
    DEIntQueue(const DEIntQueue& toCopy);
 
+   /** DEIntQueue(std::initializer_list<int>)
+    * @brief   Constructs a queue containing the integers in a list.
+    * @param   items    The integers to store, ordered from front to back
+    * @post    This queue contains the entries of items in the same order.
+   */
+   DEIntQueue(std::initializer_list<int> items);
+
+   /** DEIntQueue(InputIt, InputIt)
+    * @brief   Constructs a queue containing the integers in a range.
+    * @param   first    Iterator to the first integer in the range
+    * @param   last     Iterator one past the last integer in the range
+    * @post    This queue contains the entries of [first, last) in the same order.
+   */
+   template <typename InputIt>
+   DEIntQueue(InputIt first, InputIt last);
+
    /** operator=(const DEIntQueue&)
     * @brief   Assignment operator.
     * @param   toCopy   The queue being copied
@@ -57,6 +78,27 @@ public:
    */
    void pushBack(int newItem);
 
+   /** insertBack(InputIt, InputIt)
+    * @brief   Adds a range of integers to the back of this queue.
+    * @param   first    Iterator to the first integer in the range
+    * @param   last     Iterator one past the last integer in the range
+    * @post    The entries of [first, last) have been appended to the back of
+    *          this queue in the same order. If allocating a node fails, this
+    *          queue is unchanged.
+   */
+   template <typename InputIt>
+   void insertBack(InputIt first, InputIt last);
+
+   /** assign(InputIt, InputIt)
+    * @brief   Replaces the contents of this queue with a range of integers.
+    * @param   first    Iterator to the first integer in the range
+    * @param   last     Iterator one past the last integer in the range
+    * @pre     [first, last) does not refer to entries of this queue.
+    * @post    This queue contains the entries of [first, last) in the same order.
+   */
+   template <typename InputIt>
+   void assign(InputIt first, InputIt last);
+
    /** front()
     * @brief   Returns the first integer in this queue.
     * @pre     There is at least one integer in this queue.
@@ -102,10 +144,28 @@ public:
    /** clear
     * @brief   Removes all the entries from this queue.
     * @post    This queue is empty and all dynamically allocated memory has been
-    *          returned to the system.
+    *          returned to the system, or handed to the background reclaimer if
+    *          this queue had at least the deferred release threshold of entries.
    */
    void clear();
 
+   /** setDeferredReleaseThreshold(int)
+    * @brief   Sets how large a queue must be for clear() and the destructor to
+    *          free its nodes on a background thread instead of the caller's.
+    * @param   minEntries  The smallest queue size whose nodes are freed in the
+    *                      background, or 0 to always free them immediately
+    * @post    Later calls to clear() and ~DEIntQueue() on any queue use the new
+    *          threshold. The default is 0.
+   */
+   static void setDeferredReleaseThreshold(int minEntries);
+
+   /** waitForDeferredReleases()
+    * @brief   Blocks until the background reclaimer has freed every node handed
+    *          to it so far.
+    * @post    No nodes released by earlier calls to clear() are still allocated.
+   */
+   static void waitForDeferredReleases();
+
 private:
    /** Node
     * @brief   Node struct used by DEIntQueue
@@ -116,11 +176,18 @@ private:
       Node* next_; // pointer to the next Node in the queue
    };
 
+   /** Reclaimer
+    * @brief   Background thread that frees chains of nodes handed to it by clear()
+   */
+   class Reclaimer;
+
    // DATA MEMBERS
    int size_;      // # of entries in the queue
    Node* head_;    // pointer to the first Node in the queue
    Node* tail_;    // pointer to the last Node in the queue
 
+   static std::atomic<int> deferredReleaseThreshold_;  // min size freed in the background; 0 disables
+
    // PRIVATE FUNCTIONS
    /** copy
     * @brief   Copies the contents of another queue into this queue.
@@ -131,6 +198,23 @@ private:
    */
    void copy(const DEIntQueue& toCopy);
 
+   /** spliceBack(Node*, Node*, int)
+    * @brief   Links an already built chain of nodes onto the back of this queue.
+    * @param   chainHead   The first node in the chain (may be null)
+    * @param   chainTail   The last node in the chain (may be null)
+    * @param   chainSize   The number of nodes in the chain
+    * @pre     The chain is properly linked and owned by no other queue.
+    * @post    This queue owns the chain and its entries follow the previous back.
+   */
+   void spliceBack(Node* chainHead, Node* chainTail, int chainSize);
+
+   /** deleteChain(Node*)
+    * @brief   Deallocates every node in a chain, starting with the given node.
+    * @param   chainHead   The first node in the chain (may be null)
+    * @post    Every node reachable through next_ from chainHead has been deallocated.
+   */
+   static void deleteChain(Node* chainHead);
+
    // Allow access to private members by operator<<
    friend std::ostream& operator<<(std::ostream& outStream, const DEIntQueue& queueToPrint);
 
@@ -362,4 +446,67 @@ public:
  *          order from head to tail, separated by single spaces.
  * @return  Reference to the modified stream.
 */
-std::ostream& operator<<(std::ostream& outStream, const DEIntQueue& queueToPrint);
\ No newline at end of file
+std::ostream& operator<<(std::ostream& outStream, const DEIntQueue& queueToPrint);
+
+// TEMPLATE DEFINITIONS
+
+/** DEIntQueue(InputIt, InputIt)
+ * @brief   Constructs a queue containing the integers in a range.
+ * @param   first    Iterator to the first integer in the range
+ * @param   last     Iterator one past the last integer in the range
+ * @post    This queue contains the entries of [first, last) in the same order.
+*/
+template <typename InputIt>
+DEIntQueue::DEIntQueue(InputIt first, InputIt last) : size_(0), head_(nullptr), tail_(nullptr) {
+   insertBack(first, last);
+}
+
+/** insertBack(InputIt, InputIt)
+ * @brief   Adds a range of integers to the back of this queue.
+ * @param   first    Iterator to the first integer in the range
+ * @param   last     Iterator one past the last integer in the range
+ * @post    The entries of [first, last) have been appended to the back of
+ *          this queue in the same order. If allocating a node fails, this
+ *          queue is unchanged.
+*/
+template <typename InputIt>
+void DEIntQueue::insertBack(InputIt first, InputIt last) {
+   Node* chainHead = nullptr;  // first node of the new entries
+   Node* chainTail = nullptr;  // last node of the new entries
+   int chainSize{0};           // # of new entries
+
+   // Build the new entries as a separate chain so the queue is only touched once
+   try {
+      for (; first != last; ++first) {
+         Node* newNode = new Node{ *first, chainTail, nullptr };
+         if (chainTail == nullptr) {
+            chainHead = newNode;
+         } else {
+            chainTail->next_ = newNode;
+         }
+         chainTail = newNode;
+         ++chainSize;
+      }
+   } catch (...) {
+      // Leave the queue unchanged and release the partial chain
+      deleteChain(chainHead);
+      throw;
+   }
+
+   spliceBack(chainHead, chainTail, chainSize);
+}
+
+/** assign(InputIt, InputIt)
+ * @brief   Replaces the contents of this queue with a range of integers.
+ * @param   first    Iterator to the first integer in the range
+ * @param   last     Iterator one past the last integer in the range
+ * @pre     [first, last) does not refer to entries of this queue.
+ * @post    This queue contains the entries of [first, last) in the same order.
+*/
+template <typename InputIt>
+void DEIntQueue::assign(InputIt first, InputIt last) {
+   clear();
+   insertBack(first, last);
+}
+
+#endif // DEINTQUEUE_H
@@ -0,0 +1,172 @@
+/** 
+ * @file Divisor.cpp
+ * @brief Implementation for Divisor, a divisor prepared once (a table of its
+ *    digit multiples, or a machine word for small values) so that many
+ *    dividends can be divided by it without repeating the setup
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "Divisor.h"
+
+/** Divisor(const InfiniteInt&)
+ * @brief   Constructor. Prepares a divisor for repeated use: divisors up to
+ *          SMALL_DIVISOR_LIMIT are kept as a machine word; for larger ones
+ *          with n digits, k * |divisor| for k = 0 to 9 is stored as n + 1
+ *          plain digits.
+ * @param   divisor  The value later dividends are divided by
+ * @pre     divisor is not zero.
+ * @post    This Divisor divides by divisor.
+ * @throw   std::domain_error if divisor is zero.
+*/
+Divisor::Divisor(const InfiniteInt& divisor)
+   : value_(divisor), numDigits_(divisor.numDigits()), small_(0) {
+   if (divisor.digits_.front() == 0) {
+      throw std::domain_error("InfiniteInt division by zero.");
+   }
+
+   // Small divisors: read the digits into a word
+   if (numDigits_ <= CHUNK_DIGITS + 1) {
+      long long word{0};
+      for (auto cur = divisor.digits_.begin(); cur != divisor.digits_.end(); ++cur) {
+         word = word * 10 + *cur;
+      }
+      if (word <= SMALL_DIVISOR_LIMIT) {
+         small_ = word;
+         return;
+      }
+   }
+
+   // multiples_[k] = multiples_[k - 1] + |divisor|, as fixed-width digits
+   std::vector<int> magnitude(1, 0);   // |divisor| padded to n + 1 digits
+   for (auto cur = divisor.digits_.begin(); cur != divisor.digits_.end(); ++cur) {
+      magnitude.push_back(*cur);
+   }
+   multiples_.assign(10, std::vector<int>(numDigits_ + 1, 0));
+   for (int k = 1; k < 10; ++k) {
+      int carry{0};
+      for (int i = numDigits_; i >= 0; --i) {
+         int sum = multiples_[k - 1][i] + magnitude[i] + carry;
+         multiples_[k][i] = sum % 10;
+         carry = sum / 10;
+      }
+   }
+}
+
+/** divide(const InfiniteInt&, InfiniteInt&, InfiniteInt&)
+ * @brief   Divides a dividend by this divisor. Small divisors use short
+ *          division on CHUNK_DIGITS dividend digits per word step. Larger
+ *          ones use long division on a window of n + 1 digits: each
+ *          dividend digit is shifted into the window, the largest stored
+ *          multiple that fits is found by binary search, and it is
+ *          subtracted in place. No InfiniteInt temporaries are built per digit.
+ * @param   dividend    The InfiniteInt being divided
+ * @param   quotient    Set to dividend / divisor, truncated toward zero
+ * @param   remainder   Set to dividend % divisor, which takes the dividend's sign
+ * @post    quotient and remainder equal dividend / divisor and
+ *          dividend % divisor as computed by InfiniteInt.
+*/
+void Divisor::divide(const InfiniteInt& dividend, InfiniteInt& quotient, InfiniteInt& remainder) const {
+   std::vector<int> quotientDigits;  // digits of |quotient|, highest first
+   quotientDigits.reserve(dividend.numDigits());
+
+   if (small_ != 0) {
+      // Short division, CHUNK_DIGITS digits at a time, entirely in machine words;
+      // the first chunk takes the leftover digits so the rest are full width
+      long long running{0};
+      int chunkDigits = (dividend.numDigits() - 1) % CHUNK_DIGITS + 1;
+      auto cur = dividend.digits_.begin();
+      while (cur != dividend.digits_.end()) {
+         long long chunk{0};
+         long long chunkBase{1};
+         for (int i = 0; i < chunkDigits; ++i, ++cur) {
+            chunk = chunk * 10 + *cur;
+            chunkBase *= 10;
+         }
+         running = running * chunkBase + chunk;
+         long long quotientChunk = running / small_;
+         running %= small_;
+
+         // Write the quotient chunk as exactly chunkDigits digits
+         quotientDigits.resize(quotientDigits.size() + chunkDigits);
+         for (auto digit = quotientDigits.rbegin(); digit != quotientDigits.rbegin() + chunkDigits; ++digit) {
+            *digit = static_cast<int>(quotientChunk % 10);
+            quotientChunk /= 10;
+         }
+         chunkDigits = CHUNK_DIGITS;
+      }
+      remainder = InfiniteInt(static_cast<int>(running));
+   } else {
+      // The window always holds the running remainder, which is below |divisor|
+      std::vector<int> window(numDigits_ + 1, 0);
+      for (auto cur = dividend.digits_.begin(); cur != dividend.digits_.end(); ++cur) {
+         // window = window * 10 + digit; the top digit is always 0 before the shift
+         window.erase(window.begin());
+         window.push_back(*cur);
+
+         // Largest k with k * |divisor| <= window; equal-length digit vectors compare numerically
+         int low{0};
+         int high{9};
+         while (low < high) {
+            int mid = (low + high + 1) / 2;
+            if (window < multiples_[mid]) {
+               high = mid - 1;
+            } else {
+               low = mid;
+            }
+         }
+         quotientDigits.push_back(low);
+
+         // window -= k * |divisor|
+         if (low > 0) {
+            const std::vector<int>& multiple = multiples_[low];
+            int borrow{0};
+            for (int i = numDigits_; i >= 0; --i) {
+               int diff = window[i] - multiple[i] - borrow;
+               borrow = diff < 0 ? 1 : 0;
+               window[i] = diff + 10 * borrow;
+            }
+         }
+      }
+      remainder.digits_.assign(window.begin(), window.end());
+      remainder.removeLeadingZeroes();
+   }
+
+   quotient.digits_.assign(quotientDigits.begin(), quotientDigits.end());
+   quotient.isNegative_ = false;
+   quotient.removeLeadingZeroes();
+
+   // Signs follow InfiniteInt's operator/ and operator%
+   quotient.isNegative_ = quotient.digits_.front() != 0 && dividend.isNegative_ != value_.isNegative_;
+   remainder.isNegative_ = remainder.digits_.front() != 0 && dividend.isNegative_;
+   quotient.invalidateDecimal();
+   remainder.invalidateDecimal();
+}
+
+/** value()
+ * @brief   Returns the value this Divisor divides by.
+*/
+const InfiniteInt& Divisor::value() const {
+   return value_;
+}
+
+/** operator/(const InfiniteInt&, const Divisor&)
+ * @brief   Returns dividend / divisor, truncated toward zero, using the
+ *          divisor's precomputed state.
+*/
+InfiniteInt operator/(const InfiniteInt& dividend, const Divisor& divisor) {
+   InfiniteInt quotient;
+   InfiniteInt remainder;
+   divisor.divide(dividend, quotient, remainder);
+   return quotient;
+}
+
+/** operator%(const InfiniteInt&, const Divisor&)
+ * @brief   Returns dividend % divisor, with the sign of the dividend, using the
+ *          divisor's precomputed state.
+*/
+InfiniteInt operator%(const InfiniteInt& dividend, const Divisor& divisor) {
+   InfiniteInt quotient;
+   InfiniteInt remainder;
+   divisor.divide(dividend, quotient, remainder);
+   return remainder;
+}
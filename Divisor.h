@@ -0,0 +1,78 @@
+/** 
+ * @file Divisor.h
+ * @brief Class definition for Divisor, a divisor prepared once (a table of its
+ *    digit multiples, or a machine word for small values) so that many
+ *    dividends can be divided by it without repeating the setup
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef DIVISOR_H
+#define DIVISOR_H
+
+#include "InfiniteInt.h" // Type of the divisor, dividends and results
+#include <stdexcept>     // std::domain_error
+#include <vector>        // Table of multiples
+
+class Divisor {
+public:
+   static const int CHUNK_DIGITS = 9;                        // dividend digits consumed per word step
+   static const long long CHUNK_BASE = 1000000000LL;         // 10^CHUNK_DIGITS
+   // Divisors up to this use word arithmetic: the running remainder stays below
+   // it, so remainder * CHUNK_BASE + chunk stays below 10^18 and fits a long long
+   static const long long SMALL_DIVISOR_LIMIT = CHUNK_BASE;
+
+   //PUBLIC METHODS
+   /** Divisor(const InfiniteInt&)
+    * @brief   Constructor. Prepares a divisor for repeated use: divisors up to
+    *          SMALL_DIVISOR_LIMIT are kept as a machine word; for larger ones
+    *          with n digits, k * |divisor| for k = 0 to 9 is stored as n + 1
+    *          plain digits.
+    * @param   divisor  The value later dividends are divided by
+    * @pre     divisor is not zero.
+    * @post    This Divisor divides by divisor.
+    * @throw   std::domain_error if divisor is zero.
+   */
+   explicit Divisor(const InfiniteInt& divisor);
+
+   /** divide(const InfiniteInt&, InfiniteInt&, InfiniteInt&)
+    * @brief   Divides a dividend by this divisor. Small divisors use short
+    *          division on CHUNK_DIGITS dividend digits per word step. Larger
+    *          ones use long division on a window of n + 1 digits: each
+    *          dividend digit is shifted into the window, the largest stored
+    *          multiple that fits is found by binary search, and it is
+    *          subtracted in place. No InfiniteInt temporaries are built per digit.
+    * @param   dividend    The InfiniteInt being divided
+    * @param   quotient    Set to dividend / divisor, truncated toward zero
+    * @param   remainder   Set to dividend % divisor, which takes the dividend's sign
+    * @post    quotient and remainder equal dividend / divisor and
+    *          dividend % divisor as computed by InfiniteInt.
+   */
+   void divide(const InfiniteInt& dividend, InfiniteInt& quotient, InfiniteInt& remainder) const;
+
+   /** value()
+    * @brief   Returns the value this Divisor divides by.
+   */
+   const InfiniteInt& value() const;
+
+private:
+   // DATA MEMBERS
+   InfiniteInt value_;                       // the divisor, with its sign
+   int numDigits_;                           // n, the number of digits in the divisor
+   long long small_;                         // |divisor| if it is at most SMALL_DIVISOR_LIMIT, otherwise 0
+   std::vector<std::vector<int>> multiples_; // k * |divisor| as n + 1 digits, highest first; empty for small divisors
+};
+
+/** operator/(const InfiniteInt&, const Divisor&)
+ * @brief   Returns dividend / divisor, truncated toward zero, using the
+ *          divisor's precomputed state.
+*/
+InfiniteInt operator/(const InfiniteInt& dividend, const Divisor& divisor);
+
+/** operator%(const InfiniteInt&, const Divisor&)
+ * @brief   Returns dividend % divisor, with the sign of the dividend, using the
+ *          divisor's precomputed state.
+*/
+InfiniteInt operator%(const InfiniteInt& dividend, const Divisor& divisor);
+
+#endif // DIVISOR_H
@@ -0,0 +1,405 @@
+/** 
+ * @file Factorization.cpp
+ * @brief Implementation of primality testing and integer factorization for
+ *    InfiniteInts: trial division, Pollard-Brent rho and Lenstra's elliptic
+ *    curve method
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "Factorization.h"
+#include "NumberTheory.h"  // gcd, powmod and modInverse
+#include "ParallelFor.h"   // Running ECM curves in parallel
+#include <algorithm>       // std::sort and std::min
+#include <atomic>          // Stopping other curves once a factor is found
+#include <mutex>           // Recording the factor found by a curve
+
+// PRIVATE HELPERS
+
+/** smallPrimes(int)
+ * @brief   Returns every prime below bound (sieve of Eratosthenes).
+*/
+static std::vector<int> smallPrimes(int bound) {
+   std::vector<bool> composite(bound > 0 ? bound : 0, false);
+   std::vector<int> primes;
+   for (int candidate = 2; candidate < bound; ++candidate) {
+      if (!composite[candidate]) {
+         primes.push_back(candidate);
+         for (long long multiple = 1LL * candidate * candidate; multiple < bound; multiple += candidate) {
+            composite[multiple] = true;
+         }
+      }
+   }
+   return primes;
+}
+
+/** mulmod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns lhs * rhs mod modulus in the range 0 to modulus - 1.
+ * @pre     modulus is positive.
+*/
+static InfiniteInt mulmod(const InfiniteInt& lhs, const InfiniteInt& rhs, const InfiniteInt& modulus) {
+   InfiniteInt result = (lhs * rhs) % modulus;
+   return result < InfiniteInt(0) ? result + modulus : result;
+}
+
+/** submod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns lhs - rhs mod modulus in the range 0 to modulus - 1.
+ * @pre     lhs and rhs are between 0 and modulus - 1.
+*/
+static InfiniteInt submod(const InfiniteInt& lhs, const InfiniteInt& rhs, const InfiniteInt& modulus) {
+   InfiniteInt result = lhs - rhs;
+   return result < InfiniteInt(0) ? result + modulus : result;
+}
+
+/** addmod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns lhs + rhs mod modulus in the range 0 to modulus - 1.
+ * @pre     lhs and rhs are between 0 and modulus - 1.
+*/
+static InfiniteInt addmod(const InfiniteInt& lhs, const InfiniteInt& rhs, const InfiniteInt& modulus) {
+   InfiniteInt result = lhs + rhs;
+   return result < modulus ? result : result - modulus;
+}
+
+// PRIMALITY
+
+/** isProbablePrime(const InfiniteInt&, int)
+ * @brief   Miller-Rabin primality test using the first few primes as witnesses.
+ * @param   n        The number to test
+ * @param   rounds   The number of witnesses, at most 25
+ * @pre     rounds is between 1 and 25.
+ * @post    Primes always return true. With the default 12 rounds the answer is
+ *          exact for n below 3.3 * 10^24; above that a composite is reported
+ *          prime with probability at most 4^-rounds.
+ * @return  False if n is certainly not a prime, true if n is prime or very likely prime.
+ * @throw   std::invalid_argument if rounds is out of range.
+*/
+bool isProbablePrime(const InfiniteInt& n, int rounds) {
+   static const std::vector<int> witnesses = smallPrimes(100);  // the first 25 primes
+   if (rounds < 1 || rounds > static_cast<int>(witnesses.size())) {
+      throw std::invalid_argument("isProbablePrime() rounds must be between 1 and 25.");
+   }
+
+   const InfiniteInt one(1);
+   const InfiniteInt two(2);
+   if (n < two) {
+      return false;
+   }
+
+   // Small witnesses double as trial divisors
+   for (int witness : witnesses) {
+      InfiniteInt prime(witness);
+      if (n == prime) {
+         return true;
+      }
+      if (n % prime == InfiniteInt(0)) {
+         return false;
+      }
+   }
+
+   // n - 1 = oddPart * 2^twos
+   const InfiniteInt nMinusOne = n - one;
+   InfiniteInt oddPart = nMinusOne;
+   int twos{0};
+   while (oddPart % two == InfiniteInt(0)) {
+      oddPart = oddPart / two;
+      ++twos;
+   }
+
+   for (int round = 0; round < rounds; ++round) {
+      InfiniteInt x = powmod(InfiniteInt(witnesses[round]), oddPart, n);
+      if (x == one || x == nMinusOne) {
+         continue;
+      }
+      bool reachedMinusOne{false};
+      for (int i = 1; i < twos && !reachedMinusOne; ++i) {
+         x = mulmod(x, x, n);
+         reachedMinusOne = x == nMinusOne;
+      }
+      if (!reachedMinusOne) {
+         return false;
+      }
+   }
+   return true;
+}
+
+// POLLARD-BRENT RHO
+
+/** pollardBrent(const InfiniteInt&, int, long long)
+ * @brief   Searches for a factor of n with Brent's variant of Pollard's rho,
+ *          iterating x -> x^2 + c and taking one gcd per RHO_BATCH_SIZE steps
+ *          over the product of the differences.
+ * @param   n          The composite to split
+ * @param   c          The constant in the iteration; different values give different walks
+ * @param   maxSteps   The number of iterations after which the search gives up
+ * @pre     n is an odd composite greater than 3.
+ * @post    The returned value divides n.
+ * @return  A divisor of n strictly between 1 and n, or n if none was found.
+*/
+InfiniteInt pollardBrent(const InfiniteInt& n, int c, long long maxSteps) {
+   const InfiniteInt one(1);
+   const InfiniteInt increment = InfiniteInt(c) % n;
+   auto step = [&](const InfiniteInt& value) { return addmod(mulmod(value, value, n), increment, n); };
+
+   InfiniteInt y(2);            // the walk's current value
+   InfiniteInt x;               // value saved at the start of the current power-of-two stretch
+   InfiniteInt savedY;          // y at the start of the current batch, for backtracking
+   InfiniteInt product(one);    // product of |x - y| over the current batch
+   InfiniteInt divisor(one);    // gcd(product, n)
+   long long stretch{1};        // length of the current power-of-two stretch
+   long long steps{0};          // iterations made so far
+
+   while (divisor == one && steps < maxSteps) {
+      x = y;
+      for (long long i = 0; i < stretch; ++i) {
+         y = step(y);
+      }
+      steps += stretch;
+
+      // Walk the stretch in batches, one gcd per batch
+      for (long long done = 0; done < stretch && divisor == one; done += RHO_BATCH_SIZE) {
+         savedY = y;
+         long long batch = std::min<long long>(RHO_BATCH_SIZE, stretch - done);
+         for (long long i = 0; i < batch; ++i) {
+            y = step(y);
+            product = mulmod(product, submod(x, y, n), n);
+         }
+         steps += batch;
+         divisor = gcd(product, n);
+      }
+      stretch *= 2;
+   }
+
+   // The batch overshot to a multiple of n - redo it one gcd at a time
+   if (divisor == n) {
+      divisor = one;
+      for (long long i = 0; i < RHO_BATCH_SIZE && divisor == one; ++i) {
+         savedY = step(savedY);
+         divisor = gcd(submod(x, savedY, n), n);
+      }
+   }
+   return divisor == one ? n : divisor;
+}
+
+// ELLIPTIC CURVE METHOD
+
+/** MontgomeryPoint
+ * @brief   Point on a Montgomery curve in projective x-only coordinates (X : Z).
+*/
+struct MontgomeryPoint {
+   InfiniteInt x_;   // projective X coordinate
+   InfiniteInt z_;   // projective Z coordinate
+};
+
+/** doublePoint(const MontgomeryPoint&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns 2P on the curve with a24 = (A + 2) / 4.
+*/
+static MontgomeryPoint doublePoint(const MontgomeryPoint& p, const InfiniteInt& a24, const InfiniteInt& n) {
+   InfiniteInt sum = addmod(p.x_, p.z_, n);
+   InfiniteInt difference = submod(p.x_, p.z_, n);
+   InfiniteInt sumSquared = mulmod(sum, sum, n);
+   InfiniteInt differenceSquared = mulmod(difference, difference, n);
+   InfiniteInt cross = submod(sumSquared, differenceSquared, n);   // 4XZ
+   return { mulmod(sumSquared, differenceSquared, n),
+            mulmod(cross, addmod(differenceSquared, mulmod(a24, cross, n), n), n) };
+}
+
+/** addPoints(const MontgomeryPoint&, const MontgomeryPoint&, const MontgomeryPoint&, const InfiniteInt&)
+ * @brief   Returns P + Q given P - Q (differential addition).
+*/
+static MontgomeryPoint addPoints(const MontgomeryPoint& p, const MontgomeryPoint& q,
+                                 const MontgomeryPoint& difference, const InfiniteInt& n) {
+   InfiniteInt u = mulmod(submod(p.x_, p.z_, n), addmod(q.x_, q.z_, n), n);
+   InfiniteInt v = mulmod(addmod(p.x_, p.z_, n), submod(q.x_, q.z_, n), n);
+   InfiniteInt sum = addmod(u, v, n);
+   InfiniteInt diff = submod(u, v, n);
+   return { mulmod(difference.z_, mulmod(sum, sum, n), n),
+            mulmod(difference.x_, mulmod(diff, diff, n), n) };
+}
+
+/** multiplyPoint(const MontgomeryPoint&, long long, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns kP with the Montgomery ladder.
+ * @pre     k is positive.
+*/
+static MontgomeryPoint multiplyPoint(const MontgomeryPoint& p, long long k,
+                                     const InfiniteInt& a24, const InfiniteInt& n) {
+   int topBit{62};
+   while (((k >> topBit) & 1) == 0) {
+      --topBit;
+   }
+
+   // Invariant: high - low = p
+   MontgomeryPoint low = p;
+   MontgomeryPoint high = doublePoint(p, a24, n);
+   for (int bit = topBit - 1; bit >= 0; --bit) {
+      if ((k >> bit) & 1) {
+         low = addPoints(high, low, p, n);
+         high = doublePoint(high, a24, n);
+      } else {
+         high = addPoints(high, low, p, n);
+         low = doublePoint(low, a24, n);
+      }
+   }
+   return low;
+}
+
+/** ecmCurve(const InfiniteInt&, int, const std::vector<int>&, int, const std::atomic<bool>&)
+ * @brief   Runs stage 1 on the Suyama curve with parameter sigma.
+ * @return  gcd(Z, n) at the end of stage 1 (or the gcd that stopped curve
+ *          setup), or n if another curve finished first.
+*/
+static InfiniteInt ecmCurve(const InfiniteInt& n, int sigma, const std::vector<int>& primes,
+                            int stage1Bound, const std::atomic<bool>& stop) {
+   // Suyama: u = sigma^2 - 5, v = 4 sigma, start (u^3 : v^3), a24 = (v - u)^3 (3u + v) / (16 u^3 v)
+   const InfiniteInt sigmaValue(sigma);
+   InfiniteInt u = submod(mulmod(sigmaValue, sigmaValue, n), InfiniteInt(5) % n, n);
+   InfiniteInt v = mulmod(InfiniteInt(4), sigmaValue, n);
+   InfiniteInt uCubed = mulmod(mulmod(u, u, n), u, n);
+   InfiniteInt vMinusU = submod(v, u, n);
+   InfiniteInt numerator = mulmod(mulmod(mulmod(vMinusU, vMinusU, n), vMinusU, n),
+                                  addmod(mulmod(InfiniteInt(3), u, n), v, n), n);
+   InfiniteInt denominator = mulmod(mulmod(InfiniteInt(16), uCubed, n), v, n);
+   InfiniteInt common = gcd(denominator, n);
+   if (common != InfiniteInt(1)) {
+      return common;   // setup itself found a factor (or the curve is degenerate)
+   }
+   InfiniteInt a24 = mulmod(numerator, modInverse(denominator, n), n);
+   MontgomeryPoint point = { uCubed, mulmod(mulmod(v, v, n), v, n) };
+
+   // Multiply by the largest power of each prime up to the bound
+   for (int prime : primes) {
+      if (stop) {
+         return n;
+      }
+      long long primePower = prime;
+      while (primePower * prime <= stage1Bound) {
+         primePower *= prime;
+      }
+      point = multiplyPoint(point, primePower, a24, n);
+   }
+   return gcd(point.z_, n);
+}
+
+/** ecmFactor(const InfiniteInt&, int, int, int, int)
+ * @brief   Searches for a factor of n with stage 1 of Lenstra's elliptic curve
+ *          method on Montgomery curves (Suyama's parametrization). Curves are
+ *          independent, so they are run in parallel; the search stops as soon
+ *          as any curve finds a factor.
+ * @param   n             The composite to split
+ * @param   numCurves     The number of curves to try
+ * @param   stage1Bound   The smoothness bound B1
+ * @param   numThreads    The number of worker threads, or 0 to use one per hardware thread
+ * @param   firstSigma    The Suyama parameter of the first curve; curve i uses firstSigma + i
+ * @pre     n is an odd composite greater than 3, numCurves and
+ *          stage1Bound are positive, and firstSigma is at least 6.
+ * @post    The returned value divides n.
+ * @return  A divisor of n strictly between 1 and n, or n if none was found.
+ * @throw   std::invalid_argument if numCurves or stage1Bound is not positive or
+ *          firstSigma is less than 6.
+*/
+InfiniteInt ecmFactor(const InfiniteInt& n, int numCurves, int stage1Bound, int numThreads,
+                      int firstSigma) {
+   if (numCurves < 1 || stage1Bound < 1) {
+      throw std::invalid_argument("ecmFactor() needs a positive number of curves and bound.");
+   }
+   if (firstSigma < 6) {
+      throw std::invalid_argument("ecmFactor() needs a first sigma of at least 6.");
+   }
+
+   const std::vector<int> primes = smallPrimes(stage1Bound + 1);
+   std::atomic<bool> found(false);  // whether some curve has found a factor
+   std::mutex resultLock;           // guards result
+   InfiniteInt result = n;          // the factor found, or n
+
+   parallelFor(static_cast<std::size_t>(numCurves), numThreads, [&](std::size_t curve) {
+      if (found) {
+         return;
+      }
+      InfiniteInt divisor = ecmCurve(n, firstSigma + static_cast<int>(curve), primes, stage1Bound, found);
+      if (divisor != InfiniteInt(1) && divisor != n) {
+         std::lock_guard<std::mutex> guard(resultLock);
+         if (!found) {
+            result = divisor;
+            found = true;
+         }
+      }
+   });
+   return result;
+}
+
+// FACTORIZATION
+
+/** factor(const InfiniteInt&, int)
+ * @brief   Returns the prime factorization of |n|: primes below
+ *          TRIAL_DIVISION_BOUND are divided out, then each remaining composite
+ *          is split with Pollard-Brent rho and, if that stalls, with up to
+ *          ECM_MAX_ROUNDS rounds of ECM_CURVES_PER_ROUND fresh curves, B1
+ *          growing from ECM_FIRST_STAGE1_BOUND to ECM_MAX_STAGE1_BOUND.
+ *          Arithmetic is on decimal digit lists, so only small factors are
+ *          practical: rho finds factors of up to about 10 digits in seconds,
+ *          but one ECM curve with B1 = 2000 on a 33-digit composite takes
+ *          about 7 s on one core. Factors of 40 to 60 digits are out of reach.
+ * @param   n            The number to factor
+ * @param   numThreads   The number of worker threads for ECM, or 0 to use one per hardware thread
+ * @pre     n is not zero.
+ * @post    The product of the returned primes is |n|. Primes of more than 24
+ *          digits are probable primes (see isProbablePrime()).
+ * @return  The prime factors of |n| in increasing order, repeated by
+ *          multiplicity. Empty when |n| is 1.
+ * @throw   std::invalid_argument if n is zero.
+ * @throw   std::runtime_error if a composite is not split within the ECM rounds.
+*/
+std::vector<InfiniteInt> factor(const InfiniteInt& n, int numThreads) {
+   const InfiniteInt zero(0);
+   const InfiniteInt one(1);
+   if (n == zero) {
+      throw std::invalid_argument("factor() called with zero.");
+   }
+
+   std::vector<InfiniteInt> factors;
+   InfiniteInt remaining = n < zero ? zero - n : n;
+
+   // Trial division by small primes, stopping early once remaining is prime or 1
+   for (int prime : smallPrimes(TRIAL_DIVISION_BOUND)) {
+      InfiniteInt primeValue(prime);
+      if (remaining < primeValue * primeValue) {
+         break;
+      }
+      while (remaining % primeValue == zero) {
+         factors.push_back(primeValue);
+         remaining = remaining / primeValue;
+      }
+   }
+
+   // Split composites until only primes are left
+   std::vector<InfiniteInt> pending;
+   if (remaining != one) {
+      pending.push_back(remaining);
+   }
+   while (!pending.empty()) {
+      InfiniteInt current = pending.back();
+      pending.pop_back();
+      if (isProbablePrime(current)) {
+         factors.push_back(current);
+         continue;
+      }
+
+      // Rho first, then rounds of new ECM curves with bounds growing up to the cap
+      InfiniteInt divisor = pollardBrent(current, 1);
+      for (int c = 2; divisor == current && c <= 3; ++c) {
+         divisor = pollardBrent(current, c);
+      }
+      int stage1Bound = ECM_FIRST_STAGE1_BOUND;
+      for (int round = 0; divisor == current && round < ECM_MAX_ROUNDS; ++round) {
+         divisor = ecmFactor(current, ECM_CURVES_PER_ROUND, stage1Bound, numThreads,
+                             6 + round * ECM_CURVES_PER_ROUND);
+         stage1Bound = std::min(stage1Bound * 5, ECM_MAX_STAGE1_BOUND);
+      }
+      if (divisor == current) {
+         throw std::runtime_error("factor() could not split a composite within its ECM rounds.");
+      }
+      pending.push_back(divisor);
+      pending.push_back(current / divisor);
+   }
+
+   std::sort(factors.begin(), factors.end());
+   return factors;
+}
@@ -0,0 +1,92 @@
+/** 
+ * @file Factorization.h
+ * @brief Primality testing and integer factorization for InfiniteInts: trial
+ *    division, Pollard-Brent rho and Lenstra's elliptic curve method
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef FACTORIZATION_H
+#define FACTORIZATION_H
+
+#include "InfiniteInt.h" // Type of the numbers being factored
+#include <stdexcept>     // std::invalid_argument and std::runtime_error
+#include <vector>        // Lists of factors
+
+const int TRIAL_DIVISION_BOUND = 1000;              // factor() divides out every prime below this first
+const long long RHO_STEP_LIMIT = 200000;            // steps factor() gives one rho attempt before trying ECM
+const int RHO_BATCH_SIZE = 100;                     // rho steps whose differences share one gcd
+const int ECM_CURVES_PER_ROUND = 32;                // curves factor() runs per ECM round, each with a fresh sigma
+const int ECM_FIRST_STAGE1_BOUND = 2000;            // B1 of factor()'s first ECM round; later rounds use 5 times more
+const int ECM_MAX_STAGE1_BOUND = 50000;             // largest B1 factor() uses; later rounds repeat it with new curves
+const int ECM_MAX_ROUNDS = 6;                       // ECM rounds factor() runs on one composite before giving up
+
+/** isProbablePrime(const InfiniteInt&, int)
+ * @brief   Miller-Rabin primality test using the first few primes as witnesses.
+ * @param   n        The number to test
+ * @param   rounds   The number of witnesses, at most 25
+ * @pre     rounds is between 1 and 25.
+ * @post    Primes always return true. With the default 12 rounds the answer is
+ *          exact for n below 3.3 * 10^24; above that a composite is reported
+ *          prime with probability at most 4^-rounds.
+ * @return  False if n is certainly not a prime, true if n is prime or very likely prime.
+ * @throw   std::invalid_argument if rounds is out of range.
+*/
+bool isProbablePrime(const InfiniteInt& n, int rounds = 12);
+
+/** pollardBrent(const InfiniteInt&, int, long long)
+ * @brief   Searches for a factor of n with Brent's variant of Pollard's rho,
+ *          iterating x -> x^2 + c and taking one gcd per RHO_BATCH_SIZE steps
+ *          over the product of the differences.
+ * @param   n          The composite to split
+ * @param   c          The constant in the iteration; different values give different walks
+ * @param   maxSteps   The number of iterations after which the search gives up
+ * @pre     n is an odd composite greater than 3.
+ * @post    The returned value divides n.
+ * @return  A divisor of n strictly between 1 and n, or n if none was found.
+*/
+InfiniteInt pollardBrent(const InfiniteInt& n, int c = 1, long long maxSteps = RHO_STEP_LIMIT);
+
+/** ecmFactor(const InfiniteInt&, int, int, int, int)
+ * @brief   Searches for a factor of n with stage 1 of Lenstra's elliptic curve
+ *          method on Montgomery curves (Suyama's parametrization). Curves are
+ *          independent, so they are run in parallel; the search stops as soon
+ *          as any curve finds a factor.
+ * @param   n             The composite to split
+ * @param   numCurves     The number of curves to try
+ * @param   stage1Bound   The smoothness bound B1
+ * @param   numThreads    The number of worker threads, or 0 to use one per hardware thread
+ * @param   firstSigma    The Suyama parameter of the first curve; curve i uses firstSigma + i
+ * @pre     n is an odd composite greater than 3, numCurves and
+ *          stage1Bound are positive, and firstSigma is at least 6.
+ * @post    The returned value divides n.
+ * @return  A divisor of n strictly between 1 and n, or n if none was found.
+ * @throw   std::invalid_argument if numCurves or stage1Bound is not positive or
+ *          firstSigma is less than 6.
+*/
+InfiniteInt ecmFactor(const InfiniteInt& n, int numCurves, int stage1Bound, int numThreads = 0,
+                      int firstSigma = 6);
+
+/** factor(const InfiniteInt&, int)
+ * @brief   Returns the prime factorization of |n|: primes below
+ *          TRIAL_DIVISION_BOUND are divided out, then each remaining composite
+ *          is split with Pollard-Brent rho and, if that stalls, with up to
+ *          ECM_MAX_ROUNDS rounds of ECM_CURVES_PER_ROUND fresh curves, B1
+ *          growing from ECM_FIRST_STAGE1_BOUND to ECM_MAX_STAGE1_BOUND.
+ *          Arithmetic is on decimal digit lists, so only small factors are
+ *          practical: rho finds factors of up to about 10 digits in seconds,
+ *          but one ECM curve with B1 = 2000 on a 33-digit composite takes
+ *          about 7 s on one core. Factors of 40 to 60 digits are out of reach.
+ * @param   n            The number to factor
+ * @param   numThreads   The number of worker threads for ECM, or 0 to use one per hardware thread
+ * @pre     n is not zero.
+ * @post    The product of the returned primes is |n|. Primes of more than 24
+ *          digits are probable primes (see isProbablePrime()).
+ * @return  The prime factors of |n| in increasing order, repeated by
+ *          multiplicity. Empty when |n| is 1.
+ * @throw   std::invalid_argument if n is zero.
+ * @throw   std::runtime_error if a composite is not split within the ECM rounds.
+*/
+std::vector<InfiniteInt> factor(const InfiniteInt& n, int numThreads = 0);
+
+#endif // FACTORIZATION_H
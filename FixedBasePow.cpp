@@ -0,0 +1,97 @@
+/** 
+ * @file FixedBasePow.cpp
+ * @brief Implementation for FixedBasePow, which precomputes a table of powers
+ *    of one base modulo one modulus so that later exponentiations of that base
+ *    need only multiplications
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "FixedBasePow.h"
+#include <sstream>  // Reading the decimal digits of exponents
+#include <string>   // Decimal digits of exponents
+
+/** FixedBasePow(const InfiniteInt&, const InfiniteInt&, int)
+ * @brief   Constructor. Builds the table base^(d * 10^j) mod modulus for every
+ *          nonzero decimal digit d and every digit position j below
+ *          maxExponentDigits.
+ * @param   base                 The base every later exponentiation uses
+ * @param   modulus              The modulus every result is reduced by
+ * @param   maxExponentDigits    The most digits any later exponent may have
+ * @pre     modulus is positive and maxExponentDigits is at least 1.
+ * @post    The table holds 9 * maxExponentDigits powers.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+FixedBasePow::FixedBasePow(const InfiniteInt& base, const InfiniteInt& modulus, int maxExponentDigits)
+   : modulus_(modulus), maxExponentDigits_(maxExponentDigits) {
+   if (!(InfiniteInt(0) < modulus)) {
+      throw std::invalid_argument("FixedBasePow modulus must be positive.");
+   }
+   if (maxExponentDigits < 1) {
+      throw std::invalid_argument("FixedBasePow must allow exponents of at least one digit.");
+   }
+
+   table_.reserve(9 * static_cast<std::size_t>(maxExponentDigits));
+
+   // base^(10^j) comes from the previous position's ninth entry times one more factor
+   InfiniteInt positionBase = base % modulus;   // base^(10^j) mod modulus
+   if (positionBase < InfiniteInt(0)) {
+      positionBase = positionBase + modulus;
+   }
+   for (int j = 0; j < maxExponentDigits; ++j) {
+      if (j > 0) {
+         positionBase = (table_.back() * table_[9 * (j - 1)]) % modulus;
+      }
+      table_.push_back(positionBase);
+      for (int d = 2; d <= 9; ++d) {
+         table_.push_back((table_.back() * positionBase) % modulus);
+      }
+   }
+}
+
+/** pow(const InfiniteInt&)
+ * @brief   Returns base^exponent mod modulus. Each nonzero digit of the
+ *          exponent selects one table entry, so the result costs one modular
+ *          multiplication per nonzero digit and no squarings.
+ * @param   exponent    The power to raise the base to
+ * @pre     exponent is not negative and has at most maxExponentDigits() digits.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing base^exponent mod modulus.
+ * @throw   std::invalid_argument if exponent is negative.
+ * @throw   std::out_of_range if exponent has too many digits.
+*/
+InfiniteInt FixedBasePow::pow(const InfiniteInt& exponent) const {
+   if (exponent < InfiniteInt(0)) {
+      throw std::invalid_argument("FixedBasePow::pow() called with a negative exponent.");
+   }
+   if (exponent.numDigits() > maxExponentDigits_) {
+      throw std::out_of_range("FixedBasePow::pow() exponent has more digits than the table covers.");
+   }
+
+   std::ostringstream text;
+   text << exponent;
+   const std::string digits = text.str();
+
+   // Multiply together the entry for each nonzero digit, lowest position first
+   InfiniteInt result = InfiniteInt(1) % modulus_;
+   for (std::size_t j = 0; j < digits.size(); ++j) {
+      int digit = digits[digits.size() - 1 - j] - '0';
+      if (digit != 0) {
+         result = (result * table_[9 * j + (digit - 1)]) % modulus_;
+      }
+   }
+   return result;
+}
+
+/** maxExponentDigits()
+ * @brief   Returns the most digits an exponent passed to pow() may have.
+*/
+int FixedBasePow::maxExponentDigits() const {
+   return maxExponentDigits_;
+}
+
+/** modulus()
+ * @brief   Returns the modulus results are reduced by.
+*/
+const InfiniteInt& FixedBasePow::modulus() const {
+   return modulus_;
+}
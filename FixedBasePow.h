@@ -0,0 +1,63 @@
+/** 
+ * @file FixedBasePow.h
+ * @brief Class definition for FixedBasePow, which precomputes a table of powers
+ *    of one base modulo one modulus so that later exponentiations of that base
+ *    need only multiplications
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef FIXEDBASEPOW_H
+#define FIXEDBASEPOW_H
+
+#include "InfiniteInt.h" // Type of the base, modulus and powers
+#include <stdexcept>     // std::invalid_argument and std::out_of_range
+#include <vector>        // The precomputed table
+
+class FixedBasePow {
+public:
+   //PUBLIC METHODS
+   /** FixedBasePow(const InfiniteInt&, const InfiniteInt&, int)
+    * @brief   Constructor. Builds the table base^(d * 10^j) mod modulus for every
+    *          nonzero decimal digit d and every digit position j below
+    *          maxExponentDigits.
+    * @param   base                 The base every later exponentiation uses
+    * @param   modulus              The modulus every result is reduced by
+    * @param   maxExponentDigits    The most digits any later exponent may have
+    * @pre     modulus is positive and maxExponentDigits is at least 1.
+    * @post    The table holds 9 * maxExponentDigits powers.
+    * @throw   std::invalid_argument if the preconditions are not met.
+   */
+   FixedBasePow(const InfiniteInt& base, const InfiniteInt& modulus, int maxExponentDigits);
+
+   /** pow(const InfiniteInt&)
+    * @brief   Returns base^exponent mod modulus. Each nonzero digit of the
+    *          exponent selects one table entry, so the result costs one modular
+    *          multiplication per nonzero digit and no squarings.
+    * @param   exponent    The power to raise the base to
+    * @pre     exponent is not negative and has at most maxExponentDigits() digits.
+    * @post    The returned value is between 0 and modulus - 1.
+    * @return  InfiniteInt representing base^exponent mod modulus.
+    * @throw   std::invalid_argument if exponent is negative.
+    * @throw   std::out_of_range if exponent has too many digits.
+   */
+   InfiniteInt pow(const InfiniteInt& exponent) const;
+
+   /** maxExponentDigits()
+    * @brief   Returns the most digits an exponent passed to pow() may have.
+   */
+   int maxExponentDigits() const;
+
+   /** modulus()
+    * @brief   Returns the modulus results are reduced by.
+   */
+   const InfiniteInt& modulus() const;
+
+private:
+   // DATA MEMBERS
+   InfiniteInt modulus_;             // modulus every result is reduced by
+   int maxExponentDigits_;           // number of digit positions in table_
+   std::vector<InfiniteInt> table_;  // base^(d * 10^j) mod modulus at index 9 * j + (d - 1)
+};
+
+#endif // FIXEDBASEPOW_H
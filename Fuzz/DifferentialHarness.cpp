@@ -0,0 +1,466 @@
+/** 
+ * @file DifferentialHarness.cpp
+ * @brief Differential checks that compare InfiniteInt kernels against reference
+ *    results, shared by the randomized test driver and the libFuzzer entry point
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "DifferentialHarness.h"
+#include "../Divisor.h"  // Precomputed divisors
+#include "../InfiniteIntVector.h"  // Arena-backed views
+#include "../NumberTheory.h"  // Batched modular exponentiation
+#include <algorithm> // std::sort, std::unique, std::reverse
+#include <sstream>   // Conversion through operator<< and operator>>
+
+// MAGNITUDE HELPERS - unsigned decimal text, highest digit first
+
+/** compareMagnitudes(const std::string&, const std::string&)
+ * @return  Negative, zero or positive as |lhs| is less than, equal to or greater than |rhs|.
+*/
+static int compareMagnitudes(const std::string& lhs, const std::string& rhs) {
+   if (lhs.size() != rhs.size()) {
+      return lhs.size() < rhs.size() ? -1 : 1;
+   }
+   return lhs.compare(rhs);
+}
+
+/** addMagnitudes(const std::string&, const std::string&)
+ * @return  Text of |lhs| + |rhs|.
+*/
+static std::string addMagnitudes(const std::string& lhs, const std::string& rhs) {
+   std::string result;
+   int carry{0};
+   for (std::size_t i = 0; i < lhs.size() || i < rhs.size() || carry != 0; ++i) {
+      int sum = carry;
+      if (i < lhs.size()) {
+         sum += lhs[lhs.size() - 1 - i] - '0';
+      }
+      if (i < rhs.size()) {
+         sum += rhs[rhs.size() - 1 - i] - '0';
+      }
+      result.push_back(static_cast<char>('0' + sum % 10));
+      carry = sum / 10;
+   }
+   std::reverse(result.begin(), result.end());
+   return result;
+}
+
+/** subtractMagnitudes(const std::string&, const std::string&)
+ * @pre     |larger| >= |smaller|.
+ * @return  Text of |larger| - |smaller|, possibly with leading zeros.
+*/
+static std::string subtractMagnitudes(const std::string& larger, const std::string& smaller) {
+   std::string result;
+   int borrow{0};
+   for (std::size_t i = 0; i < larger.size(); ++i) {
+      int diff = (larger[larger.size() - 1 - i] - '0') - borrow;
+      if (i < smaller.size()) {
+         diff -= smaller[smaller.size() - 1 - i] - '0';
+      }
+      borrow = diff < 0 ? 1 : 0;
+      result.push_back(static_cast<char>('0' + diff + 10 * borrow));
+   }
+   std::reverse(result.begin(), result.end());
+   return result;
+}
+
+/** splitSign(const std::string&, bool&)
+ * @return  The digits of text, with isNegative set from its sign.
+*/
+static std::string splitSign(const std::string& text, bool& isNegative) {
+   isNegative = !text.empty() && text[0] == '-';
+   return isNegative ? text.substr(1) : text;
+}
+
+// REFERENCE ARITHMETIC
+
+/** normalizeDecimal(const std::string&)
+ * @brief   Strips leading zeros and the sign of zero from decimal text.
+ * @param   text     "[-]digits" with at least one digit
+ * @return  The canonical text of the same number.
+*/
+std::string normalizeDecimal(const std::string& text) {
+   bool isNegative;
+   std::string digits = splitSign(text, isNegative);
+   std::size_t firstNonZero = digits.find_first_not_of('0');
+   if (firstNonZero == std::string::npos) {
+      return "0";
+   }
+   return (isNegative ? "-" : "") + digits.substr(firstNonZero);
+}
+
+/** referenceAdd(const std::string&, const std::string&)
+ * @return  Decimal text of lhs + rhs.
+*/
+std::string referenceAdd(const std::string& lhs, const std::string& rhs) {
+   bool lhsNegative;
+   bool rhsNegative;
+   std::string lhsDigits = splitSign(lhs, lhsNegative);
+   std::string rhsDigits = splitSign(rhs, rhsNegative);
+
+   if (lhsNegative == rhsNegative) {
+      return normalizeDecimal((lhsNegative ? "-" : "") + addMagnitudes(lhsDigits, rhsDigits));
+   }
+
+   // Different signs - the result takes the sign of the larger magnitude
+   if (compareMagnitudes(lhsDigits, rhsDigits) >= 0) {
+      return normalizeDecimal((lhsNegative ? "-" : "") + subtractMagnitudes(lhsDigits, rhsDigits));
+   }
+   return normalizeDecimal((rhsNegative ? "-" : "") + subtractMagnitudes(rhsDigits, lhsDigits));
+}
+
+/** referenceSubtract(const std::string&, const std::string&)
+ * @return  Decimal text of lhs - rhs.
+*/
+std::string referenceSubtract(const std::string& lhs, const std::string& rhs) {
+   std::string negatedRhs = rhs[0] == '-' ? rhs.substr(1) : "-" + rhs;
+   return referenceAdd(lhs, normalizeDecimal(negatedRhs));
+}
+
+/** referenceMultiply(const std::string&, const std::string&)
+ * @return  Decimal text of lhs * rhs.
+*/
+std::string referenceMultiply(const std::string& lhs, const std::string& rhs) {
+   bool lhsNegative;
+   bool rhsNegative;
+   std::string lhsDigits = splitSign(lhs, lhsNegative);
+   std::string rhsDigits = splitSign(rhs, rhsNegative);
+
+   // Column sums, lowest column first, carried at the end
+   std::vector<long long> columns(lhsDigits.size() + rhsDigits.size(), 0);
+   for (std::size_t i = 0; i < lhsDigits.size(); ++i) {
+      for (std::size_t j = 0; j < rhsDigits.size(); ++j) {
+         columns[i + j] += (lhsDigits[lhsDigits.size() - 1 - i] - '0') *
+                           (rhsDigits[rhsDigits.size() - 1 - j] - '0');
+      }
+   }
+   std::string result;
+   long long carry{0};
+   for (long long column : columns) {
+      long long total = column + carry;
+      result.push_back(static_cast<char>('0' + total % 10));
+      carry = total / 10;
+   }
+   for (; carry != 0; carry /= 10) {
+      result.push_back(static_cast<char>('0' + carry % 10));
+   }
+   std::reverse(result.begin(), result.end());
+   return normalizeDecimal((lhsNegative != rhsNegative ? "-" : "") + result);
+}
+
+/** referenceDivide(const std::string&, const std::string&, std::string&, std::string&)
+ * @brief   Truncating division: quotient rounds toward zero and remainder takes
+ *          the sign of lhs.
+ * @pre     rhs is not zero.
+*/
+void referenceDivide(const std::string& lhs, const std::string& rhs,
+                     std::string& quotient, std::string& remainder) {
+   bool lhsNegative;
+   bool rhsNegative;
+   std::string lhsDigits = splitSign(lhs, lhsNegative);
+   std::string rhsDigits = splitSign(rhs, rhsNegative);
+
+   // Schoolbook long division by repeated subtraction, one digit at a time
+   std::string quotientDigits;
+   std::string current = "0";
+   for (char digit : lhsDigits) {
+      current = normalizeDecimal(current + digit);
+      int count{0};
+      while (compareMagnitudes(current, rhsDigits) >= 0) {
+         current = normalizeDecimal(subtractMagnitudes(current, rhsDigits));
+         ++count;
+      }
+      quotientDigits.push_back(static_cast<char>('0' + count));
+   }
+   quotient = normalizeDecimal((lhsNegative != rhsNegative ? "-" : "") + quotientDigits);
+   remainder = normalizeDecimal((lhsNegative ? "-" : "") + current);
+}
+
+/** referenceCompare(const std::string&, const std::string&)
+ * @return  Negative, zero or positive as lhs is less than, equal to or greater than rhs.
+*/
+int referenceCompare(const std::string& lhs, const std::string& rhs) {
+   bool lhsNegative;
+   bool rhsNegative;
+   std::string lhsDigits = splitSign(lhs, lhsNegative);
+   std::string rhsDigits = splitSign(rhs, rhsNegative);
+   if (lhsNegative != rhsNegative) {
+      return lhsNegative ? -1 : 1;
+   }
+   int magnitudeOrder = compareMagnitudes(lhsDigits, rhsDigits);
+   return lhsNegative ? -magnitudeOrder : magnitudeOrder;
+}
+
+/** toDecimal(const InfiniteInt&)
+ * @brief   Returns the decimal text operator<< produces for an InfiniteInt.
+*/
+std::string toDecimal(const InfiniteInt& value) {
+   std::ostringstream text;
+   text << value;
+   return text.str();
+}
+
+/** fromDecimal(const std::string&)
+ * @brief   Parses decimal text with operator>>.
+*/
+InfiniteInt fromDecimal(const std::string& text) {
+   std::istringstream stream(text);
+   InfiniteInt value;
+   stream >> value;
+   return value;
+}
+
+// KERNEL CHECKS
+
+/** mismatch(const char*, const std::string&, const std::string&)
+ * @return  Empty if expected and actual match, otherwise a description.
+*/
+static std::string mismatch(const char* what, const std::string& expected, const std::string& actual) {
+   if (expected == actual) {
+      return "";
+   }
+   return std::string(what) + ": expected " + expected + ", got " + actual;
+}
+
+static std::string checkAdd(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                            const std::string& lhsText, const std::string& rhsText) {
+   return mismatch("lhs + rhs", referenceAdd(lhsText, rhsText), toDecimal(lhs + rhs));
+}
+
+static std::string checkSubtract(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                                 const std::string& lhsText, const std::string& rhsText) {
+   return mismatch("lhs - rhs", referenceSubtract(lhsText, rhsText), toDecimal(lhs - rhs));
+}
+
+static std::string checkMultiply(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                                 const std::string& lhsText, const std::string& rhsText) {
+   return mismatch("lhs * rhs", referenceMultiply(lhsText, rhsText), toDecimal(lhs * rhs));
+}
+
+static std::string checkDivide(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                               const std::string& lhsText, const std::string& rhsText) {
+   if (rhsText == "0") {
+      return "";
+   }
+   std::string quotient;
+   std::string remainder;
+   referenceDivide(lhsText, rhsText, quotient, remainder);
+   return mismatch("lhs / rhs", quotient, toDecimal(lhs / rhs)) +
+          mismatch("lhs % rhs", remainder, toDecimal(lhs % rhs));
+}
+
+static std::string checkDivisor(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                                const std::string& lhsText, const std::string& rhsText) {
+   if (rhsText == "0") {
+      return "";
+   }
+   std::string quotient;
+   std::string remainder;
+   referenceDivide(lhsText, rhsText, quotient, remainder);
+   Divisor divisor(rhs);
+   return mismatch("lhs / Divisor(rhs)", quotient, toDecimal(lhs / divisor)) +
+          mismatch("lhs % Divisor(rhs)", remainder, toDecimal(lhs % divisor));
+}
+
+static std::string checkDivExact(const InfiniteInt&, const InfiniteInt& rhs,
+                                 const std::string& lhsText, const std::string& rhsText) {
+   if (rhsText == "0") {
+      return "";
+   }
+   InfiniteInt product = fromDecimal(referenceMultiply(lhsText, rhsText));
+   return mismatch("(lhs * rhs).divExact(rhs)", lhsText, toDecimal(product.divExact(rhs)));
+}
+
+static std::string checkPowmodBatch(const InfiniteInt& lhs, const InfiniteInt&,
+                                    const std::string& lhsText, const std::string& rhsText) {
+   // Modulus |rhs|, made odd so that the Montgomery path is taken
+   bool isNegative;
+   std::string modulusText = splitSign(rhsText, isNegative);
+   if ((modulusText.back() - '0') % 2 == 0) {
+      modulusText = referenceAdd(modulusText, "1");
+   }
+   int exponent = static_cast<int>(lhsText.size() % 7);   // vary the exponent with the operand
+
+   std::string expected = "1";
+   std::string quotient;
+   for (int i = 0; i <= exponent; ++i) {
+      referenceDivide(i == 0 ? expected : referenceMultiply(expected, lhsText), modulusText, quotient, expected);
+   }
+   if (expected[0] == '-') {
+      expected = referenceAdd(expected, modulusText);
+   }
+   std::vector<InfiniteInt> results = powmodBatch({ lhs }, { InfiniteInt(exponent) }, fromDecimal(modulusText), 1);
+   return mismatch("powmodBatch(lhs, k, odd |rhs|)", expected, toDecimal(results[0]));
+}
+
+static std::string checkCompare(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                                const std::string& lhsText, const std::string& rhsText) {
+   int order = referenceCompare(lhsText, rhsText);
+   std::string failures = mismatch("lhs < rhs", order < 0 ? "true" : "false", (lhs < rhs) ? "true" : "false");
+   failures += mismatch("lhs == rhs", order == 0 ? "true" : "false", (lhs == rhs) ? "true" : "false");
+   return failures;
+}
+
+static std::string checkParsePrint(const InfiniteInt& lhs, const InfiniteInt&,
+                                   const std::string& lhsText, const std::string&) {
+   return mismatch("print(parse(lhs))", lhsText, toDecimal(lhs));
+}
+
+static std::string checkShifts(const InfiniteInt& lhs, const InfiniteInt&,
+                               const std::string& lhsText, const std::string& rhsText) {
+   int places = static_cast<int>(rhsText.size() % 23);   // vary the shift with the other operand
+   std::string shiftedLeft = lhsText == "0" ? "0" : lhsText + std::string(places, '0');
+   std::string shiftedRight = "0";
+   bool isNegative;
+   std::string digits = splitSign(lhsText, isNegative);
+   if (static_cast<int>(digits.size()) > places) {
+      shiftedRight = (isNegative ? "-" : "") + digits.substr(0, digits.size() - places);
+   }
+   return mismatch("lhs.shiftLeft(k)", shiftedLeft, toDecimal(lhs.shiftLeft(places))) +
+          mismatch("lhs.shiftRight(k)", normalizeDecimal(shiftedRight), toDecimal(lhs.shiftRight(places)));
+}
+
+static std::string checkVectorViews(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                                    const std::string& lhsText, const std::string& rhsText) {
+   InfiniteIntVector values(std::vector<InfiniteInt>{ lhs, rhs });
+   InfiniteIntVector::View lhsView = values[0];
+   InfiniteIntVector::View rhsView = values[1];
+   int order = referenceCompare(lhsText, rhsText);
+   return mismatch("view text", lhsText, lhsView.toString()) +
+          mismatch("view round trip", rhsText, toDecimal(values.get(1))) +
+          mismatch("view < view", order < 0 ? "true" : "false", (lhsView < rhsView) ? "true" : "false") +
+          mismatch("view == view", order == 0 ? "true" : "false", (lhsView == rhsView) ? "true" : "false") +
+          mismatch("view + view", referenceAdd(lhsText, rhsText), toDecimal(lhsView + rhsView)) +
+          mismatch("view - view", referenceSubtract(lhsText, rhsText), toDecimal(lhsView - rhsView)) +
+          mismatch("view * view", referenceMultiply(lhsText, rhsText), toDecimal(lhsView * rhsView));
+}
+
+/** differentialChecks()
+ * @brief   Returns every registered kernel check.
+ * @return  The checks, in the order they are run.
+*/
+const std::vector<DifferentialCheck>& differentialChecks() {
+   static const std::vector<DifferentialCheck> checks = {
+      { "parse/print", checkParsePrint },
+      { "compare", checkCompare },
+      { "operator+", checkAdd },
+      { "operator-", checkSubtract },
+      { "operator*", checkMultiply },
+      { "operator/ and operator%", checkDivide },
+      { "divExact", checkDivExact },
+      { "Divisor", checkDivisor },
+      { "powmodBatch", checkPowmodBatch },
+      { "decimal shifts", checkShifts },
+      { "InfiniteIntVector views", checkVectorViews },
+   };
+   return checks;
+}
+
+/** runDifferentialChecks(const std::string&, const std::string&)
+ * @brief   Runs every registered check on one pair of operands.
+ * @param   lhsText  Decimal text of the first operand
+ * @param   rhsText  Decimal text of the second operand
+ * @post    The returned list describes every check that disagreed.
+ * @return  Failure descriptions, or an empty list if every kernel agreed.
+*/
+std::vector<std::string> runDifferentialChecks(const std::string& lhsText, const std::string& rhsText) {
+   std::vector<std::string> failures;
+   InfiniteInt lhs = fromDecimal(lhsText);
+   InfiniteInt rhs = fromDecimal(rhsText);
+   for (const DifferentialCheck& check : differentialChecks()) {
+      std::string failure = check.check_(lhs, rhs, lhsText, rhsText);
+      if (!failure.empty()) {
+         failures.push_back(std::string(check.name_) + " with lhs = " + lhsText +
+                            ", rhs = " + rhsText + ": " + failure);
+      }
+   }
+   return failures;
+}
+
+// OPERAND GENERATION
+
+/** thresholdSizes(int)
+ * @brief   Returns operand digit counts worth testing: small sizes, powers of
+ *          two and their neighbours, and every kernel's switch-over sizes +/- 1.
+ * @param   maxDigits   The largest digit count to return
+ * @return  Digit counts between 1 and maxDigits.
+*/
+std::vector<int> thresholdSizes(int maxDigits) {
+   std::vector<int> sizes;
+   for (int size = 1; size <= 10; ++size) {
+      sizes.push_back(size);
+   }
+   for (int power = 16; power <= maxDigits + 1; power *= 2) {
+      sizes.push_back(power - 1);
+      sizes.push_back(power);
+      sizes.push_back(power + 1);
+   }
+
+   // Kernel switch-over sizes go here as fast paths are added
+   const int kernelThresholds[] = {
+      10,   // Divisor: word arithmetic up to SMALL_DIVISOR_LIMIT = 10^9 (10 digits)
+   };
+   for (int threshold : kernelThresholds) {
+      if (threshold > 0) {
+         sizes.push_back(threshold - 1);
+         sizes.push_back(threshold);
+         sizes.push_back(threshold + 1);
+      }
+   }
+
+   // Keep sizes in range, sorted and unique
+   sizes.erase(std::remove_if(sizes.begin(), sizes.end(),
+                              [maxDigits](int size) { return size < 1 || size > maxDigits; }),
+               sizes.end());
+   std::sort(sizes.begin(), sizes.end());
+   sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+   return sizes;
+}
+
+/** makeOperand(std::mt19937&, int)
+ * @brief   Builds an operand with the given number of digits, either random or
+ *          one of the adversarial shapes (all 9s, a power of ten, a power of ten
+ *          minus one, alternating digits, a single nonzero top digit), with a
+ *          random sign.
+ * @param   rng         Random number source
+ * @param   numDigits   The number of digits in the operand
+ * @return  Decimal text of the operand.
+*/
+std::string makeOperand(std::mt19937& rng, int numDigits) {
+   std::uniform_int_distribution<int> shapeDist(0, 7);
+   std::uniform_int_distribution<int> digitDist(0, 9);
+   std::string digits;
+
+   switch (shapeDist(rng)) {
+   case 0:  // all 9s
+      digits.assign(numDigits, '9');
+      break;
+   case 1:  // power of ten
+      digits = "1" + std::string(numDigits - 1, '0');
+      break;
+   case 2:  // alternating 9s and 0s
+      for (int i = 0; i < numDigits; ++i) {
+         digits.push_back(i % 2 == 0 ? '9' : '0');
+      }
+      break;
+   case 3:  // alternating 1s and 0s
+      for (int i = 0; i < numDigits; ++i) {
+         digits.push_back(i % 2 == 0 ? '1' : '0');
+      }
+      break;
+   case 4:  // one nonzero digit on top of zeros, then a trailing 1
+      digits = std::string(1, static_cast<char>('1' + digitDist(rng) % 9)) + std::string(numDigits - 1, '0');
+      if (numDigits > 1) {
+         digits[numDigits - 1] = '1';
+      }
+      break;
+   default: // random digits
+      for (int i = 0; i < numDigits; ++i) {
+         digits.push_back(static_cast<char>('0' + digitDist(rng)));
+      }
+      break;
+   }
+
+   bool isNegative = digitDist(rng) < 5;
+   return normalizeDecimal((isNegative ? "-" : "") + digits);
+}
@@ -0,0 +1,113 @@
+/** 
+ * @file DifferentialHarness.h
+ * @brief Differential checks that compare InfiniteInt kernels against reference
+ *    results, shared by the randomized test driver and the libFuzzer entry point
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef DIFFERENTIALHARNESS_H
+#define DIFFERENTIALHARNESS_H
+
+#include "../InfiniteInt.h" // Kernels being checked
+#include <random>           // Operand generation
+#include <string>           // Decimal text of operands and results
+#include <vector>           // Failure lists and size lists
+
+/* Operands are passed around as decimal text ("[-]digits", no leading zeros)
+   so failures can be printed and replayed. Every check receives both the
+   parsed InfiniteInts and their text. */
+
+/** DifferentialCheck
+ * @brief   One kernel compared against its reference.
+*/
+struct DifferentialCheck {
+   const char* name_;   // shown in failure reports
+   /** Returns an empty string if the kernel agrees with its reference on
+       (lhs, rhs), or a description of the disagreement otherwise. */
+   std::string (*check_)(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                         const std::string& lhsText, const std::string& rhsText);
+};
+
+/** differentialChecks()
+ * @brief   Returns every registered kernel check.
+ * @return  The checks, in the order they are run.
+*/
+const std::vector<DifferentialCheck>& differentialChecks();
+
+/** runDifferentialChecks(const std::string&, const std::string&)
+ * @brief   Runs every registered check on one pair of operands.
+ * @param   lhsText  Decimal text of the first operand
+ * @param   rhsText  Decimal text of the second operand
+ * @post    The returned list describes every check that disagreed.
+ * @return  Failure descriptions, or an empty list if every kernel agreed.
+*/
+std::vector<std::string> runDifferentialChecks(const std::string& lhsText, const std::string& rhsText);
+
+/** thresholdSizes(int)
+ * @brief   Returns operand digit counts worth testing: small sizes, powers of
+ *          two and their neighbours, and every kernel's switch-over sizes +/- 1.
+ * @param   maxDigits   The largest digit count to return
+ * @return  Digit counts between 1 and maxDigits.
+*/
+std::vector<int> thresholdSizes(int maxDigits);
+
+/** makeOperand(std::mt19937&, int)
+ * @brief   Builds an operand with the given number of digits, either random or
+ *          one of the adversarial shapes (all 9s, a power of ten, a power of ten
+ *          minus one, alternating digits, a single nonzero top digit), with a
+ *          random sign.
+ * @param   rng         Random number source
+ * @param   numDigits   The number of digits in the operand
+ * @return  Decimal text of the operand.
+*/
+std::string makeOperand(std::mt19937& rng, int numDigits);
+
+/** normalizeDecimal(const std::string&)
+ * @brief   Strips leading zeros and the sign of zero from decimal text.
+ * @param   text     "[-]digits" with at least one digit
+ * @return  The canonical text of the same number.
+*/
+std::string normalizeDecimal(const std::string& text);
+
+/** toDecimal(const InfiniteInt&)
+ * @brief   Returns the decimal text operator<< produces for an InfiniteInt.
+*/
+std::string toDecimal(const InfiniteInt& value);
+
+/** fromDecimal(const std::string&)
+ * @brief   Parses decimal text with operator>>.
+*/
+InfiniteInt fromDecimal(const std::string& text);
+
+// SCHOOLBOOK REFERENCE - independent of InfiniteInt, on decimal text
+
+/** referenceAdd(const std::string&, const std::string&)
+ * @return  Decimal text of lhs + rhs.
+*/
+std::string referenceAdd(const std::string& lhs, const std::string& rhs);
+
+/** referenceSubtract(const std::string&, const std::string&)
+ * @return  Decimal text of lhs - rhs.
+*/
+std::string referenceSubtract(const std::string& lhs, const std::string& rhs);
+
+/** referenceMultiply(const std::string&, const std::string&)
+ * @return  Decimal text of lhs * rhs.
+*/
+std::string referenceMultiply(const std::string& lhs, const std::string& rhs);
+
+/** referenceDivide(const std::string&, const std::string&, std::string&, std::string&)
+ * @brief   Truncating division: quotient rounds toward zero and remainder takes
+ *          the sign of lhs.
+ * @pre     rhs is not zero.
+*/
+void referenceDivide(const std::string& lhs, const std::string& rhs,
+                     std::string& quotient, std::string& remainder);
+
+/** referenceCompare(const std::string&, const std::string&)
+ * @return  Negative, zero or positive as lhs is less than, equal to or greater than rhs.
+*/
+int referenceCompare(const std::string& lhs, const std::string& rhs);
+
+#endif // DIFFERENTIALHARNESS_H
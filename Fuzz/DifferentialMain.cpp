@@ -0,0 +1,42 @@
+/** 
+ * @file DifferentialMain.cpp
+ * @brief Randomized differential test driver: runs every kernel check on
+ *    operands sized around kernel thresholds and built from adversarial shapes.
+ *
+ *    Usage: DifferentialTest [iterations] [seed] [maxDigits]
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "DifferentialHarness.h" // Kernel checks and operand generation
+#include <cstdlib>               // std::atoi
+#include <iostream>              // Reports
+
+int main(int argc, char* argv[]) {
+   int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+   unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1u;
+   int maxDigits = argc > 3 ? std::atoi(argv[3]) : 130;
+
+   std::mt19937 rng(seed);
+   std::vector<int> sizes = thresholdSizes(maxDigits);
+   std::uniform_int_distribution<std::size_t> sizeDist(0, sizes.size() - 1);
+   std::uniform_int_distribution<int> anySizeDist(1, maxDigits);
+
+   int numFailures{0};
+   for (int i = 0; i < iterations; ++i) {
+      // Mostly threshold-edge sizes, sometimes any size
+      int lhsDigits = (i % 4 == 3) ? anySizeDist(rng) : sizes[sizeDist(rng)];
+      int rhsDigits = (i % 4 == 2) ? anySizeDist(rng) : sizes[sizeDist(rng)];
+      std::string lhs = makeOperand(rng, lhsDigits);
+      std::string rhs = makeOperand(rng, rhsDigits);
+
+      for (const std::string& failure : runDifferentialChecks(lhs, rhs)) {
+         std::cerr << "FAILED (iteration " << i << ", seed " << seed << "): " << failure << '\n';
+         ++numFailures;
+      }
+   }
+
+   std::cout << iterations << " operand pairs, " << differentialChecks().size() << " kernel checks, "
+             << numFailures << " failures\n";
+   return numFailures == 0 ? 0 : 1;
+}
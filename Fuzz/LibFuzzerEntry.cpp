@@ -0,0 +1,53 @@
+/** 
+ * @file LibFuzzerEntry.cpp
+ * @brief libFuzzer entry point: turns fuzzer bytes into two operands and runs
+ *    every differential kernel check on them, aborting on any disagreement.
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "DifferentialHarness.h" // Kernel checks
+#include <cstddef>               // std::size_t
+#include <cstdint>               // std::uint8_t
+#include <cstdlib>               // std::abort
+#include <iostream>              // Failure reports
+
+static const std::size_t MAX_OPERAND_DIGITS = 400;  // keeps each run fast enough to explore
+
+/** bytesToOperand(const std::uint8_t*, std::size_t, bool)
+ * @return  Decimal text whose digits are the given bytes modulo 10.
+*/
+static std::string bytesToOperand(const std::uint8_t* data, std::size_t size, bool isNegative) {
+   std::string digits;
+   for (std::size_t i = 0; i < size && i < MAX_OPERAND_DIGITS; ++i) {
+      digits.push_back(static_cast<char>('0' + data[i] % 10));
+   }
+   if (digits.empty()) {
+      digits = "0";
+   }
+   return normalizeDecimal((isNegative ? "-" : "") + digits);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+   if (size < 2) {
+      return 0;
+   }
+
+   // Byte 0 holds the signs and where to split the rest into two operands
+   std::uint8_t control = data[0];
+   const std::uint8_t* rest = data + 1;
+   std::size_t restSize = size - 1;
+   std::size_t split = restSize == 0 ? 0 : (control >> 2) % (restSize + 1);
+
+   std::string lhs = bytesToOperand(rest, split, (control & 1) != 0);
+   std::string rhs = bytesToOperand(rest + split, restSize - split, (control & 2) != 0);
+
+   std::vector<std::string> failures = runDifferentialChecks(lhs, rhs);
+   if (!failures.empty()) {
+      for (const std::string& failure : failures) {
+         std::cerr << failure << '\n';
+      }
+      std::abort();
+   }
+   return 0;
+}
@@ -7,6 +7,8 @@
 */
 
 #include "InfiniteInt.h"
+#include <algorithm>  // std::min
+#include <utility>    // std::move
 
 /** InfiniteInt()
  * @brief   Default constructor.
@@ -48,6 +50,33 @@ InfiniteInt::InfiniteInt(int num) {
    } while (num != 0);
 }
 
+/** InfiniteInt(const InfiniteInt&)
+ * @brief   Copy constructor.
+ * @param   toCopy   The InfiniteInt being copied
+ * @post    This InfiniteInt has the same sign and digits as toCopy. Its
+ *          decimal text has not been cached yet.
+*/
+InfiniteInt::InfiniteInt(const InfiniteInt& toCopy)
+   : digits_(toCopy.digits_), isNegative_(toCopy.isNegative_) {
+   // The cache is not shared - copies are often changed in place by the arithmetic helpers
+}
+
+/** operator=(const InfiniteInt&)
+ * @brief   Assignment operator.
+ * @param   rhs   The InfiniteInt being copied
+ * @post    This InfiniteInt has the same sign and digits as rhs. Its decimal
+ *          text has not been cached yet.
+ * @return  Reference to this InfiniteInt.
+*/
+InfiniteInt& InfiniteInt::operator=(const InfiniteInt& rhs) {
+   if (this != &rhs) {
+      digits_ = rhs.digits_;
+      isNegative_ = rhs.isNegative_;
+      invalidateDecimal();
+   }
+   return *this;
+}
+
 /** operator int()
  * @brief   Conversion operator. Returns the number represented by this
  *          InfiniteInt as an integer.
@@ -93,6 +122,18 @@ int InfiniteInt::numDigits() const {
    return digits_.numEntries();
 }
 
+/** toString()
+ * @brief   Returns the decimal text of the number represented by this
+ *          InfiniteInt, as printed by operator<<. The text is built on the
+ *          first call and cached; later calls, and operator<<, reuse it.
+ *          Safe to call from several threads at once.
+ * @post    The decimal text of this InfiniteInt is cached.
+ * @return  The decimal text, with a leading '-' if negative.
+*/
+std::string InfiniteInt::toString() const {
+   return *decimalText();
+}
+
 /** operator+(const InfiniteInt&)
  * @brief   Adds the number represented by this InfiniteInt to that represented
  *          by another and returns the result as an InfiniteInt.
@@ -193,6 +234,229 @@ InfiniteInt InfiniteInt::operator*(const InfiniteInt& rhs) const {
    return result;
 }
 
+/** operator/(const InfiniteInt&)
+ * @brief   Divides the number represented by this InfiniteInt by that represented
+ *          by another and returns the quotient as an InfiniteInt.
+ * @param   rhs   The InfiniteInt to divide this one by
+ * @pre     rhs is not zero.
+ * @post    The returned InfiniteInt represents the quotient of this InfiniteInt's
+ *          number and rhs's, truncated toward zero.
+ * @return  InfiniteInt representing the quotient of this InfiniteInt's number and rhs's.
+ * @throw   std::domain_error if rhs is zero.
+*/
+InfiniteInt InfiniteInt::operator/(const InfiniteInt& rhs) const {
+   if (rhs.digits_.front() == 0) {
+      throw std::domain_error("InfiniteInt division by zero.");
+   }
+
+   InfiniteInt quotient;   // The quotient of the absolute values
+   InfiniteInt remainder;  // The remainder of the absolute values
+   divide(*this, rhs, quotient, remainder);
+
+   // The quotient is negative when the signs differ, unless it is zero
+   if (quotient.digits_.front() != 0) {
+      quotient.isNegative_ = isNegative_ != rhs.isNegative_;
+   }
+   return quotient;
+}
+
+/** operator%(const InfiniteInt&)
+ * @brief   Divides the number represented by this InfiniteInt by that represented
+ *          by another and returns the remainder as an InfiniteInt.
+ * @param   rhs   The InfiniteInt to divide this one by
+ * @pre     rhs is not zero.
+ * @post    The returned InfiniteInt represents this number minus rhs times
+ *          (*this / rhs). It is zero or has the same sign as this InfiniteInt.
+ * @return  InfiniteInt representing the remainder of this InfiniteInt's number and rhs's.
+ * @throw   std::domain_error if rhs is zero.
+*/
+InfiniteInt InfiniteInt::operator%(const InfiniteInt& rhs) const {
+   if (rhs.digits_.front() == 0) {
+      throw std::domain_error("InfiniteInt division by zero.");
+   }
+
+   InfiniteInt quotient;   // The quotient of the absolute values
+   InfiniteInt remainder;  // The remainder of the absolute values
+   divide(*this, rhs, quotient, remainder);
+
+   // The remainder takes the sign of the dividend, unless it is zero
+   if (remainder.digits_.front() != 0) {
+      remainder.isNegative_ = isNegative_;
+   }
+   return remainder;
+}
+
+/** divide(const InfiniteInt&, const InfiniteInt&, InfiniteInt&, InfiniteInt&)
+ * @brief   Helper method for division. Ignores the sign of both InfiniteInts.
+ * @param   lhs         The InfiniteInt being divided
+ * @param   rhs         The InfiniteInt lhs is divided by
+ * @param   quotient    Set to the quotient of the absolute values
+ * @param   remainder   Set to the remainder of the absolute values
+ * @pre     rhs is not zero.
+ * @post    |lhs| = quotient * |rhs| + remainder, with 0 <= remainder < |rhs|.
+ *          Both results are positive.
+*/
+void InfiniteInt::divide(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                         InfiniteInt& quotient, InfiniteInt& remainder) {
+   InfiniteInt divisor(rhs);  // |rhs|
+   divisor.isNegative_ = false;
+
+   // Fewer digits than the divisor - nothing to divide
+   if (lhs.numDigits() < divisor.numDigits()) {
+      remainder = lhs;
+      remainder.isNegative_ = false;
+      quotient = InfiniteInt();
+      return;
+   }
+
+   // Multiples of the divisor, so each quotient digit costs one search and one subtraction
+   std::vector<InfiniteInt> multiples(10);
+   for (int i = 1; i < 10; ++i) {
+      multiples[i] = divisor.add(multiples[i - 1], divisor);
+   }
+
+   // Long division - bring down one digit of lhs at a time, highest first
+   std::vector<int> quotientDigits;  // digits of the quotient, highest first
+   quotientDigits.reserve(lhs.numDigits());
+   remainder = InfiniteInt();
+   for (auto lhsCur = lhs.digits_.begin(); lhsCur != lhs.digits_.end(); ++lhsCur) {
+      // remainder = remainder * 10 + digit
+      if (remainder.digits_.front() == 0) {
+         remainder.digits_.popFront();
+      }
+      remainder.digits_.pushBack(*lhsCur);
+
+      // Find the largest multiple that fits
+      int low{0};
+      int high{9};
+      while (low < high) {
+         int mid = (low + high + 1) / 2;
+         if (remainder < multiples[mid]) {
+            high = mid - 1;
+         } else {
+            low = mid;
+         }
+      }
+      if (low > 0) {
+         remainder = remainder.subtract(remainder, multiples[low]);
+      }
+      quotientDigits.push_back(low);
+   }
+
+   quotient.digits_.assign(quotientDigits.begin(), quotientDigits.end());
+   quotient.isNegative_ = false;
+   quotient.removeLeadingZeroes();
+   quotient.invalidateDecimal();
+   remainder.invalidateDecimal();
+}
+
+/** divExact(const InfiniteInt&)
+ * @brief   Divides the number represented by this InfiniteInt by that represented
+ *          by another that is known to divide it exactly. The quotient is built
+ *          from its lowest digit up (Hensel division, 10-adic): each step
+ *          reads one low digit and needs no trial quotients, comparisons or
+ *          remainder correction, and only the low digits that the quotient
+ *          can reach are ever touched.
+ * @param   rhs   The InfiniteInt to divide this one by
+ * @pre     rhs is not zero and divides this InfiniteInt exactly.
+ * @post    The returned InfiniteInt represents this number divided by rhs. If
+ *          rhs does not divide this number exactly, the result is unspecified.
+ * @return  InfiniteInt representing the quotient of this InfiniteInt's number and rhs's.
+ * @throw   std::domain_error if rhs is zero.
+*/
+InfiniteInt InfiniteInt::divExact(const InfiniteInt& rhs) const {
+   if (rhs.digits_.front() == 0) {
+      throw std::domain_error("InfiniteInt division by zero.");
+   }
+   if (digits_.front() == 0) {
+      return InfiniteInt();
+   }
+
+   // Digits of both magnitudes, lowest first
+   std::vector<int> dividend;
+   std::vector<int> divisor;
+   for (auto cur = digits_.last(); cur != digits_.end(); --cur) {
+      dividend.push_back(*cur);
+   }
+   for (auto cur = rhs.digits_.last(); cur != rhs.digits_.end(); --cur) {
+      divisor.push_back(*cur);
+   }
+
+   // Hensel division needs the divisor's low digit to be invertible mod 10 (1, 3, 7 or 9).
+   // Common trailing zeroes are dropped; other factors of 2 and 5 are scaled into factors of 10.
+   while (divisor.front() % 2 == 0 || divisor.front() == 5) {
+      if (dividend.empty()) {
+         return InfiniteInt();   // not an exact division
+      }
+      if (divisor.front() == 0) {
+         divisor.erase(divisor.begin());
+         dividend.erase(dividend.begin());
+         continue;
+      }
+      int scale = divisor.front() == 5 ? 2 : 5;   // makes the low digit 0
+      for (std::vector<int>* number : { &divisor, &dividend }) {
+         int carry{0};
+         for (int& digit : *number) {
+            int product = digit * scale + carry;
+            digit = product % 10;
+            carry = product / 10;
+         }
+         if (carry > 0) {
+            number->push_back(carry);
+         }
+      }
+   }
+
+   // The quotient has at most this many digits, and only this many low digits matter
+   int quotientLength = static_cast<int>(dividend.size()) - static_cast<int>(divisor.size()) + 1;
+   if (quotientLength <= 0) {
+      return InfiniteInt();
+   }
+   dividend.resize(quotientLength);
+   if (static_cast<int>(divisor.size()) > quotientLength) {
+      divisor.resize(quotientLength);
+   }
+
+   // Each step fixes one quotient digit so that the lowest remaining digit becomes 0
+   static const int INVERSE_MOD_10[10] = { 0, 1, 0, 7, 0, 0, 0, 3, 0, 9 };
+   const int inverse = INVERSE_MOD_10[divisor.front()];
+   std::vector<int> quotientDigits(quotientLength);  // quotient digits, lowest first
+   for (int i = 0; i < quotientLength; ++i) {
+      int digit = dividend[i] * inverse % 10;
+      quotientDigits[i] = digit;
+      if (digit == 0) {
+         continue;
+      }
+
+      // dividend -= digit * divisor * 10^i, truncated to quotientLength digits
+      int borrow{0};
+      int limit = std::min<int>(quotientLength, i + static_cast<int>(divisor.size()));
+      int j = i;
+      for (; j < limit; ++j) {
+         int diff = dividend[j] - digit * divisor[j - i] - borrow;
+         borrow = 0;
+         if (diff < 0) {
+            borrow = (-diff + 9) / 10;
+            diff += 10 * borrow;
+         }
+         dividend[j] = diff;
+      }
+      for (; borrow > 0 && j < quotientLength; ++j) {
+         int diff = dividend[j] - borrow;
+         borrow = diff < 0 ? 1 : 0;
+         dividend[j] = diff + 10 * borrow;
+      }
+   }
+
+   InfiniteInt quotient;
+   quotient.digits_.assign(quotientDigits.rbegin(), quotientDigits.rend());
+   quotient.removeLeadingZeroes();
+   if (quotient.digits_.front() != 0) {
+      quotient.isNegative_ = isNegative_ != rhs.isNegative_;
+   }
+   return quotient;
+}
+
 /** add(const InfiniteInt&, const InfiniteInt&)
  * @brief   Helper method to add InfiniteInts. Ignores the sign of both InfiniteInts.
  * @param   rhs   The InfiniteInt to add to this one
@@ -417,6 +681,92 @@ bool InfiniteInt::operator<(const InfiniteInt& rhs) const {
    return false;
 }
 
+/** shiftLeft(int)
+ * @brief   Multiplies the number represented by this InfiniteInt by a power of
+ *          ten by appending zero digits, and returns the result.
+ * @param   places   The power of ten to multiply by
+ * @pre     places is not negative.
+ * @post    The returned InfiniteInt represents this number times 10^places.
+ * @return  InfiniteInt representing this number times 10^places.
+ * @throw   std::invalid_argument if places is negative.
+*/
+InfiniteInt InfiniteInt::shiftLeft(int places) const {
+   if (places < 0) {
+      throw std::invalid_argument("InfiniteInt::shiftLeft() called with negative places.");
+   }
+
+   InfiniteInt result(*this);  // the shifted copy
+
+   // Zero stays zero - don't add leading zeroes
+   if (result.digits_.front() != 0) {
+      std::vector<int> zeroes(places, 0);
+      result.digits_.insertBack(zeroes.begin(), zeroes.end());
+   }
+   return result;
+}
+
+/** shiftRight(int)
+ * @brief   Divides the number represented by this InfiniteInt by a power of ten
+ *          by dropping its lowest digits, and returns the result.
+ * @param   places   The power of ten to divide by
+ * @pre     places is not negative.
+ * @post    The returned InfiniteInt represents this number divided by
+ *          10^places, truncated toward zero.
+ * @return  InfiniteInt representing this number divided by 10^places.
+ * @throw   std::invalid_argument if places is negative.
+*/
+InfiniteInt InfiniteInt::shiftRight(int places) const {
+   if (places < 0) {
+      throw std::invalid_argument("InfiniteInt::shiftRight() called with negative places.");
+   }
+
+   // Every digit shifted out - the result is zero
+   if (places >= numDigits()) {
+      return InfiniteInt();
+   }
+
+   InfiniteInt result(*this);  // the shifted copy
+   for (int i = 0; i < places; ++i) {
+      result.digits_.popBack();
+   }
+   return result;
+}
+
+/** decimalText()
+ * @brief   Returns the cached decimal text, building and publishing it first
+ *          if it is not cached yet.
+ * @post    decimal_ holds the decimal text of this InfiniteInt.
+ * @return  Pointer to the decimal text.
+*/
+std::shared_ptr<const std::string> InfiniteInt::decimalText() const {
+   std::shared_ptr<const std::string> cached = std::atomic_load(&decimal_);
+   if (cached) {
+      return cached;
+   }
+
+   // Build the text; if two threads race, both publish identical text
+   std::string text;
+   text.reserve(digits_.numEntries() + 1);
+   if (isNegative_) {
+      text.push_back('-');
+   }
+   for (auto iter = digits_.begin(); iter != digits_.end(); ++iter) {
+      text.push_back(static_cast<char>('0' + *iter));
+   }
+   cached = std::make_shared<const std::string>(std::move(text));
+   std::atomic_store(&decimal_, cached);
+   return cached;
+}
+
+/** invalidateDecimal()
+ * @brief   Drops the cached decimal text. Called after the digits or sign of
+ *          an InfiniteInt that may have been printed are changed in place.
+ * @post    decimal_ is null.
+*/
+void InfiniteInt::invalidateDecimal() {
+   std::atomic_store(&decimal_, std::shared_ptr<const std::string>());
+}
+
 /** removeLeadingZeroes()
  * @brief   Removes any leading zero digits from this InfiniteInt.
  * @post    All leading zero digits, other than the ones digit, have been removed from this InfiniteInt.
@@ -437,15 +787,8 @@ void InfiniteInt::removeLeadingZeroes() {
  * @return  Reference to the modified stream.
 */
 std::ostream& operator<<(std::ostream& outStream, const InfiniteInt& IIToPrint) {
-   // Output minus sign, if necessary
-   if (IIToPrint.isNegative_) {
-      outStream << '-';
-   }
-
-   // Output the digits, from highest to lowest
-   for (auto iter = IIToPrint.digits_.begin(); iter != IIToPrint.digits_.end(); ++iter) {
-      outStream << *iter;
-   }
+   // Output the cached decimal text, building it first if necessary
+   outStream << *IIToPrint.decimalText();
 
    // Return stream
    return outStream;
@@ -485,17 +828,20 @@ std::istream& operator>>(std::istream& inStream, InfiniteInt& IIToFill) {
       inStream.ignore(1);
    }
 
-   // Read in digits and store them
-   char currentChar;    // latest character read from the stream
+   // Read in digits, then store them all at once
+   std::vector<int> digitsRead;  // digits read from the stream, highest first
+   char currentChar;             // latest character read from the stream
    while (inStream.get(currentChar)) {
       if (std::isdigit(currentChar)) {
-         IIToFill.digits_.pushBack(currentChar - '0');
+         digitsRead.push_back(currentChar - '0');
       } else {
          // Not a digit - put it back in the stream and stop reading
          inStream.putback(currentChar);
          break;
       }
    }
+   IIToFill.digits_.insertBack(digitsRead.begin(), digitsRead.end());
+   IIToFill.invalidateDecimal();
 
    // If no digits were read from inStream, set the InfiniteInt to zero
    if (IIToFill.digits_.numEntries() == 0) {
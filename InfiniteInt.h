@@ -6,8 +6,15 @@
  * @date 11/23/2020
 */
 
+#ifndef INFINITEINT_H
+#define INFINITEINT_H
+
 #include "DEIntQueue.h" // Data structure used to store the list of digits
 #include <climits>      // INT_MIN and INT_MAX
+#include <memory>       // Shared, atomically published decimal text
+#include <string>       // Decimal text
+#include <stdexcept>    // std::range_error, std::invalid_argument and std::domain_error
+#include <vector>       // Buffering digits read from streams, and sortInfiniteInts
 
 class InfiniteInt {
 public:
@@ -25,6 +32,23 @@ public:
    */
    explicit InfiniteInt(int num);
 
+   /** InfiniteInt(const InfiniteInt&)
+    * @brief   Copy constructor.
+    * @param   toCopy   The InfiniteInt being copied
+    * @post    This InfiniteInt has the same sign and digits as toCopy. Its
+    *          decimal text has not been cached yet.
+   */
+   InfiniteInt(const InfiniteInt& toCopy);
+
+   /** operator=(const InfiniteInt&)
+    * @brief   Assignment operator.
+    * @param   rhs   The InfiniteInt being copied
+    * @post    This InfiniteInt has the same sign and digits as rhs. Its decimal
+    *          text has not been cached yet.
+    * @return  Reference to this InfiniteInt.
+   */
+   InfiniteInt& operator=(const InfiniteInt& rhs);
+
    /** operator int()
     * @brief   Conversion operator. Returns the number represented by this
     *          InfiniteInt as an integer.
@@ -48,6 +72,16 @@ public:
    */
    int numDigits() const;
 
+   /** toString()
+    * @brief   Returns the decimal text of the number represented by this
+    *          InfiniteInt, as printed by operator<<. The text is built on the
+    *          first call and cached; later calls, and operator<<, reuse it.
+    *          Safe to call from several threads at once.
+    * @post    The decimal text of this InfiniteInt is cached.
+    * @return  The decimal text, with a leading '-' if negative.
+   */
+   std::string toString() const;
+
    /** operator+(const InfiniteInt&)
     * @brief   Adds the number represented by this InfiniteInt to that represented
     *          by another and returns the result as an InfiniteInt.
@@ -78,6 +112,46 @@ public:
    */
    InfiniteInt operator*(const InfiniteInt& rhs) const;
 
+   /** operator/(const InfiniteInt&)
+    * @brief   Divides the number represented by this InfiniteInt by that represented
+    *          by another and returns the quotient as an InfiniteInt.
+    * @param   rhs   The InfiniteInt to divide this one by
+    * @pre     rhs is not zero.
+    * @post    The returned InfiniteInt represents the quotient of this InfiniteInt's
+    *          number and rhs's, truncated toward zero.
+    * @return  InfiniteInt representing the quotient of this InfiniteInt's number and rhs's.
+    * @throw   std::domain_error if rhs is zero.
+   */
+   InfiniteInt operator/(const InfiniteInt& rhs) const;
+
+   /** operator%(const InfiniteInt&)
+    * @brief   Divides the number represented by this InfiniteInt by that represented
+    *          by another and returns the remainder as an InfiniteInt.
+    * @param   rhs   The InfiniteInt to divide this one by
+    * @pre     rhs is not zero.
+    * @post    The returned InfiniteInt represents this number minus rhs times
+    *          (*this / rhs). It is zero or has the same sign as this InfiniteInt.
+    * @return  InfiniteInt representing the remainder of this InfiniteInt's number and rhs's.
+    * @throw   std::domain_error if rhs is zero.
+   */
+   InfiniteInt operator%(const InfiniteInt& rhs) const;
+
+   /** divExact(const InfiniteInt&)
+    * @brief   Divides the number represented by this InfiniteInt by that represented
+    *          by another that is known to divide it exactly. The quotient is built
+    *          from its lowest digit up (Hensel division, 10-adic): each step
+    *          reads one low digit and needs no trial quotients, comparisons or
+    *          remainder correction, and only the low digits that the quotient
+    *          can reach are ever touched.
+    * @param   rhs   The InfiniteInt to divide this one by
+    * @pre     rhs is not zero and divides this InfiniteInt exactly.
+    * @post    The returned InfiniteInt represents this number divided by rhs. If
+    *          rhs does not divide this number exactly, the result is unspecified.
+    * @return  InfiniteInt representing the quotient of this InfiniteInt's number and rhs's.
+    * @throw   std::domain_error if rhs is zero.
+   */
+   InfiniteInt divExact(const InfiniteInt& rhs) const;
+
    /** operator==(const InfiniteInt& rhs)
     * @brief   Equality operator. Checks if this InfiniteInt represents the same integer
     *          as another.
@@ -108,10 +182,34 @@ public:
    */
    bool operator<(const InfiniteInt& rhs) const;
 
+   /** shiftLeft(int)
+    * @brief   Multiplies the number represented by this InfiniteInt by a power of
+    *          ten by appending zero digits, and returns the result.
+    * @param   places   The power of ten to multiply by
+    * @pre     places is not negative.
+    * @post    The returned InfiniteInt represents this number times 10^places.
+    * @return  InfiniteInt representing this number times 10^places.
+    * @throw   std::invalid_argument if places is negative.
+   */
+   InfiniteInt shiftLeft(int places) const;
+
+   /** shiftRight(int)
+    * @brief   Divides the number represented by this InfiniteInt by a power of ten
+    *          by dropping its lowest digits, and returns the result.
+    * @param   places   The power of ten to divide by
+    * @pre     places is not negative.
+    * @post    The returned InfiniteInt represents this number divided by
+    *          10^places, truncated toward zero.
+    * @return  InfiniteInt representing this number divided by 10^places.
+    * @throw   std::invalid_argument if places is negative.
+   */
+   InfiniteInt shiftRight(int places) const;
+
 private:
    // DATA MEMBERS
    DEIntQueue digits_;   // stores the digits in this InfiniteInt (ordered from highest digit to lowest)
    bool isNegative_;     // indicates if the number represented is negative (true) or positive (false)
+   mutable std::shared_ptr<const std::string> decimal_;  // cached decimal text, or null; accessed atomically
 
    // PRIVATE METHODS
    /** add(const InfiniteInt&, const InfiniteInt&)
@@ -137,6 +235,34 @@ private:
    */
    InfiniteInt subtract(const InfiniteInt& lhs, const InfiniteInt& rhs) const;
 
+   /** divide(const InfiniteInt&, const InfiniteInt&, InfiniteInt&, InfiniteInt&)
+    * @brief   Helper method for division. Ignores the sign of both InfiniteInts.
+    * @param   lhs         The InfiniteInt being divided
+    * @param   rhs         The InfiniteInt lhs is divided by
+    * @param   quotient    Set to the quotient of the absolute values
+    * @param   remainder   Set to the remainder of the absolute values
+    * @pre     rhs is not zero.
+    * @post    |lhs| = quotient * |rhs| + remainder, with 0 <= remainder < |rhs|.
+    *          Both results are positive.
+   */
+   static void divide(const InfiniteInt& lhs, const InfiniteInt& rhs,
+                      InfiniteInt& quotient, InfiniteInt& remainder);
+
+   /** decimalText()
+    * @brief   Returns the cached decimal text, building and publishing it first
+    *          if it is not cached yet.
+    * @post    decimal_ holds the decimal text of this InfiniteInt.
+    * @return  Pointer to the decimal text.
+   */
+   std::shared_ptr<const std::string> decimalText() const;
+
+   /** invalidateDecimal()
+    * @brief   Drops the cached decimal text. Called after the digits or sign of
+    *          an InfiniteInt that may have been printed are changed in place.
+    * @post    decimal_ is null.
+   */
+   void invalidateDecimal();
+
    /** removeLeadingZeroes()
     * @brief   Removes any leading zero digits from this InfiniteInt.
     * @post    All leading zero digits, other than the ones digit, have been
@@ -147,6 +273,15 @@ private:
    // Allow access to private members by stream I/O
    friend std::ostream& operator<<(std::ostream& outStream, const InfiniteInt& IIToPrint);
    friend std::istream& operator>>(std::istream& inStream, InfiniteInt& IIToFill);
+
+   // Allow Divisor to split dividends into digit chunks
+   friend class Divisor;
+
+   // Allow InfiniteIntVector to copy digits to and from its arena
+   friend class InfiniteIntVector;
+
+   // Allow sortInfiniteInts to read sort keys straight from the digits
+   friend void sortInfiniteInts(std::vector<InfiniteInt>& values, int numThreads);
 };
 
 /** operator<<(ostream&, const InfiniteInt&)
@@ -175,4 +310,6 @@ std::ostream& operator<<(std::ostream& outStream, const InfiniteInt& IIToPrint);
  *          all other cases, the InfiniteInt is set to zero.
  * @return  Reference to the modified stream.
 */
-std::istream& operator>>(std::istream& inStream, InfiniteInt& IIToFill);
\ No newline at end of file
+std::istream& operator>>(std::istream& inStream, InfiniteInt& IIToFill);
+
+#endif // INFINITEINT_H
@@ -0,0 +1,420 @@
+/** 
+ * @file InfiniteIntVector.cpp
+ * @brief Implementation for InfiniteIntVector, a container that keeps the
+ *    digits of many InfiniteInts in one contiguous arena, indexed by parallel
+ *    offset, length and sign arrays, and hands out lightweight views of them
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "InfiniteIntVector.h"
+#include <algorithm>      // std::reverse
+#include <functional>     // std::less, for checking whether a view points into the arena
+
+// PRIVATE HELPERS
+
+/** compareMagnitudes(const unsigned char*, int, const unsigned char*, int)
+ * @brief   Compares two digit arrays, highest digit first, with no leading zeroes.
+ * @return  Negative, zero or positive as lhs is less than, equal to or greater than rhs.
+*/
+static int compareMagnitudes(const unsigned char* lhs, int lhsDigits, const unsigned char* rhs, int rhsDigits) {
+   if (lhsDigits != rhsDigits) {
+      return lhsDigits < rhsDigits ? -1 : 1;
+   }
+   for (int i = 0; i < lhsDigits; ++i) {
+      if (lhs[i] != rhs[i]) {
+         return lhs[i] < rhs[i] ? -1 : 1;
+      }
+   }
+   return 0;
+}
+
+/** addMagnitudes(const unsigned char*, int, const unsigned char*, int)
+ * @brief   Returns the digits of lhs + rhs, highest first.
+*/
+static std::vector<int> addMagnitudes(const unsigned char* lhs, int lhsDigits,
+                                      const unsigned char* rhs, int rhsDigits) {
+   std::vector<int> sum;
+   int carry = 0;
+   for (int i = lhsDigits - 1, j = rhsDigits - 1; i >= 0 || j >= 0 || carry > 0; --i, --j) {
+      int total = carry + (i >= 0 ? lhs[i] : 0) + (j >= 0 ? rhs[j] : 0);
+      sum.push_back(total % 10);
+      carry = total / 10;
+   }
+   std::reverse(sum.begin(), sum.end());
+   return sum;
+}
+
+/** subtractMagnitudes(const unsigned char*, int, const unsigned char*, int)
+ * @brief   Returns the digits of lhs - rhs, highest first, possibly with
+ *          leading zeroes.
+ * @pre     lhs is at least rhs.
+*/
+static std::vector<int> subtractMagnitudes(const unsigned char* lhs, int lhsDigits,
+                                           const unsigned char* rhs, int rhsDigits) {
+   std::vector<int> difference;
+   int borrow = 0;
+   for (int i = lhsDigits - 1, j = rhsDigits - 1; i >= 0; --i, --j) {
+      int total = lhs[i] - borrow - (j >= 0 ? rhs[j] : 0);
+      borrow = total < 0 ? 1 : 0;
+      difference.push_back(total + 10 * borrow);
+   }
+   std::reverse(difference.begin(), difference.end());
+   return difference;
+}
+
+/** View(const unsigned char*, int, bool)
+ * @brief   Constructor. Used by InfiniteIntVector to hand out views.
+*/
+InfiniteIntVector::View::View(const unsigned char* digits, int numDigits, bool isNegative)
+   : digits_(digits), numDigits_(numDigits), isNegative_(isNegative) { }
+
+/** numDigits()
+ * @brief   Returns the number of digits in the viewed value.
+*/
+int InfiniteIntVector::View::numDigits() const {
+   return numDigits_;
+}
+
+/** isNegative()
+ * @brief   Returns true if the viewed value is negative.
+*/
+bool InfiniteIntVector::View::isNegative() const {
+   return isNegative_;
+}
+
+/** digit(int)
+ * @brief   Returns one digit of the viewed value.
+ * @param   position    The digit's position, 0 for the highest digit
+ * @throw   std::out_of_range if position is not a digit position.
+*/
+int InfiniteIntVector::View::digit(int position) const {
+   if (position < 0 || position >= numDigits_) {
+      throw std::out_of_range("InfiniteIntVector::View::digit() position out of range.");
+   }
+   return digits_[position];
+}
+
+/** toInfiniteInt()
+ * @brief   Returns the viewed value as an InfiniteInt.
+*/
+InfiniteInt InfiniteIntVector::View::toInfiniteInt() const {
+   std::vector<int> digits(digits_, digits_ + numDigits_);
+   return makeInfiniteInt(digits, isNegative_);
+}
+
+/** toString()
+ * @brief   Returns the decimal text of the viewed value.
+*/
+std::string InfiniteIntVector::View::toString() const {
+   std::string text = isNegative_ ? "-" : "";
+   for (int i = 0; i < numDigits_; ++i) {
+      text += static_cast<char>('0' + digits_[i]);
+   }
+   return text;
+}
+
+/** operator==(const View&)
+ * @brief   Returns true if both views show the same value.
+*/
+bool InfiniteIntVector::View::operator==(const View& rhs) const {
+   return isNegative_ == rhs.isNegative_ &&
+          compareMagnitudes(digits_, numDigits_, rhs.digits_, rhs.numDigits_) == 0;
+}
+
+/** operator!=(const View&)
+ * @brief   Returns true if the views show different values.
+*/
+bool InfiniteIntVector::View::operator!=(const View& rhs) const {
+   return !(*this == rhs);
+}
+
+/** operator<(const View&)
+ * @brief   Returns true if the viewed value is less than rhs's.
+*/
+bool InfiniteIntVector::View::operator<(const View& rhs) const {
+   if (isNegative_ != rhs.isNegative_) {
+      return isNegative_;
+   }
+   int order = compareMagnitudes(digits_, numDigits_, rhs.digits_, rhs.numDigits_);
+   return isNegative_ ? order > 0 : order < 0;
+}
+
+/** operator+(const View&)
+ * @brief   Returns the sum of the viewed values, added digit by digit in
+ *          the arena.
+*/
+InfiniteInt InfiniteIntVector::View::operator+(const View& rhs) const {
+   if (isNegative_ == rhs.isNegative_) {
+      std::vector<int> sum = addMagnitudes(digits_, numDigits_, rhs.digits_, rhs.numDigits_);
+      return makeInfiniteInt(sum, isNegative_);
+   }
+   // Opposite signs: subtract the smaller magnitude, keep the larger one's sign
+   if (compareMagnitudes(digits_, numDigits_, rhs.digits_, rhs.numDigits_) >= 0) {
+      std::vector<int> difference = subtractMagnitudes(digits_, numDigits_, rhs.digits_, rhs.numDigits_);
+      return makeInfiniteInt(difference, isNegative_);
+   }
+   std::vector<int> difference = subtractMagnitudes(rhs.digits_, rhs.numDigits_, digits_, numDigits_);
+   return makeInfiniteInt(difference, rhs.isNegative_);
+}
+
+/** operator-(const View&)
+ * @brief   Returns the difference of the viewed values, subtracted digit by
+ *          digit in the arena.
+*/
+InfiniteInt InfiniteIntVector::View::operator-(const View& rhs) const {
+   View negated(rhs.digits_, rhs.numDigits_, !rhs.isNegative_);
+   return *this + negated;
+}
+
+/** operator*(const View&)
+ * @brief   Returns the product of the viewed values. Digit products are
+ *          accumulated into word-sized columns and carried once at the end.
+*/
+InfiniteInt InfiniteIntVector::View::operator*(const View& rhs) const {
+   // columns[k] collects the digit products landing k places from the right
+   std::vector<unsigned long long> columns(numDigits_ + rhs.numDigits_, 0);
+   for (int i = 0; i < numDigits_; ++i) {
+      if (digits_[i] == 0) {
+         continue;
+      }
+      const int place = numDigits_ - 1 - i;
+      for (int j = 0; j < rhs.numDigits_; ++j) {
+         columns[place + rhs.numDigits_ - 1 - j] += static_cast<unsigned long long>(digits_[i]) * rhs.digits_[j];
+      }
+   }
+
+   std::vector<int> product(columns.size());
+   unsigned long long carry = 0;
+   for (std::size_t k = 0; k < columns.size(); ++k) {
+      unsigned long long total = columns[k] + carry;
+      product[columns.size() - 1 - k] = static_cast<int>(total % 10);
+      carry = total / 10;
+   }
+   return makeInfiniteInt(product, isNegative_ != rhs.isNegative_);
+}
+
+/** operator*()
+ * @brief   Returns a view of the current value.
+*/
+InfiniteIntVector::View InfiniteIntVector::const_iterator::operator*() const {
+   return (*container_)[index_];
+}
+
+/** operator++()
+ * @brief   Moves to the next value.
+ * @return  Reference to this iterator.
+*/
+InfiniteIntVector::const_iterator& InfiniteIntVector::const_iterator::operator++() {
+   ++index_;
+   return *this;
+}
+
+/** operator==(const const_iterator&)
+ * @brief   Returns true if both iterators are at the same position.
+*/
+bool InfiniteIntVector::const_iterator::operator==(const const_iterator& other) const {
+   return container_ == other.container_ && index_ == other.index_;
+}
+
+/** operator!=(const const_iterator&)
+ * @brief   Returns true if the iterators are at different positions.
+*/
+bool InfiniteIntVector::const_iterator::operator!=(const const_iterator& other) const {
+   return !(*this == other);
+}
+
+/** const_iterator(const InfiniteIntVector*, std::size_t)
+ * @brief   Constructor. Used by InfiniteIntVector::begin() and end().
+*/
+InfiniteIntVector::const_iterator::const_iterator(const InfiniteIntVector* container, std::size_t index)
+   : container_(container), index_(index) { }
+
+/** InfiniteIntVector()
+ * @brief   Default constructor. Creates an empty vector.
+*/
+InfiniteIntVector::InfiniteIntVector() { }
+
+/** InfiniteIntVector(const std::vector<InfiniteInt>&)
+ * @brief   Constructor. Copies the digits of every value into the arena.
+*/
+InfiniteIntVector::InfiniteIntVector(const std::vector<InfiniteInt>& values) {
+   std::size_t numDigits = 0;
+   for (const InfiniteInt& value : values) {
+      numDigits += static_cast<std::size_t>(value.numDigits());
+   }
+   reserve(values.size(), numDigits);
+   for (const InfiniteInt& value : values) {
+      pushBack(value);
+   }
+}
+
+/** size()
+ * @brief   Returns the number of values stored.
+*/
+std::size_t InfiniteIntVector::size() const {
+   return offsets_.size();
+}
+
+/** empty()
+ * @brief   Returns true if no values are stored.
+*/
+bool InfiniteIntVector::empty() const {
+   return offsets_.empty();
+}
+
+/** reserve(std::size_t, std::size_t)
+ * @brief   Reserves room for numValues values with numDigits digits in total,
+ *          so that pushing them does not reallocate.
+*/
+void InfiniteIntVector::reserve(std::size_t numValues, std::size_t numDigits) {
+   arena_.reserve(numDigits);
+   offsets_.reserve(numValues);
+   lengths_.reserve(numValues);
+   negatives_.reserve(numValues);
+}
+
+/** pushBack(const InfiniteInt&)
+ * @brief   Appends a value, copying its digits onto the end of the arena.
+ * @post    Earlier views may be invalidated.
+*/
+void InfiniteIntVector::pushBack(const InfiniteInt& value) {
+   offsets_.push_back(arena_.size());
+   lengths_.push_back(value.numDigits());
+   negatives_.push_back(value.isNegative_ ? 1 : 0);
+   for (auto digit = value.digits_.begin(); digit != value.digits_.end(); ++digit) {
+      arena_.push_back(static_cast<unsigned char>(*digit));
+   }
+}
+
+/** pushBack(const View&)
+ * @brief   Appends the value shown by a view, which may come from this vector.
+ * @post    Earlier views may be invalidated.
+*/
+void InfiniteIntVector::pushBack(const View& value) {
+   std::less<const unsigned char*> before;
+   const unsigned char* arenaStart = arena_.data();
+   bool isInArena = !arena_.empty() && !before(value.digits_, arenaStart) &&
+                    before(value.digits_, arenaStart + arena_.size());
+   if (isInArena) {
+      // Growing the arena may move the digits being copied, so copy by offset
+      std::size_t source = static_cast<std::size_t>(value.digits_ - arenaStart);
+      arena_.reserve(arena_.size() + value.numDigits_);
+      offsets_.push_back(arena_.size());
+      for (int i = 0; i < value.numDigits_; ++i) {
+         arena_.push_back(arena_[source + i]);
+      }
+   } else {
+      offsets_.push_back(arena_.size());
+      arena_.insert(arena_.end(), value.digits_, value.digits_ + value.numDigits_);
+   }
+   lengths_.push_back(value.numDigits_);
+   negatives_.push_back(value.isNegative_ ? 1 : 0);
+}
+
+/** popBack()
+ * @brief   Removes the last value and its digits.
+ * @throw   std::out_of_range if the vector is empty.
+*/
+void InfiniteIntVector::popBack() {
+   if (empty()) {
+      throw std::out_of_range("InfiniteIntVector::popBack() called on an empty vector.");
+   }
+   arena_.resize(offsets_.back());
+   offsets_.pop_back();
+   lengths_.pop_back();
+   negatives_.pop_back();
+}
+
+/** clear()
+ * @brief   Removes every value.
+*/
+void InfiniteIntVector::clear() {
+   arena_.clear();
+   offsets_.clear();
+   lengths_.clear();
+   negatives_.clear();
+}
+
+/** operator[](std::size_t)
+ * @brief   Returns a view of the value at index, without bounds checking.
+*/
+InfiniteIntVector::View InfiniteIntVector::operator[](std::size_t index) const {
+   return View(arena_.data() + offsets_[index], lengths_[index], negatives_[index] != 0);
+}
+
+/** at(std::size_t)
+ * @brief   Returns a view of the value at index.
+ * @throw   std::out_of_range if index is not less than size().
+*/
+InfiniteIntVector::View InfiniteIntVector::at(std::size_t index) const {
+   if (index >= size()) {
+      throw std::out_of_range("InfiniteIntVector::at() index out of range.");
+   }
+   return (*this)[index];
+}
+
+/** get(std::size_t)
+ * @brief   Returns the value at index as an InfiniteInt.
+ * @throw   std::out_of_range if index is not less than size().
+*/
+InfiniteInt InfiniteIntVector::get(std::size_t index) const {
+   return at(index).toInfiniteInt();
+}
+
+/** toVector()
+ * @brief   Returns every value as an InfiniteInt, in order.
+*/
+std::vector<InfiniteInt> InfiniteIntVector::toVector() const {
+   std::vector<InfiniteInt> values;
+   values.reserve(size());
+   for (View view : *this) {
+      values.push_back(view.toInfiniteInt());
+   }
+   return values;
+}
+
+/** begin()
+ * @brief   Returns an iterator at the first value.
+*/
+InfiniteIntVector::const_iterator InfiniteIntVector::begin() const {
+   return const_iterator(this, 0);
+}
+
+/** end()
+ * @brief   Returns an iterator one past the last value.
+*/
+InfiniteIntVector::const_iterator InfiniteIntVector::end() const {
+   return const_iterator(this, size());
+}
+
+/** memoryBytes()
+ * @brief   Returns the number of bytes held by the arena and the index arrays.
+*/
+std::size_t InfiniteIntVector::memoryBytes() const {
+   return arena_.capacity() * sizeof(unsigned char) + offsets_.capacity() * sizeof(std::size_t) +
+          lengths_.capacity() * sizeof(int) + negatives_.capacity() * sizeof(unsigned char);
+}
+
+/** makeInfiniteInt(std::vector<int>&, bool)
+ * @brief   Returns the InfiniteInt with the given digits (highest first, with
+ *          possible leading zeroes) and sign, normalizing zero to positive.
+*/
+InfiniteInt InfiniteIntVector::makeInfiniteInt(std::vector<int>& digits, bool isNegative) {
+   InfiniteInt result;
+   if (digits.empty()) {
+      return result;
+   }
+   result.digits_.clear();
+   result.digits_.insertBack(digits.begin(), digits.end());
+   result.removeLeadingZeroes();
+   result.isNegative_ = isNegative && !(result.digits_.numEntries() == 1 && result.digits_.front() == 0);
+   return result;
+}
+
+/** operator<<(ostream&, const InfiniteIntVector::View&)
+ * @brief   Outputs the value shown by a view to an output stream.
+ * @return  Reference to the modified stream.
+*/
+std::ostream& operator<<(std::ostream& outStream, const InfiniteIntVector::View& view) {
+   return outStream << view.toString();
+}
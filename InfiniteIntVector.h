@@ -0,0 +1,253 @@
+/** 
+ * @file InfiniteIntVector.h
+ * @brief Class definition for InfiniteIntVector, a container that keeps the
+ *    digits of many InfiniteInts in one contiguous arena, indexed by parallel
+ *    offset, length and sign arrays, and hands out lightweight views of them
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef INFINITEINTVECTOR_H
+#define INFINITEINTVECTOR_H
+
+#include "InfiniteInt.h" // Type of the values stored and of arithmetic results
+#include <cstddef>       // std::size_t
+#include <ostream>       // Printing views
+#include <stdexcept>     // std::out_of_range
+#include <string>        // Decimal text of views
+#include <vector>        // Arena and index arrays
+
+class InfiniteIntVector {
+public:
+   /** View
+    * @brief   A read-only view of one value in an InfiniteIntVector: a pointer
+    *          to its digits in the arena, its length and its sign. Views are
+    *          cheap to copy and compare and do arithmetic on the arena digits
+    *          directly. A view is invalidated when values are added to or
+    *          removed from the vector it came from.
+   */
+   class View {
+   public:
+      //PUBLIC METHODS
+      /** numDigits()
+       * @brief   Returns the number of digits in the viewed value.
+      */
+      int numDigits() const;
+
+      /** isNegative()
+       * @brief   Returns true if the viewed value is negative.
+      */
+      bool isNegative() const;
+
+      /** digit(int)
+       * @brief   Returns one digit of the viewed value.
+       * @param   position    The digit's position, 0 for the highest digit
+       * @throw   std::out_of_range if position is not a digit position.
+      */
+      int digit(int position) const;
+
+      /** toInfiniteInt()
+       * @brief   Returns the viewed value as an InfiniteInt.
+      */
+      InfiniteInt toInfiniteInt() const;
+
+      /** toString()
+       * @brief   Returns the decimal text of the viewed value.
+      */
+      std::string toString() const;
+
+      /** operator==(const View&)
+       * @brief   Returns true if both views show the same value.
+      */
+      bool operator==(const View& rhs) const;
+
+      /** operator!=(const View&)
+       * @brief   Returns true if the views show different values.
+      */
+      bool operator!=(const View& rhs) const;
+
+      /** operator<(const View&)
+       * @brief   Returns true if the viewed value is less than rhs's.
+      */
+      bool operator<(const View& rhs) const;
+
+      /** operator+(const View&)
+       * @brief   Returns the sum of the viewed values, added digit by digit in
+       *          the arena.
+      */
+      InfiniteInt operator+(const View& rhs) const;
+
+      /** operator-(const View&)
+       * @brief   Returns the difference of the viewed values, subtracted digit by
+       *          digit in the arena.
+      */
+      InfiniteInt operator-(const View& rhs) const;
+
+      /** operator*(const View&)
+       * @brief   Returns the product of the viewed values. Digit products are
+       *          accumulated into word-sized columns and carried once at the end.
+      */
+      InfiniteInt operator*(const View& rhs) const;
+
+   private:
+      /** View(const unsigned char*, int, bool)
+       * @brief   Constructor. Used by InfiniteIntVector to hand out views.
+      */
+      View(const unsigned char* digits, int numDigits, bool isNegative);
+
+      // DATA MEMBERS
+      const unsigned char* digits_; // the value's digits in the arena, highest first
+      int numDigits_;               // number of digits
+      bool isNegative_;             // whether the value is negative
+
+      friend class InfiniteIntVector;
+   };
+
+   /** const_iterator
+    * @brief   Forward iterator over the views of an InfiniteIntVector, in order.
+   */
+   class const_iterator {
+   public:
+      /** operator*()
+       * @brief   Returns a view of the current value.
+      */
+      View operator*() const;
+
+      /** operator++()
+       * @brief   Moves to the next value.
+       * @return  Reference to this iterator.
+      */
+      const_iterator& operator++();
+
+      /** operator==(const const_iterator&)
+       * @brief   Returns true if both iterators are at the same position.
+      */
+      bool operator==(const const_iterator& other) const;
+
+      /** operator!=(const const_iterator&)
+       * @brief   Returns true if the iterators are at different positions.
+      */
+      bool operator!=(const const_iterator& other) const;
+
+   private:
+      /** const_iterator(const InfiniteIntVector*, std::size_t)
+       * @brief   Constructor. Used by InfiniteIntVector::begin() and end().
+      */
+      const_iterator(const InfiniteIntVector* container, std::size_t index);
+
+      // DATA MEMBERS
+      const InfiniteIntVector* container_;  // vector being iterated over
+      std::size_t index_;                   // position of the current value
+
+      friend class InfiniteIntVector;
+   };
+
+   //PUBLIC METHODS
+   /** InfiniteIntVector()
+    * @brief   Default constructor. Creates an empty vector.
+   */
+   InfiniteIntVector();
+
+   /** InfiniteIntVector(const std::vector<InfiniteInt>&)
+    * @brief   Constructor. Copies the digits of every value into the arena.
+   */
+   explicit InfiniteIntVector(const std::vector<InfiniteInt>& values);
+
+   /** size()
+    * @brief   Returns the number of values stored.
+   */
+   std::size_t size() const;
+
+   /** empty()
+    * @brief   Returns true if no values are stored.
+   */
+   bool empty() const;
+
+   /** reserve(std::size_t, std::size_t)
+    * @brief   Reserves room for numValues values with numDigits digits in total,
+    *          so that pushing them does not reallocate.
+   */
+   void reserve(std::size_t numValues, std::size_t numDigits);
+
+   /** pushBack(const InfiniteInt&)
+    * @brief   Appends a value, copying its digits onto the end of the arena.
+    * @post    Earlier views may be invalidated.
+   */
+   void pushBack(const InfiniteInt& value);
+
+   /** pushBack(const View&)
+    * @brief   Appends the value shown by a view, which may come from this vector.
+    * @post    Earlier views may be invalidated.
+   */
+   void pushBack(const View& value);
+
+   /** popBack()
+    * @brief   Removes the last value and its digits.
+    * @throw   std::out_of_range if the vector is empty.
+   */
+   void popBack();
+
+   /** clear()
+    * @brief   Removes every value.
+   */
+   void clear();
+
+   /** operator[](std::size_t)
+    * @brief   Returns a view of the value at index, without bounds checking.
+   */
+   View operator[](std::size_t index) const;
+
+   /** at(std::size_t)
+    * @brief   Returns a view of the value at index.
+    * @throw   std::out_of_range if index is not less than size().
+   */
+   View at(std::size_t index) const;
+
+   /** get(std::size_t)
+    * @brief   Returns the value at index as an InfiniteInt.
+    * @throw   std::out_of_range if index is not less than size().
+   */
+   InfiniteInt get(std::size_t index) const;
+
+   /** toVector()
+    * @brief   Returns every value as an InfiniteInt, in order.
+   */
+   std::vector<InfiniteInt> toVector() const;
+
+   /** begin()
+    * @brief   Returns an iterator at the first value.
+   */
+   const_iterator begin() const;
+
+   /** end()
+    * @brief   Returns an iterator one past the last value.
+   */
+   const_iterator end() const;
+
+   /** memoryBytes()
+    * @brief   Returns the number of bytes held by the arena and the index arrays.
+   */
+   std::size_t memoryBytes() const;
+
+private:
+   // PRIVATE FUNCTIONS
+   /** makeInfiniteInt(std::vector<int>&, bool)
+    * @brief   Returns the InfiniteInt with the given digits (highest first, with
+    *          possible leading zeroes) and sign, normalizing zero to positive.
+   */
+   static InfiniteInt makeInfiniteInt(std::vector<int>& digits, bool isNegative);
+
+   // DATA MEMBERS
+   std::vector<unsigned char> arena_;      // digits of every value, highest first, value after value
+   std::vector<std::size_t> offsets_;      // offsets_[i] is where value i's digits start in arena_
+   std::vector<int> lengths_;              // lengths_[i] is the number of digits of value i
+   std::vector<unsigned char> negatives_;  // negatives_[i] is 1 if value i is negative
+};
+
+/** operator<<(ostream&, const InfiniteIntVector::View&)
+ * @brief   Outputs the value shown by a view to an output stream.
+ * @return  Reference to the modified stream.
+*/
+std::ostream& operator<<(std::ostream& outStream, const InfiniteIntVector::View& view);
+
+#endif // INFINITEINTVECTOR_H
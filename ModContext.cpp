@@ -0,0 +1,76 @@
+/** 
+ * @file ModContext.cpp
+ * @brief Implementation for ModContext, a modulus prepared once for modular
+ *    arithmetic on InfiniteInts (reductions reuse a precomputed Divisor)
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "ModContext.h"
+
+/** checkedModulus(const InfiniteInt&)
+ * @brief   Returns modulus, after checking that it is positive.
+ * @throw   std::invalid_argument if modulus is not positive.
+*/
+static const InfiniteInt& checkedModulus(const InfiniteInt& modulus) {
+   if (!(InfiniteInt(0) < modulus)) {
+      throw std::invalid_argument("ModContext modulus must be positive.");
+   }
+   return modulus;
+}
+
+/** ModContext(const InfiniteInt&)
+ * @brief   Constructor.
+ * @param   modulus  The modulus for all arithmetic in this context
+ * @pre     modulus is positive.
+ * @post    Reductions by modulus are prepared.
+ * @throw   std::invalid_argument if modulus is not positive.
+*/
+ModContext::ModContext(const InfiniteInt& modulus)
+   : modulus_(checkedModulus(modulus)), divisor_(modulus) { }
+
+/** modulus()
+ * @brief   Returns the modulus of this context.
+*/
+const InfiniteInt& ModContext::modulus() const {
+   return modulus_;
+}
+
+/** reduce(const InfiniteInt&)
+ * @brief   Returns value mod modulus.
+ * @param   value    Any InfiniteInt
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing value mod modulus.
+*/
+InfiniteInt ModContext::reduce(const InfiniteInt& value) const {
+   InfiniteInt result = value % divisor_;
+   return result < InfiniteInt(0) ? result + modulus_ : result;
+}
+
+/** add(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns (lhs + rhs) mod modulus.
+ * @pre     lhs and rhs are between 0 and modulus - 1.
+ * @post    The returned value is between 0 and modulus - 1.
+*/
+InfiniteInt ModContext::add(const InfiniteInt& lhs, const InfiniteInt& rhs) const {
+   InfiniteInt sum = lhs + rhs;
+   return sum < modulus_ ? sum : sum - modulus_;
+}
+
+/** subtract(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns (lhs - rhs) mod modulus.
+ * @pre     lhs and rhs are between 0 and modulus - 1.
+ * @post    The returned value is between 0 and modulus - 1.
+*/
+InfiniteInt ModContext::subtract(const InfiniteInt& lhs, const InfiniteInt& rhs) const {
+   InfiniteInt difference = lhs - rhs;
+   return difference < InfiniteInt(0) ? difference + modulus_ : difference;
+}
+
+/** multiply(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns (lhs * rhs) mod modulus.
+ * @pre     lhs and rhs are between 0 and modulus - 1.
+ * @post    The returned value is between 0 and modulus - 1.
+*/
+InfiniteInt ModContext::multiply(const InfiniteInt& lhs, const InfiniteInt& rhs) const {
+   return (lhs * rhs) % divisor_;
+}
@@ -0,0 +1,68 @@
+/** 
+ * @file ModContext.h
+ * @brief Class definition for ModContext, a modulus prepared once for modular
+ *    arithmetic on InfiniteInts (reductions reuse a precomputed Divisor)
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef MODCONTEXT_H
+#define MODCONTEXT_H
+
+#include "Divisor.h"     // Precomputed reductions by the modulus
+#include "InfiniteInt.h" // Type of the modulus and residues
+#include <stdexcept>     // std::invalid_argument
+
+class ModContext {
+public:
+   //PUBLIC METHODS
+   /** ModContext(const InfiniteInt&)
+    * @brief   Constructor.
+    * @param   modulus  The modulus for all arithmetic in this context
+    * @pre     modulus is positive.
+    * @post    Reductions by modulus are prepared.
+    * @throw   std::invalid_argument if modulus is not positive.
+   */
+   explicit ModContext(const InfiniteInt& modulus);
+
+   /** modulus()
+    * @brief   Returns the modulus of this context.
+   */
+   const InfiniteInt& modulus() const;
+
+   /** reduce(const InfiniteInt&)
+    * @brief   Returns value mod modulus.
+    * @param   value    Any InfiniteInt
+    * @post    The returned value is between 0 and modulus - 1.
+    * @return  InfiniteInt representing value mod modulus.
+   */
+   InfiniteInt reduce(const InfiniteInt& value) const;
+
+   /** add(const InfiniteInt&, const InfiniteInt&)
+    * @brief   Returns (lhs + rhs) mod modulus.
+    * @pre     lhs and rhs are between 0 and modulus - 1.
+    * @post    The returned value is between 0 and modulus - 1.
+   */
+   InfiniteInt add(const InfiniteInt& lhs, const InfiniteInt& rhs) const;
+
+   /** subtract(const InfiniteInt&, const InfiniteInt&)
+    * @brief   Returns (lhs - rhs) mod modulus.
+    * @pre     lhs and rhs are between 0 and modulus - 1.
+    * @post    The returned value is between 0 and modulus - 1.
+   */
+   InfiniteInt subtract(const InfiniteInt& lhs, const InfiniteInt& rhs) const;
+
+   /** multiply(const InfiniteInt&, const InfiniteInt&)
+    * @brief   Returns (lhs * rhs) mod modulus.
+    * @pre     lhs and rhs are between 0 and modulus - 1.
+    * @post    The returned value is between 0 and modulus - 1.
+   */
+   InfiniteInt multiply(const InfiniteInt& lhs, const InfiniteInt& rhs) const;
+
+private:
+   // DATA MEMBERS
+   InfiniteInt modulus_;   // modulus of this context
+   Divisor divisor_;       // prepared division by modulus_
+};
+
+#endif // MODCONTEXT_H
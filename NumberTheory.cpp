@@ -0,0 +1,846 @@
+/** 
+ * @file NumberTheory.cpp
+ * @brief Implementation of number-theoretic functions on InfiniteInts: modular
+ *    exponentiation, including batches spread across threads and simultaneous
+ *    products of powers, gcds (including batch gcds over product and remainder
+ *    trees), modular inverses and Chinese remaindering
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "NumberTheory.h"
+#include "ParallelFor.h"  // Spreading batches across threads
+#include "ProductTree.h"  // Subproduct trees for Chinese remaindering
+#include <algorithm>       // std::max
+#include <atomic>          // Unique spill file names
+#include <cstdint>         // Montgomery limbs
+#include <cstdio>          // std::remove
+#include <fstream>         // Spill files
+#include <random>          // Spill file name tokens
+#include <iomanip>         // Zero-padding rebuilt chunks
+#include <sstream>         // Reading the decimal digits of exponents
+#include <string>          // Decimal digits of exponents
+#include <utility>         // std::move
+
+// PRIVATE HELPERS
+
+const int MONTGOMERY_LANES = 8;                       // exponentiations interleaved in one pass over the limbs
+const int MONTGOMERY_MAX_LIMBS = 128;                 // largest modulus (in 32-bit limbs) given to the Montgomery path
+const int WINDOW_BITS = 4;                            // exponent bits consumed per table lookup
+const unsigned long long CHUNK_BASE = 1000000000ULL;  // decimal text is converted nine digits at a time
+
+/** MontgomeryModulus
+ * @brief   An odd modulus in 32-bit limbs, with the constants Montgomery
+ *          multiplication by R = 2^(32 * limbs_.size()) needs.
+*/
+struct MontgomeryModulus {
+   std::vector<std::uint32_t> limbs_;     // the modulus, lowest limb first
+   std::uint32_t inverse_;                // -modulus^-1 mod 2^32
+   std::vector<std::uint32_t> rSquared_;  // R^2 mod modulus, limbs_.size() limbs
+};
+
+/** decimalDigits(const InfiniteInt&)
+ * @brief   Returns the digits of a non-negative InfiniteInt, highest first.
+*/
+static std::string decimalDigits(const InfiniteInt& value) {
+   std::ostringstream text;
+   text << value;
+   return text.str();
+}
+
+/** reduce(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns value mod modulus in the range 0 to modulus - 1.
+ * @pre     modulus is positive.
+*/
+static InfiniteInt reduce(const InfiniteInt& value, const InfiniteInt& modulus) {
+   InfiniteInt result = value % modulus;
+   if (result < InfiniteInt(0)) {
+      result = result + modulus;
+   }
+   return result;
+}
+
+/** checkPowmodArguments(const InfiniteInt&, const InfiniteInt&)
+ * @throw   std::invalid_argument if exponent is negative or modulus is not positive.
+*/
+static void checkPowmodArguments(const InfiniteInt& exponent, const InfiniteInt& modulus) {
+   if (exponent < InfiniteInt(0)) {
+      throw std::invalid_argument("powmod() called with a negative exponent.");
+   }
+   if (!(InfiniteInt(0) < modulus)) {
+      throw std::invalid_argument("powmod() called with a modulus that is not positive.");
+   }
+}
+
+/** fillDigitPowers(const InfiniteInt&, const InfiniteInt&, InfiniteInt*)
+ * @brief   Sets digitPowers[d] to base^d mod modulus for every decimal digit d.
+ * @pre     digitPowers has room for 10 entries and modulus is greater than 1.
+*/
+static void fillDigitPowers(const InfiniteInt& base, const InfiniteInt& modulus, InfiniteInt* digitPowers) {
+   digitPowers[0] = InfiniteInt(1);
+   digitPowers[1] = reduce(base, modulus);
+   for (int d = 2; d < 10; ++d) {
+      digitPowers[d] = (digitPowers[d - 1] * digitPowers[1]) % modulus;
+   }
+}
+
+/** tenthPower(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns value^10 mod modulus using four modular multiplications.
+*/
+static InfiniteInt tenthPower(const InfiniteInt& value, const InfiniteInt& modulus) {
+   InfiniteInt squared = (value * value) % modulus;       // ^2
+   InfiniteInt fourth = (squared * squared) % modulus;    // ^4
+   InfiniteInt fifth = (fourth * value) % modulus;        // ^5
+   return (fifth * fifth) % modulus;                      // ^10
+}
+
+/** windowedPowmod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   powmod() without argument checks.
+*/
+static InfiniteInt windowedPowmod(const InfiniteInt& base, const InfiniteInt& exponent,
+                                  const InfiniteInt& modulus) {
+   const InfiniteInt one(1);
+   if (modulus == one) {
+      return InfiniteInt(0);
+   }
+
+   InfiniteInt digitPowers[10];  // base^d mod modulus for every decimal digit d
+   fillDigitPowers(base, modulus, digitPowers);
+
+   // Left to right: result = result^10 * base^digit for each exponent digit
+   InfiniteInt result(one);
+   bool started{false};  // whether result has moved past its initial 1
+   for (char digitChar : decimalDigits(exponent)) {
+      int digit = digitChar - '0';
+      if (started) {
+         result = tenthPower(result, modulus);
+         if (digit != 0) {
+            result = (result * digitPowers[digit]) % modulus;
+         }
+      } else if (digit != 0) {
+         result = digitPowers[digit];
+         started = true;
+      }
+   }
+   return result;
+}
+
+/** toLimbs(const InfiniteInt&)
+ * @brief   Returns a non-negative InfiniteInt in base 2^32, lowest limb first,
+ *          read off its decimal text nine digits at a time. Zero has no limbs.
+*/
+static std::vector<std::uint32_t> toLimbs(const InfiniteInt& value) {
+   std::string text = value.toString();
+   std::vector<std::uint32_t> limbs;
+   std::size_t start = 0;
+   while (start < text.size()) {
+      // Take the leading digits so that the rest splits into whole nine-digit chunks
+      std::size_t length = (text.size() - start) % 9 == 0 ? 9 : (text.size() - start) % 9;
+      unsigned long long chunk = 0;
+      unsigned long long scale = 1;
+      for (std::size_t i = start; i < start + length; ++i) {
+         chunk = chunk * 10 + static_cast<unsigned long long>(text[i] - '0');
+         scale *= 10;
+      }
+
+      // limbs = limbs * scale + chunk
+      unsigned long long carry = chunk;
+      for (std::uint32_t& limb : limbs) {
+         unsigned long long total = limb * scale + carry;
+         limb = static_cast<std::uint32_t>(total);
+         carry = total >> 32;
+      }
+      if (carry > 0) {
+         limbs.push_back(static_cast<std::uint32_t>(carry));
+      }
+      start += length;
+   }
+   return limbs;
+}
+
+/** fromLimbs(std::vector<std::uint32_t>)
+ * @brief   Returns the InfiniteInt whose value is limbs, in base 2^32 with the
+ *          lowest limb first.
+*/
+static InfiniteInt fromLimbs(std::vector<std::uint32_t> limbs) {
+   while (!limbs.empty() && limbs.back() == 0) {
+      limbs.pop_back();
+   }
+
+   // Peel off base 10^9 chunks, lowest first
+   std::vector<unsigned long long> chunks;
+   while (!limbs.empty()) {
+      unsigned long long remainder = 0;
+      for (std::size_t i = limbs.size(); i-- > 0; ) {
+         unsigned long long current = (remainder << 32) | limbs[i];
+         limbs[i] = static_cast<std::uint32_t>(current / CHUNK_BASE);
+         remainder = current % CHUNK_BASE;
+      }
+      chunks.push_back(remainder);
+      while (!limbs.empty() && limbs.back() == 0) {
+         limbs.pop_back();
+      }
+   }
+   if (chunks.empty()) {
+      return InfiniteInt(0);
+   }
+
+   std::ostringstream text;
+   text << chunks.back();
+   for (std::size_t i = chunks.size() - 1; i-- > 0; ) {
+      text << std::setw(9) << std::setfill('0') << chunks[i];
+   }
+   std::istringstream stream(text.str());
+   InfiniteInt result;
+   stream >> result;
+   return result;
+}
+
+/** prepareMontgomery(const InfiniteInt&, MontgomeryModulus&)
+ * @brief   Fills montgomery with the limbs and constants of modulus if the
+ *          Montgomery path can handle it.
+ * @pre     modulus is positive.
+ * @return  False if modulus is 1, even or longer than MONTGOMERY_MAX_LIMBS limbs.
+*/
+static bool prepareMontgomery(const InfiniteInt& modulus, MontgomeryModulus& montgomery) {
+   montgomery.limbs_ = toLimbs(modulus);
+   const std::vector<std::uint32_t>& limbs = montgomery.limbs_;
+   if ((limbs[0] & 1) == 0 || (limbs.size() == 1 && limbs[0] == 1) ||
+       limbs.size() > static_cast<std::size_t>(MONTGOMERY_MAX_LIMBS)) {
+      return false;
+   }
+
+   // Newton's iteration doubles the correct low bits of the inverse: 3, 6, 12, 24, 48
+   std::uint32_t inverse = limbs[0];
+   for (int i = 0; i < 4; ++i) {
+      inverse *= 2 - limbs[0] * inverse;
+   }
+   montgomery.inverse_ = static_cast<std::uint32_t>(0) - inverse;
+
+   // R^2 mod modulus by doubling 1 modulo the modulus 2 * 32 * n times
+   std::size_t n = limbs.size();
+   std::vector<std::uint32_t> value(n, 0);
+   value[0] = 1;
+   for (std::size_t step = 0; step < 64 * n; ++step) {
+      std::uint32_t carry = 0;
+      for (std::uint32_t& limb : value) {
+         std::uint32_t shifted = (limb << 1) | carry;
+         carry = limb >> 31;
+         limb = shifted;
+      }
+      bool atLeastModulus = carry != 0;
+      if (!atLeastModulus) {
+         atLeastModulus = true;
+         for (std::size_t i = n; i-- > 0; ) {
+            if (value[i] != limbs[i]) {
+               atLeastModulus = value[i] > limbs[i];
+               break;
+            }
+         }
+      }
+      if (atLeastModulus) {
+         unsigned long long borrow = 0;
+         for (std::size_t i = 0; i < n; ++i) {
+            unsigned long long difference = static_cast<unsigned long long>(value[i]) - limbs[i] - borrow;
+            value[i] = static_cast<std::uint32_t>(difference);
+            borrow = difference >> 63;
+         }
+      }
+   }
+   montgomery.rSquared_ = value;
+   return true;
+}
+
+/** montgomeryMultiplyLanes(const MontgomeryModulus&, const std::uint32_t*, const std::uint32_t*, std::uint32_t*)
+ * @brief   Sets product = lhs * rhs * R^-1 mod modulus in every lane, by
+ *          coarsely integrated operand scanning. Operands are lane-interleaved:
+ *          limb j of lane k is at index j * MONTGOMERY_LANES + k, so every
+ *          innermost loop runs across the lanes and can be vectorized.
+ * @pre     Every lane of lhs and rhs is below the modulus, and product does
+ *          not overlap lhs or rhs.
+ * @post    Every lane of product is below the modulus.
+*/
+static void montgomeryMultiplyLanes(const MontgomeryModulus& modulus, const std::uint32_t* lhs,
+                                    const std::uint32_t* rhs, std::uint32_t* product) {
+   const int n = static_cast<int>(modulus.limbs_.size());
+   const int lanes = MONTGOMERY_LANES;
+   std::uint32_t accumulator[(MONTGOMERY_MAX_LIMBS + 2) * MONTGOMERY_LANES];  // n + 2 limbs per lane
+   unsigned long long carry[MONTGOMERY_LANES];
+   std::uint32_t quotient[MONTGOMERY_LANES];
+   for (int e = 0; e < (n + 2) * lanes; ++e) {
+      accumulator[e] = 0;
+   }
+
+   for (int i = 0; i < n; ++i) {
+      // accumulator += lhs * limb i of rhs
+      const std::uint32_t* factor = rhs + i * lanes;
+      for (int k = 0; k < lanes; ++k) {
+         carry[k] = 0;
+      }
+      for (int j = 0; j < n; ++j) {
+         const std::uint32_t* limb = lhs + j * lanes;
+         std::uint32_t* sum = accumulator + j * lanes;
+         for (int k = 0; k < lanes; ++k) {
+            unsigned long long total = sum[k] + static_cast<unsigned long long>(limb[k]) * factor[k] + carry[k];
+            sum[k] = static_cast<std::uint32_t>(total);
+            carry[k] = total >> 32;
+         }
+      }
+      for (int k = 0; k < lanes; ++k) {
+         unsigned long long total = accumulator[n * lanes + k] + carry[k];
+         accumulator[n * lanes + k] = static_cast<std::uint32_t>(total);
+         accumulator[(n + 1) * lanes + k] = static_cast<std::uint32_t>(total >> 32);
+      }
+
+      // accumulator = (accumulator + quotient * modulus) / 2^32, which is exact
+      for (int k = 0; k < lanes; ++k) {
+         quotient[k] = accumulator[k] * modulus.inverse_;
+         unsigned long long total = accumulator[k] + static_cast<unsigned long long>(quotient[k]) * modulus.limbs_[0];
+         carry[k] = total >> 32;
+      }
+      for (int j = 1; j < n; ++j) {
+         unsigned long long modulusLimb = modulus.limbs_[j];
+         for (int k = 0; k < lanes; ++k) {
+            unsigned long long total = accumulator[j * lanes + k] + quotient[k] * modulusLimb + carry[k];
+            accumulator[(j - 1) * lanes + k] = static_cast<std::uint32_t>(total);
+            carry[k] = total >> 32;
+         }
+      }
+      for (int k = 0; k < lanes; ++k) {
+         unsigned long long total = accumulator[n * lanes + k] + carry[k];
+         accumulator[(n - 1) * lanes + k] = static_cast<std::uint32_t>(total);
+         accumulator[n * lanes + k] = accumulator[(n + 1) * lanes + k] + static_cast<std::uint32_t>(total >> 32);
+      }
+   }
+
+   // The accumulator is below twice the modulus; subtract it once where it is not below
+   for (int k = 0; k < lanes; ++k) {
+      carry[k] = 0;   // now the borrow
+   }
+   for (int j = 0; j < n; ++j) {
+      unsigned long long modulusLimb = modulus.limbs_[j];
+      for (int k = 0; k < lanes; ++k) {
+         unsigned long long difference = accumulator[j * lanes + k] - modulusLimb - carry[k];
+         product[j * lanes + k] = static_cast<std::uint32_t>(difference);
+         carry[k] = difference >> 63;
+      }
+   }
+   for (int j = 0; j < n; ++j) {
+      for (int k = 0; k < lanes; ++k) {
+         bool keepDifference = accumulator[n * lanes + k] != 0 || carry[k] == 0;
+         product[j * lanes + k] = keepDifference ? product[j * lanes + k] : accumulator[j * lanes + k];
+      }
+   }
+}
+
+/** windowDigit(const std::vector<std::uint32_t>&, int)
+ * @brief   Returns bits WINDOW_BITS * window up to WINDOW_BITS * (window + 1) of an exponent in limbs.
+*/
+static int windowDigit(const std::vector<std::uint32_t>& limbs, int window) {
+   int bit = window * WINDOW_BITS;
+   std::size_t index = static_cast<std::size_t>(bit / 32);
+   if (index >= limbs.size()) {
+      return 0;
+   }
+   return static_cast<int>((limbs[index] >> (bit % 32)) & ((1u << WINDOW_BITS) - 1));
+}
+
+/** montgomeryPowmodLanes(const MontgomeryModulus&, const InfiniteInt&, const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, std::size_t, std::vector<InfiniteInt>&)
+ * @brief   Sets results[i] = bases[i]^exponents[i] mod modulus for the (up to)
+ *          MONTGOMERY_LANES entries starting at first, one entry per lane. Every
+ *          lane follows the same schedule of fixed WINDOW_BITS windows, taking
+ *          its own table entry for each window.
+ * @pre     montgomery was prepared from modulus and no exponent is negative.
+*/
+static void montgomeryPowmodLanes(const MontgomeryModulus& montgomery, const InfiniteInt& modulus,
+                                  const std::vector<InfiniteInt>& bases,
+                                  const std::vector<InfiniteInt>& exponents,
+                                  std::size_t first, std::vector<InfiniteInt>& results) {
+   const std::size_t n = montgomery.limbs_.size();
+   const int lanes = MONTGOMERY_LANES;
+   const int tableSize = 1 << WINDOW_BITS;
+   const std::size_t laneWidth = n * lanes;   // limbs in one lane-interleaved value
+   int count = static_cast<int>(std::min(bases.size() - first, static_cast<std::size_t>(lanes)));
+
+   // Reduced bases and the Montgomery constants, in every lane; unused lanes hold 0
+   std::vector<std::uint32_t> base(laneWidth, 0);
+   std::vector<std::uint32_t> one(laneWidth, 0);
+   std::vector<std::uint32_t> rSquared(laneWidth, 0);
+   std::vector<std::vector<std::uint32_t>> exponentLimbs(lanes);
+   int numWindows{0};
+   for (int k = 0; k < lanes; ++k) {
+      one[k] = 1;
+      for (std::size_t j = 0; j < n; ++j) {
+         rSquared[j * lanes + k] = montgomery.rSquared_[j];
+      }
+      if (k < count) {
+         std::vector<std::uint32_t> limbs = toLimbs(reduce(bases[first + k], modulus));
+         for (std::size_t j = 0; j < limbs.size(); ++j) {
+            base[j * lanes + k] = limbs[j];
+         }
+         exponentLimbs[k] = toLimbs(exponents[first + k]);
+         numWindows = std::max(numWindows, static_cast<int>(exponentLimbs[k].size()) * 32 / WINDOW_BITS);
+      }
+   }
+
+   // table[d] = base^d in Montgomery form (times R mod modulus)
+   std::vector<std::uint32_t> table(tableSize * laneWidth);
+   montgomeryMultiplyLanes(montgomery, rSquared.data(), one.data(), table.data());
+   montgomeryMultiplyLanes(montgomery, base.data(), rSquared.data(), table.data() + laneWidth);
+   for (int d = 2; d < tableSize; ++d) {
+      montgomeryMultiplyLanes(montgomery, table.data() + (d - 1) * laneWidth, table.data() + laneWidth,
+                              table.data() + d * laneWidth);
+   }
+
+   // Left to right: result = result^(2^WINDOW_BITS) * base^digit for each window
+   std::vector<std::uint32_t> result(table.begin(), table.begin() + laneWidth);
+   std::vector<std::uint32_t> scratch(laneWidth);
+   std::vector<std::uint32_t> operand(laneWidth);
+   int digits[MONTGOMERY_LANES];
+   for (int window = numWindows - 1; window >= 0; --window) {
+      bool anyDigit{false};
+      for (int k = 0; k < lanes; ++k) {
+         digits[k] = k < count ? windowDigit(exponentLimbs[k], window) : 0;
+         anyDigit = anyDigit || digits[k] != 0;
+      }
+      for (std::size_t j = 0; j < n; ++j) {
+         for (int k = 0; k < lanes; ++k) {
+            operand[j * lanes + k] = table[digits[k] * laneWidth + j * lanes + k];
+         }
+      }
+
+      if (window == numWindows - 1) {
+         result.swap(operand);
+         continue;
+      }
+      for (int square = 0; square < WINDOW_BITS; ++square) {
+         montgomeryMultiplyLanes(montgomery, result.data(), result.data(), scratch.data());
+         result.swap(scratch);
+      }
+      if (anyDigit) {
+         montgomeryMultiplyLanes(montgomery, result.data(), operand.data(), scratch.data());
+         result.swap(scratch);
+      }
+   }
+
+   // Leave Montgomery form by multiplying by 1
+   montgomeryMultiplyLanes(montgomery, result.data(), one.data(), scratch.data());
+   for (int k = 0; k < count; ++k) {
+      std::vector<std::uint32_t> limbs(n);
+      for (std::size_t j = 0; j < n; ++j) {
+         limbs[j] = scratch[j * lanes + k];
+      }
+      results[first + k] = fromLimbs(limbs);
+   }
+}
+
+// MODULAR EXPONENTIATION
+
+/** powmod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Computes base^exponent mod modulus, scanning the exponent one decimal
+ *          digit at a time (a 10-ary window: one table lookup per digit and four
+ *          modular multiplications to raise the running result to the 10th power).
+ * @param   base        The number being raised to a power
+ * @param   exponent    The power to raise base to
+ * @param   modulus     The modulus the result is reduced by
+ * @pre     exponent is not negative and modulus is positive.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing base^exponent mod modulus.
+ * @throw   std::invalid_argument if exponent is negative or modulus is not positive.
+*/
+InfiniteInt powmod(const InfiniteInt& base, const InfiniteInt& exponent, const InfiniteInt& modulus) {
+   checkPowmodArguments(exponent, modulus);
+   return windowedPowmod(base, exponent, modulus);
+}
+
+/** powmodBatch(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, const InfiniteInt&, int)
+ * @brief   Computes bases[i]^exponents[i] mod modulus for every i. For an odd
+ *          modulus of up to 4096 bits the operands are converted to 32-bit limbs
+ *          and exponentiated with Montgomery multiplication, eight at a time in
+ *          lane-interleaved buffers so the limb loops vectorize across the
+ *          batch; each group of eight is a unit of work for the worker threads.
+ *          Other moduli spread powmod() across the threads one entry at a time.
+ * @param   bases       The numbers being raised to powers
+ * @param   exponents   The power to raise each base to
+ * @param   modulus     The modulus shared by the whole batch
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     bases and exponents have the same size, no exponent is negative and
+ *          modulus is positive.
+ * @post    Entry i of the result equals powmod(bases[i], exponents[i], modulus).
+ * @return  The results, in the same order as the operands.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+std::vector<InfiniteInt> powmodBatch(const std::vector<InfiniteInt>& bases,
+                                     const std::vector<InfiniteInt>& exponents,
+                                     const InfiniteInt& modulus, int numThreads) {
+   if (bases.size() != exponents.size()) {
+      throw std::invalid_argument("powmodBatch() called with different numbers of bases and exponents.");
+   }
+   if (numThreads < 0) {
+      throw std::invalid_argument("powmodBatch() called with a negative thread count.");
+   }
+   // Check everything up front so workers never fail on bad input
+   checkPowmodArguments(InfiniteInt(0), modulus);
+   for (const InfiniteInt& exponent : exponents) {
+      checkPowmodArguments(exponent, modulus);
+   }
+
+   std::vector<InfiniteInt> results(bases.size());
+   MontgomeryModulus montgomery;
+   if (prepareMontgomery(modulus, montgomery)) {
+      std::size_t numGroups = (bases.size() + MONTGOMERY_LANES - 1) / MONTGOMERY_LANES;
+      parallelFor(numGroups, numThreads, [&](std::size_t group) {
+         montgomeryPowmodLanes(montgomery, modulus, bases, exponents, group * MONTGOMERY_LANES, results);
+      });
+   } else {
+      parallelFor(bases.size(), numThreads, [&](std::size_t i) {
+         results[i] = windowedPowmod(bases[i], exponents[i], modulus);
+      });
+   }
+   return results;
+}
+
+/** multiPowmod(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, const InfiniteInt&)
+ * @brief   Computes the product of bases[i]^exponents[i] mod modulus with
+ *          Straus's simultaneous exponentiation: the exponents are scanned
+ *          together one decimal digit at a time, so the running product is
+ *          raised to the 10th power once per digit position for all bases
+ *          instead of once per digit position per base.
+ * @param   bases       The numbers being raised to powers
+ * @param   exponents   The power to raise each base to
+ * @param   modulus     The modulus the result is reduced by
+ * @pre     bases and exponents have the same size, no exponent is negative and
+ *          modulus is positive.
+ * @post    The returned value is between 0 and modulus - 1. An empty product is 1
+ *          (or 0 when modulus is 1).
+ * @return  InfiniteInt representing the product of bases[i]^exponents[i] mod modulus.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt multiPowmod(const std::vector<InfiniteInt>& bases,
+                        const std::vector<InfiniteInt>& exponents,
+                        const InfiniteInt& modulus) {
+   if (bases.size() != exponents.size()) {
+      throw std::invalid_argument("multiPowmod() called with different numbers of bases and exponents.");
+   }
+   checkPowmodArguments(InfiniteInt(0), modulus);
+   for (const InfiniteInt& exponent : exponents) {
+      checkPowmodArguments(exponent, modulus);
+   }
+
+   const InfiniteInt one(1);
+   if (modulus == one) {
+      return InfiniteInt(0);
+   }
+
+   // Digit tables and exponent digits for every base, padded to a common length
+   std::vector<std::string> exponentDigits;
+   std::size_t numPositions{0};
+   for (const InfiniteInt& exponent : exponents) {
+      exponentDigits.push_back(decimalDigits(exponent));
+      numPositions = std::max(numPositions, exponentDigits.back().size());
+   }
+   for (std::string& digits : exponentDigits) {
+      digits.insert(0, numPositions - digits.size(), '0');
+   }
+   std::vector<InfiniteInt> digitPowers(10 * bases.size());  // 10 entries per base
+   for (std::size_t i = 0; i < bases.size(); ++i) {
+      fillDigitPowers(bases[i], modulus, &digitPowers[10 * i]);
+   }
+
+   // One shared tenth power per digit position, then one multiplication per nonzero digit
+   InfiniteInt result(one);
+   bool started{false};  // whether result has moved past its initial 1
+   for (std::size_t position = 0; position < numPositions; ++position) {
+      if (started) {
+         result = tenthPower(result, modulus);
+      }
+      for (std::size_t i = 0; i < bases.size(); ++i) {
+         int digit = exponentDigits[i][position] - '0';
+         if (digit != 0) {
+            result = started ? (result * digitPowers[10 * i + digit]) % modulus
+                             : digitPowers[10 * i + digit];
+            started = true;
+         }
+      }
+   }
+   return result;
+}
+
+// GCD AND INVERSES
+
+/** gcd(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns the greatest common divisor of two InfiniteInts (Euclid's algorithm).
+ * @param   lhs   First InfiniteInt
+ * @param   rhs   Second InfiniteInt
+ * @post    The returned value is not negative. gcd(0, 0) is 0.
+ * @return  InfiniteInt representing the greatest common divisor of lhs and rhs.
+*/
+InfiniteInt gcd(const InfiniteInt& lhs, const InfiniteInt& rhs) {
+   const InfiniteInt zero(0);
+   InfiniteInt a = lhs < zero ? zero - lhs : lhs;
+   InfiniteInt b = rhs < zero ? zero - rhs : rhs;
+   while (b != zero) {
+      InfiniteInt next = a % b;
+      a = b;
+      b = next;
+   }
+   return a;
+}
+
+/** modInverse(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns the inverse of value modulo modulus (extended Euclidean algorithm).
+ * @param   value    The InfiniteInt to invert
+ * @param   modulus  The modulus
+ * @pre     modulus is positive and gcd(value, modulus) is 1.
+ * @post    (value * result) mod modulus is 1 mod modulus, and result is between
+ *          0 and modulus - 1.
+ * @return  InfiniteInt representing the inverse of value modulo modulus.
+ * @throw   std::invalid_argument if modulus is not positive.
+ * @throw   std::domain_error if value has no inverse modulo modulus.
+*/
+InfiniteInt modInverse(const InfiniteInt& value, const InfiniteInt& modulus) {
+   const InfiniteInt zero(0);
+   if (!(zero < modulus)) {
+      throw std::invalid_argument("modInverse() called with a modulus that is not positive.");
+   }
+
+   // Invariant: oldRemainder = oldCoefficient * value (mod modulus), and likewise for the current pair
+   InfiniteInt oldRemainder = reduce(value, modulus);
+   InfiniteInt remainder = modulus;
+   InfiniteInt oldCoefficient(1);
+   InfiniteInt coefficient(0);
+   while (remainder != zero) {
+      InfiniteInt quotient = oldRemainder / remainder;
+      InfiniteInt nextRemainder = oldRemainder - quotient * remainder;
+      InfiniteInt nextCoefficient = oldCoefficient - quotient * coefficient;
+      oldRemainder = remainder;
+      remainder = nextRemainder;
+      oldCoefficient = coefficient;
+      coefficient = nextCoefficient;
+   }
+
+   if (oldRemainder != InfiniteInt(1)) {
+      throw std::domain_error("modInverse() called with a value that shares a factor with the modulus.");
+   }
+   return reduce(oldCoefficient, modulus);
+}
+
+/** LevelStore
+ * @brief   Holds the levels of a ProductTree between building it and walking
+ *          back down, either in memory or, given a directory, in one spill file
+ *          per level. File names carry a random token as well as a per-process
+ *          counter, so processes sharing a directory do not touch each other's files.
+*/
+class LevelStore {
+public:
+   explicit LevelStore(const std::string& spillDirectory) : spillDirectory_(spillDirectory) {
+      static std::atomic<unsigned> nextStore(0);
+      std::random_device entropy;
+      std::ostringstream token;
+      token << std::hex << entropy() << '_' << entropy() << '_' << nextStore++;
+      storeToken_ = token.str();
+   }
+
+   ~LevelStore() {
+      for (std::size_t level = 0; level < inMemory_.size(); ++level) {
+         if (!spillDirectory_.empty()) {
+            std::remove(fileName(level).c_str());
+         }
+      }
+   }
+
+   // Stores a level, moving it to disk if spilling
+   void put(std::size_t level, std::vector<InfiniteInt>&& nodes) {
+      if (inMemory_.size() <= level) {
+         inMemory_.resize(level + 1);
+         sizes_.resize(level + 1);
+      }
+      sizes_[level] = nodes.size();
+      if (spillDirectory_.empty()) {
+         inMemory_[level] = std::move(nodes);
+         return;
+      }
+      std::ofstream file(fileName(level));
+      for (const InfiniteInt& node : nodes) {
+         file << node << '\n';
+      }
+      if (!file) {
+         throw std::runtime_error("batchGcd() could not write spill file " + fileName(level));
+      }
+      nodes.clear();
+   }
+
+   // Returns a stored level, reading it back from disk if spilling
+   std::vector<InfiniteInt> take(std::size_t level) {
+      if (spillDirectory_.empty()) {
+         return std::move(inMemory_[level]);
+      }
+      std::ifstream file(fileName(level));
+      std::vector<InfiniteInt> nodes(sizes_[level]);
+      for (InfiniteInt& node : nodes) {
+         file >> node;
+      }
+      if (!file) {
+         throw std::runtime_error("batchGcd() could not read spill file " + fileName(level));
+      }
+      file.close();
+      std::remove(fileName(level).c_str());
+      return nodes;
+   }
+
+private:
+   std::string fileName(std::size_t level) const {
+      return spillDirectory_ + "/batchgcd_" + storeToken_ + "_level_" + std::to_string(level) + ".txt";
+   }
+
+   std::string spillDirectory_;                      // where levels are spilled, or empty to keep them in memory
+   std::string storeToken_;                          // distinguishes the files of concurrent stores and processes
+   std::vector<std::vector<InfiniteInt>> inMemory_;  // levels kept in memory
+   std::vector<std::size_t> sizes_;                  // number of nodes in each stored level
+};
+
+/** batchGcd(const std::vector<InfiniteInt>&, int, const std::string&)
+ * @brief   Returns gcd(values[i], product of all the other values) for every i,
+ *          with Bernstein's algorithm: a product tree of the values, then a
+ *          remainder tree reducing the full product modulo the square of each
+ *          node on the way down. The nodes of each level are computed in parallel.
+ * @param   values          The numbers to check against each other
+ * @param   numThreads      The number of worker threads, or 0 to use one per hardware thread
+ * @param   spillDirectory  If not empty, a writable directory where the levels
+ *                          above the leaves are kept between the two passes
+ *                          instead of in memory
+ * @pre     Every value is positive.
+ * @post    Entry i is 1 exactly when values[i] shares no factor with any other value.
+ *          Spill files have been removed.
+ * @return  The gcds, in the same order as the values.
+ * @throw   std::invalid_argument if a value is not positive.
+ * @throw   std::runtime_error if a spill file cannot be written or read back.
+*/
+std::vector<InfiniteInt> batchGcd(const std::vector<InfiniteInt>& values, int numThreads,
+                                  const std::string& spillDirectory) {
+   for (const InfiniteInt& value : values) {
+      if (!(InfiniteInt(0) < value)) {
+         throw std::invalid_argument("batchGcd() called with a value that is not positive.");
+      }
+   }
+   if (values.empty()) {
+      return std::vector<InfiniteInt>();
+   }
+
+   // Product tree, bottom up. Only the level being multiplied stays in memory when spilling.
+   LevelStore store(spillDirectory);
+   std::vector<InfiniteInt> below = values;
+   std::size_t numLevels{1};
+   while (below.size() > 1) {
+      std::vector<InfiniteInt> above = ProductTree::productLevel(below, numThreads);
+      if (numLevels > 1) {
+         store.put(numLevels - 1, std::move(below));
+      }
+      below = std::move(above);
+      ++numLevels;
+   }
+
+   // Remainder tree, top down: each node keeps the product mod its own square
+   std::vector<InfiniteInt> remainders = below;   // the root, the product itself
+   for (std::size_t level = numLevels - 1; level-- > 0; ) {
+      std::vector<InfiniteInt> squares = level == 0 ? values : store.take(level);
+      parallelFor(squares.size(), numThreads, [&](std::size_t k) {
+         squares[k] = squares[k] * squares[k];
+      });
+      remainders = ProductTree::remainderLevel(remainders, squares, numThreads);
+   }
+
+   // (product mod value^2) / value = (product of the others) mod value
+   std::vector<InfiniteInt> results(values.size());
+   parallelFor(values.size(), numThreads, [&](std::size_t i) {
+      results[i] = gcd(remainders[i] / values[i], values[i]);
+   });
+   return results;
+}
+
+// CHINESE REMAINDER THEOREM
+
+/** crt(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, int)
+ * @brief   Reconstructs the number that has the given residue modulo each of the
+ *          given moduli. The moduli are put in a ProductTree and solutions are
+ *          merged pairwise up the tree, so each merge works with numbers the size
+ *          of its own subtree instead of the size of the whole product. The
+ *          merges of each level run in parallel.
+ * @param   residues    The residue for each modulus
+ * @param   moduli      Pairwise coprime, positive moduli
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     residues and moduli have the same, nonzero size; the moduli are
+ *          positive and pairwise coprime.
+ * @post    The returned value x satisfies x mod moduli[i] = residues[i] mod
+ *          moduli[i] for every i, and is between 0 and the product of the moduli - 1.
+ * @return  InfiniteInt representing the reconstructed number.
+ * @throw   std::invalid_argument if the sizes differ, are zero, or a modulus is
+ *          not positive.
+ * @throw   std::domain_error if two moduli share a factor.
+*/
+InfiniteInt crt(const std::vector<InfiniteInt>& residues, const std::vector<InfiniteInt>& moduli,
+                int numThreads) {
+   if (residues.size() != moduli.size() || moduli.empty()) {
+      throw std::invalid_argument("crt() needs one residue per modulus and at least one modulus.");
+   }
+   for (const InfiniteInt& modulus : moduli) {
+      if (!(InfiniteInt(0) < modulus)) {
+         throw std::invalid_argument("crt() called with a modulus that is not positive.");
+      }
+   }
+
+   ProductTree tree(moduli, numThreads);
+
+   // Solutions for the leaves are the reduced residues
+   std::vector<InfiniteInt> solutions(residues.size());
+   parallelFor(residues.size(), numThreads, [&](std::size_t i) {
+      solutions[i] = reduce(residues[i], moduli[i]);
+   });
+
+   /* Merge neighbouring solutions level by level. A node with solution x1 modulo
+      M1 on the left and x2 modulo M2 on the right has solution
+      x1 + M1 * ((x2 - x1) * M1^-1 mod M2) modulo M1 * M2. */
+   for (int level = 1; level < tree.numLevels(); ++level) {
+      const std::vector<InfiniteInt>& below = tree.level(level - 1);
+      std::vector<InfiniteInt> merged(tree.level(level).size());
+      parallelFor(merged.size(), numThreads, [&](std::size_t k) {
+         if (2 * k + 1 == below.size()) {
+            merged[k] = solutions[2 * k];   // unpaired node carried up
+            return;
+         }
+         const InfiniteInt& leftModulus = below[2 * k];
+         const InfiniteInt& rightModulus = below[2 * k + 1];
+         InfiniteInt inverse = modInverse(leftModulus, rightModulus);
+         InfiniteInt lift = (reduce(solutions[2 * k + 1] - solutions[2 * k], rightModulus) * inverse) % rightModulus;
+         merged[k] = solutions[2 * k] + leftModulus * lift;
+      });
+      solutions.swap(merged);
+   }
+   return solutions.front();
+}
+
+// MULTI-MODULAR REDUCTION
+
+/** multiMod(const InfiniteInt&, const std::vector<InfiniteInt>&, int)
+ * @brief   Reduces one value modulo many moduli with a remainder tree over a
+ *          ProductTree of the moduli (see ProductTree::remainders()), instead of
+ *          one long division of the whole value per modulus.
+ * @param   value       The InfiniteInt to reduce
+ * @param   moduli      The moduli
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     Every modulus is positive.
+ * @post    Entry i is value mod moduli[i], between 0 and moduli[i] - 1.
+ * @return  The residues, in the same order as the moduli.
+ * @throw   std::invalid_argument if a modulus is not positive.
+*/
+std::vector<InfiniteInt> multiMod(const InfiniteInt& value, const std::vector<InfiniteInt>& moduli,
+                                  int numThreads) {
+   for (const InfiniteInt& modulus : moduli) {
+      if (!(InfiniteInt(0) < modulus)) {
+         throw std::invalid_argument("multiMod() called with a modulus that is not positive.");
+      }
+   }
+   if (moduli.empty()) {
+      return std::vector<InfiniteInt>();
+   }
+   return ProductTree(moduli, numThreads).remainders(value);
+}
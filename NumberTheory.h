@@ -0,0 +1,160 @@
+/** 
+ * @file NumberTheory.h
+ * @brief Number-theoretic functions on InfiniteInts: modular exponentiation,
+ *    including batches spread across threads and simultaneous products of powers,
+ *    gcds (including batch gcds over product and remainder trees), modular
+ *    inverses and Chinese remaindering
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef NUMBERTHEORY_H
+#define NUMBERTHEORY_H
+
+#include "InfiniteInt.h" // Type of the operands and results
+#include <stdexcept>     // std::invalid_argument, std::domain_error and std::runtime_error
+#include <string>        // Spill directory names
+#include <vector>        // Batches of operands and results
+
+// MODULAR EXPONENTIATION
+
+/** powmod(const InfiniteInt&, const InfiniteInt&, const InfiniteInt&)
+ * @brief   Computes base^exponent mod modulus, scanning the exponent one decimal
+ *          digit at a time (a 10-ary window: one table lookup per digit and four
+ *          modular multiplications to raise the running result to the 10th power).
+ * @param   base        The number being raised to a power
+ * @param   exponent    The power to raise base to
+ * @param   modulus     The modulus the result is reduced by
+ * @pre     exponent is not negative and modulus is positive.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing base^exponent mod modulus.
+ * @throw   std::invalid_argument if exponent is negative or modulus is not positive.
+*/
+InfiniteInt powmod(const InfiniteInt& base, const InfiniteInt& exponent, const InfiniteInt& modulus);
+
+/** powmodBatch(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, const InfiniteInt&, int)
+ * @brief   Computes bases[i]^exponents[i] mod modulus for every i. For an odd
+ *          modulus of up to 4096 bits the operands are converted to 32-bit limbs
+ *          and exponentiated with Montgomery multiplication, eight at a time in
+ *          lane-interleaved buffers so the limb loops vectorize across the
+ *          batch; each group of eight is a unit of work for the worker threads.
+ *          Other moduli spread powmod() across the threads one entry at a time.
+ * @param   bases       The numbers being raised to powers
+ * @param   exponents   The power to raise each base to
+ * @param   modulus     The modulus shared by the whole batch
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     bases and exponents have the same size, no exponent is negative and
+ *          modulus is positive.
+ * @post    Entry i of the result equals powmod(bases[i], exponents[i], modulus).
+ * @return  The results, in the same order as the operands.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+std::vector<InfiniteInt> powmodBatch(const std::vector<InfiniteInt>& bases,
+                                     const std::vector<InfiniteInt>& exponents,
+                                     const InfiniteInt& modulus, int numThreads = 0);
+
+/** multiPowmod(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, const InfiniteInt&)
+ * @brief   Computes the product of bases[i]^exponents[i] mod modulus with
+ *          Straus's simultaneous exponentiation: the exponents are scanned
+ *          together one decimal digit at a time, so the running product is
+ *          raised to the 10th power once per digit position for all bases
+ *          instead of once per digit position per base.
+ * @param   bases       The numbers being raised to powers
+ * @param   exponents   The power to raise each base to
+ * @param   modulus     The modulus the result is reduced by
+ * @pre     bases and exponents have the same size, no exponent is negative and
+ *          modulus is positive.
+ * @post    The returned value is between 0 and modulus - 1. An empty product is 1
+ *          (or 0 when modulus is 1).
+ * @return  InfiniteInt representing the product of bases[i]^exponents[i] mod modulus.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt multiPowmod(const std::vector<InfiniteInt>& bases,
+                        const std::vector<InfiniteInt>& exponents,
+                        const InfiniteInt& modulus);
+
+// GCD AND INVERSES
+
+/** gcd(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns the greatest common divisor of two InfiniteInts (Euclid's algorithm).
+ * @param   lhs   First InfiniteInt
+ * @param   rhs   Second InfiniteInt
+ * @post    The returned value is not negative. gcd(0, 0) is 0.
+ * @return  InfiniteInt representing the greatest common divisor of lhs and rhs.
+*/
+InfiniteInt gcd(const InfiniteInt& lhs, const InfiniteInt& rhs);
+
+/** modInverse(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Returns the inverse of value modulo modulus (extended Euclidean algorithm).
+ * @param   value    The InfiniteInt to invert
+ * @param   modulus  The modulus
+ * @pre     modulus is positive and gcd(value, modulus) is 1.
+ * @post    (value * result) mod modulus is 1 mod modulus, and result is between
+ *          0 and modulus - 1.
+ * @return  InfiniteInt representing the inverse of value modulo modulus.
+ * @throw   std::invalid_argument if modulus is not positive.
+ * @throw   std::domain_error if value has no inverse modulo modulus.
+*/
+InfiniteInt modInverse(const InfiniteInt& value, const InfiniteInt& modulus);
+
+/** batchGcd(const std::vector<InfiniteInt>&, int, const std::string&)
+ * @brief   Returns gcd(values[i], product of all the other values) for every i,
+ *          with Bernstein's algorithm: a product tree of the values, then a
+ *          remainder tree reducing the full product modulo the square of each
+ *          node on the way down. The nodes of each level are computed in parallel.
+ * @param   values          The numbers to check against each other
+ * @param   numThreads      The number of worker threads, or 0 to use one per hardware thread
+ * @param   spillDirectory  If not empty, a writable directory where the levels
+ *                          above the leaves are kept between the two passes
+ *                          instead of in memory
+ * @pre     Every value is positive.
+ * @post    Entry i is 1 exactly when values[i] shares no factor with any other value.
+ *          Spill files have been removed.
+ * @return  The gcds, in the same order as the values.
+ * @throw   std::invalid_argument if a value is not positive.
+ * @throw   std::runtime_error if a spill file cannot be written or read back.
+*/
+std::vector<InfiniteInt> batchGcd(const std::vector<InfiniteInt>& values, int numThreads = 0,
+                                  const std::string& spillDirectory = "");
+
+// CHINESE REMAINDER THEOREM
+
+/** crt(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, int)
+ * @brief   Reconstructs the number that has the given residue modulo each of the
+ *          given moduli. The moduli are put in a ProductTree and solutions are
+ *          merged pairwise up the tree, so each merge works with numbers the size
+ *          of its own subtree instead of the size of the whole product. The
+ *          merges of each level run in parallel.
+ * @param   residues    The residue for each modulus
+ * @param   moduli      Pairwise coprime, positive moduli
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     residues and moduli have the same, nonzero size; the moduli are
+ *          positive and pairwise coprime.
+ * @post    The returned value x satisfies x mod moduli[i] = residues[i] mod
+ *          moduli[i] for every i, and is between 0 and the product of the moduli - 1.
+ * @return  InfiniteInt representing the reconstructed number.
+ * @throw   std::invalid_argument if the sizes differ, are zero, or a modulus is
+ *          not positive.
+ * @throw   std::domain_error if two moduli share a factor.
+*/
+InfiniteInt crt(const std::vector<InfiniteInt>& residues, const std::vector<InfiniteInt>& moduli,
+                int numThreads = 0);
+
+// MULTI-MODULAR REDUCTION
+
+/** multiMod(const InfiniteInt&, const std::vector<InfiniteInt>&, int)
+ * @brief   Reduces one value modulo many moduli with a remainder tree over a
+ *          ProductTree of the moduli (see ProductTree::remainders()), instead of
+ *          one long division of the whole value per modulus.
+ * @param   value       The InfiniteInt to reduce
+ * @param   moduli      The moduli
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     Every modulus is positive.
+ * @post    Entry i is value mod moduli[i], between 0 and moduli[i] - 1.
+ * @return  The residues, in the same order as the moduli.
+ * @throw   std::invalid_argument if a modulus is not positive.
+*/
+std::vector<InfiniteInt> multiMod(const InfiniteInt& value, const std::vector<InfiniteInt>& moduli,
+                                  int numThreads = 0);
+
+#endif // NUMBERTHEORY_H
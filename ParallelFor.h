@@ -0,0 +1,71 @@
+/** 
+ * @file ParallelFor.h
+ * @brief parallelFor, which runs independent loop iterations on a set of
+ *    worker threads that claim iterations one at a time
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <algorithm>  // std::min and std::max
+#include <atomic>     // Claiming iterations
+#include <cstddef>    // std::size_t
+#include <exception>  // Passing worker failures back to the caller
+#include <stdexcept>  // std::invalid_argument
+#include <thread>     // Workers
+#include <vector>     // Worker list
+
+/** parallelFor(std::size_t, int, Function)
+ * @brief   Calls work(i) for every i from 0 to count - 1, spread across worker
+ *          threads. The calling thread is one of the workers.
+ * @param   count       The number of iterations
+ * @param   numThreads  The number of workers, or 0 to use one per hardware thread
+ * @param   work        Callable taking the iteration index
+ * @pre     Iterations are independent of each other.
+ * @post    Every iteration has run, unless one threw. In that case no new
+ *          iterations were started after the exception.
+ * @throw   std::invalid_argument if numThreads is negative, or the first
+ *          exception thrown by work.
+*/
+template <typename Function>
+void parallelFor(std::size_t count, int numThreads, Function work) {
+   if (numThreads < 0) {
+      throw std::invalid_argument("parallelFor() called with a negative thread count.");
+   }
+   if (numThreads == 0) {
+      numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+   }
+   numThreads = static_cast<int>(std::min<std::size_t>(numThreads, count));
+
+   std::atomic<std::size_t> next(0);   // next iteration no worker has claimed
+   std::atomic<bool> failed(false);    // whether failure has been set
+   std::exception_ptr failure;         // first exception thrown by work
+   auto worker = [&]() {
+      try {
+         for (std::size_t i = next++; i < count && !failed; i = next++) {
+            work(i);
+         }
+      } catch (...) {
+         if (!failed.exchange(true)) {
+            failure = std::current_exception();
+         }
+      }
+   };
+
+   std::vector<std::thread> workers;
+   for (int t = 1; t < numThreads; ++t) {
+      workers.emplace_back(worker);
+   }
+   worker();
+   for (std::thread& thread : workers) {
+      thread.join();
+   }
+
+   if (failure) {
+      std::rethrow_exception(failure);
+   }
+}
+
+#endif // PARALLELFOR_H
@@ -0,0 +1,229 @@
+/** 
+ * @file PowerCache.cpp
+ * @brief Implementation for PowerCache, a thread-safe, lazily built cache of
+ *    powers of one base (base^k and base^(2^i)) stored as InfiniteInts
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "PowerCache.h"
+
+/* Readers only load atomic pointers, so a populated cache is read without
+   locking. A missing entry is computed outside the lock, then published under
+   it; if two threads race, the first one to publish wins and the other's
+   result is simply returned uncached. Entries are never replaced or freed
+   before the cache is destroyed. */
+
+/** SharedCaches
+ * @brief   Owner of the process-wide caches returned by PowerCache::shared().
+*/
+struct SharedCaches {
+   std::atomic<PowerCache*> caches_[PowerCache::MAX_SHARED_BASE + 1];  // indexed by base
+
+   SharedCaches() {
+      for (auto& cache : caches_) {
+         cache.store(nullptr, std::memory_order_relaxed);
+      }
+   }
+
+   ~SharedCaches() {
+      for (auto& cache : caches_) {
+         delete cache.load(std::memory_order_relaxed);
+      }
+   }
+};
+
+/** PowerCache(int, long long)
+ * @brief   Constructor.
+ * @param   base              The base whose powers are cached
+ * @param   maxCachedDigits   The largest total number of digits the cache may hold
+ * @pre     base is at least 2.
+ * @post    The cache is empty. Entries are built the first time they are asked for.
+ * @throw   std::invalid_argument if base is less than 2.
+*/
+PowerCache::PowerCache(int base, long long maxCachedDigits)
+   : base_(base), maxCachedDigits_(maxCachedDigits), cachedDigits_(0) {
+   if (base < 2) {
+      throw std::invalid_argument("PowerCache base must be at least 2.");
+   }
+   for (auto& slot : direct_) {
+      slot.store(nullptr, std::memory_order_relaxed);
+   }
+   for (auto& slot : towers_) {
+      slot.store(nullptr, std::memory_order_relaxed);
+   }
+}
+
+/** ~PowerCache()
+ * @brief   Destructor.
+ * @pre     No other thread is using this cache.
+ * @post    All cached powers have been returned to the system.
+*/
+PowerCache::~PowerCache() {
+   for (auto& slot : direct_) {
+      delete slot.load(std::memory_order_relaxed);
+   }
+   for (auto& slot : towers_) {
+      delete slot.load(std::memory_order_relaxed);
+   }
+}
+
+/** shared(int)
+ * @brief   Returns the process-wide cache for a base, creating it on first use.
+ * @param   base     The base whose powers are wanted
+ * @pre     base is between 2 and MAX_SHARED_BASE.
+ * @post    Every call with the same base returns the same cache.
+ * @return  Reference to the shared cache for base.
+ * @throw   std::invalid_argument if base is out of range.
+*/
+PowerCache& PowerCache::shared(int base) {
+   static SharedCaches instances;
+
+   if (base < 2 || base > MAX_SHARED_BASE) {
+      throw std::invalid_argument("PowerCache::shared() base must be between 2 and 36.");
+   }
+
+   PowerCache* cache = instances.caches_[base].load(std::memory_order_acquire);
+   if (cache == nullptr) {
+      // Create a cache and try to install it; keep whichever one got there first
+      PowerCache* created = new PowerCache(base);
+      if (instances.caches_[base].compare_exchange_strong(cache, created, std::memory_order_acq_rel)) {
+         cache = created;
+      } else {
+         delete created;
+      }
+   }
+   return *cache;
+}
+
+/** base()
+ * @brief   Returns the base whose powers this cache holds.
+ * @return  The base of this cache.
+*/
+int PowerCache::base() const {
+   return base_;
+}
+
+/** power(int)
+ * @brief   Returns base^exponent.
+ * @param   exponent    The power to raise the base to
+ * @pre     exponent is not negative.
+ * @post    The returned InfiniteInt represents base^exponent. Small powers and
+ *          the base^(2^i) tower entries used to build large ones have been
+ *          cached if they fit in the digit budget.
+ * @return  InfiniteInt representing base^exponent.
+ * @throw   std::invalid_argument if exponent is negative.
+*/
+InfiniteInt PowerCache::power(int exponent) {
+   if (exponent < 0) {
+      throw std::invalid_argument("PowerCache::power() called with negative exponent.");
+   }
+
+   // Powers of ten are a digit shift - nothing worth caching
+   if (base_ == 10) {
+      return InfiniteInt(1).shiftLeft(exponent);
+   }
+
+   if (exponent < DIRECT_EXPONENTS) {
+      return direct(exponent);
+   }
+
+   // Large exponent: the low bits come from the direct table, the rest from the tower
+   InfiniteInt result = direct(exponent % DIRECT_EXPONENTS);
+   int level{0};
+   for (int remaining = exponent / DIRECT_EXPONENTS; remaining != 0; remaining >>= 1, ++level) {
+      if (remaining & 1) {
+         result = result * tower(level + 10);   // DIRECT_EXPONENTS == 2^10
+      }
+   }
+   return result;
+}
+
+/** tower(int)
+ * @brief   Returns base^(2^level).
+ * @param   level    The tower level
+ * @pre     level is between 0 and TOWER_LEVELS - 1.
+ * @post    The returned InfiniteInt represents base^(2^level). It and every
+ *          lower level have been cached if they fit in the digit budget.
+ * @return  InfiniteInt representing base^(2^level).
+ * @throw   std::out_of_range if level is out of range.
+*/
+InfiniteInt PowerCache::tower(int level) {
+   if (level < 0 || level >= TOWER_LEVELS) {
+      throw std::out_of_range("PowerCache::tower() level out of range.");
+   }
+
+   // Fast path: already published
+   const InfiniteInt* cached = towers_[level].load(std::memory_order_acquire);
+   if (cached != nullptr) {
+      return *cached;
+   }
+
+   // Build from the level below by squaring
+   InfiniteInt value;
+   if (base_ == 10) {
+      value = InfiniteInt(1).shiftLeft(1 << level);
+   } else if (level == 0) {
+      value = InfiniteInt(base_);
+   } else {
+      InfiniteInt below = tower(level - 1);
+      value = below * below;
+   }
+   publish(towers_[level], value);
+   return value;
+}
+
+/** cachedDigits()
+ * @brief   Returns the total number of digits currently held by this cache.
+ * @return  The number of cached digits, which never exceeds the budget.
+*/
+long long PowerCache::cachedDigits() const {
+   return cachedDigits_.load(std::memory_order_relaxed);
+}
+
+/** direct(int)
+ * @brief   Returns base^exponent for a small exponent, using the direct table.
+ * @pre     exponent is between 0 and DIRECT_EXPONENTS - 1.
+ * @return  InfiniteInt representing base^exponent.
+*/
+InfiniteInt PowerCache::direct(int exponent) {
+   // Fast path: already published
+   const InfiniteInt* cached = direct_[exponent].load(std::memory_order_acquire);
+   if (cached != nullptr) {
+      return *cached;
+   }
+
+   // Multiply together the tower entries for the set bits of exponent
+   InfiniteInt value(1);
+   for (int level = 0; (exponent >> level) != 0; ++level) {
+      if ((exponent >> level) & 1) {
+         value = value * tower(level);
+      }
+   }
+   publish(direct_[exponent], value);
+   return value;
+}
+
+/** publish(std::atomic<const InfiniteInt*>&, const InfiniteInt&)
+ * @brief   Stores a newly computed power in an empty slot, if it fits.
+ * @param   slot     The slot to fill
+ * @param   value    The power computed for that slot
+ * @post    If slot was still empty and value fits in the digit budget, slot
+ *          points to a copy of value. Otherwise nothing has changed.
+*/
+void PowerCache::publish(std::atomic<const InfiniteInt*>& slot, const InfiniteInt& value) {
+   std::lock_guard<std::mutex> guard(lock_);
+
+   // Another thread may have published while this one was computing
+   if (slot.load(std::memory_order_relaxed) != nullptr) {
+      return;
+   }
+
+   // Over budget - the caller still gets its value, it just isn't kept
+   long long newTotal = cachedDigits_.load(std::memory_order_relaxed) + value.numDigits();
+   if (newTotal > maxCachedDigits_) {
+      return;
+   }
+
+   slot.store(new InfiniteInt(value), std::memory_order_release);
+   cachedDigits_.store(newTotal, std::memory_order_relaxed);
+}
@@ -0,0 +1,118 @@
+/** 
+ * @file PowerCache.h
+ * @brief Class definition for PowerCache, a thread-safe, lazily built cache of
+ *    powers of one base (base^k and base^(2^i)) stored as InfiniteInts
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef POWERCACHE_H
+#define POWERCACHE_H
+
+#include "InfiniteInt.h" // Type of the cached powers
+#include <atomic>        // Lock-free reads of published entries
+#include <mutex>         // Serializes publishing new entries
+#include <stdexcept>     // std::invalid_argument and std::out_of_range
+
+class PowerCache {
+public:
+   static const int MAX_SHARED_BASE = 36;       // largest base with a process-wide cache
+   static const int DIRECT_EXPONENTS = 1024;    // base^k is cached for k below this
+   static const int TOWER_LEVELS = 31;          // base^(2^i) is available for i below this
+   static const long long DEFAULT_DIGIT_BUDGET = 1LL << 20;  // default limit on cached digits
+
+   //PUBLIC METHODS
+   /** PowerCache(int, long long)
+    * @brief   Constructor.
+    * @param   base              The base whose powers are cached
+    * @param   maxCachedDigits   The largest total number of digits the cache may hold
+    * @pre     base is at least 2.
+    * @post    The cache is empty. Entries are built the first time they are asked for.
+    * @throw   std::invalid_argument if base is less than 2.
+   */
+   explicit PowerCache(int base, long long maxCachedDigits = DEFAULT_DIGIT_BUDGET);
+
+   /** ~PowerCache()
+    * @brief   Destructor.
+    * @pre     No other thread is using this cache.
+    * @post    All cached powers have been returned to the system.
+   */
+   ~PowerCache();
+
+   // Entries are shared by pointer between threads, so the cache cannot be copied
+   PowerCache(const PowerCache&) = delete;
+   PowerCache& operator=(const PowerCache&) = delete;
+
+   /** shared(int)
+    * @brief   Returns the process-wide cache for a base, creating it on first use.
+    * @param   base     The base whose powers are wanted
+    * @pre     base is between 2 and MAX_SHARED_BASE.
+    * @post    Every call with the same base returns the same cache.
+    * @return  Reference to the shared cache for base.
+    * @throw   std::invalid_argument if base is out of range.
+   */
+   static PowerCache& shared(int base);
+
+   /** base()
+    * @brief   Returns the base whose powers this cache holds.
+    * @return  The base of this cache.
+   */
+   int base() const;
+
+   /** power(int)
+    * @brief   Returns base^exponent.
+    * @param   exponent    The power to raise the base to
+    * @pre     exponent is not negative.
+    * @post    The returned InfiniteInt represents base^exponent. Small powers and
+    *          the base^(2^i) tower entries used to build large ones have been
+    *          cached if they fit in the digit budget.
+    * @return  InfiniteInt representing base^exponent.
+    * @throw   std::invalid_argument if exponent is negative.
+   */
+   InfiniteInt power(int exponent);
+
+   /** tower(int)
+    * @brief   Returns base^(2^level).
+    * @param   level    The tower level
+    * @pre     level is between 0 and TOWER_LEVELS - 1.
+    * @post    The returned InfiniteInt represents base^(2^level). It and every
+    *          lower level have been cached if they fit in the digit budget.
+    * @return  InfiniteInt representing base^(2^level).
+    * @throw   std::out_of_range if level is out of range.
+   */
+   InfiniteInt tower(int level);
+
+   /** cachedDigits()
+    * @brief   Returns the total number of digits currently held by this cache.
+    * @return  The number of cached digits, which never exceeds the budget.
+   */
+   long long cachedDigits() const;
+
+private:
+   // DATA MEMBERS
+   const int base_;                  // base whose powers are cached
+   const long long maxCachedDigits_; // limit on cachedDigits_
+   std::mutex lock_;                 // held while publishing an entry
+   std::atomic<long long> cachedDigits_;  // total digits in published entries
+   std::atomic<const InfiniteInt*> direct_[DIRECT_EXPONENTS];  // base^k, or null if not built
+   std::atomic<const InfiniteInt*> towers_[TOWER_LEVELS];      // base^(2^i), or null if not built
+
+   // PRIVATE FUNCTIONS
+   /** direct(int)
+    * @brief   Returns base^exponent for a small exponent, using the direct table.
+    * @pre     exponent is between 0 and DIRECT_EXPONENTS - 1.
+    * @return  InfiniteInt representing base^exponent.
+   */
+   InfiniteInt direct(int exponent);
+
+   /** publish(std::atomic<const InfiniteInt*>&, const InfiniteInt&)
+    * @brief   Stores a newly computed power in an empty slot, if it fits.
+    * @param   slot     The slot to fill
+    * @param   value    The power computed for that slot
+    * @post    If slot was still empty and value fits in the digit budget, slot
+    *          points to a copy of value. Otherwise nothing has changed.
+   */
+   void publish(std::atomic<const InfiniteInt*>& slot, const InfiniteInt& value);
+};
+
+#endif // POWERCACHE_H
@@ -0,0 +1,135 @@
+/** 
+ * @file ProductTree.cpp
+ * @brief Implementation for ProductTree, a binary tree of partial products
+ *    of a list of InfiniteInts, built level by level, that can also reduce a
+ *    value modulo every leaf as a remainder tree
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "ProductTree.h"
+#include "ParallelFor.h"  // Building the nodes of a level in parallel
+#include <utility>        // std::move
+
+/** ProductTree(const std::vector<InfiniteInt>&, int)
+ * @brief   Constructor. Level 0 holds the values; each node of level i + 1 is
+ *          the product of two neighbouring nodes of level i, and an unpaired
+ *          last node is carried up unchanged. The nodes of each level are
+ *          multiplied in parallel.
+ * @param   values      The leaves of the tree
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     values is not empty and numThreads is not negative.
+ * @post    The top level holds one node, the product of all values.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+ProductTree::ProductTree(const std::vector<InfiniteInt>& values, int numThreads)
+   : levels_(1, values), numThreads_(numThreads) {
+   if (values.empty()) {
+      throw std::invalid_argument("ProductTree needs at least one value.");
+   }
+   if (numThreads < 0) {
+      throw std::invalid_argument("ProductTree called with a negative thread count.");
+   }
+
+   while (levels_.back().size() > 1) {
+      std::vector<InfiniteInt> above = productLevel(levels_.back(), numThreads_);
+      levels_.push_back(std::move(above));
+   }
+}
+
+/** root()
+ * @brief   Returns the product of all the values.
+*/
+const InfiniteInt& ProductTree::root() const {
+   return levels_.back().front();
+}
+
+/** numLevels()
+ * @brief   Returns the number of levels, counting the leaves and the root.
+*/
+int ProductTree::numLevels() const {
+   return static_cast<int>(levels_.size());
+}
+
+/** level(int)
+ * @brief   Returns the nodes of one level.
+ * @param   index    The level, 0 for the leaves and numLevels() - 1 for the root
+ * @return  Reference to the nodes of that level, left to right.
+ * @throw   std::out_of_range if index is not a level.
+*/
+const std::vector<InfiniteInt>& ProductTree::level(int index) const {
+   if (index < 0 || index >= numLevels()) {
+      throw std::out_of_range("ProductTree::level() index out of range.");
+   }
+   return levels_[index];
+}
+
+/** remainders(const InfiniteInt&)
+ * @brief   Reduces a value modulo every leaf with a remainder tree: the value is
+ *          reduced modulo the root, then each node's remainder is reduced
+ *          modulo its children, so every division works on numbers about the
+ *          size of the node rather than the size of the value. The nodes of
+ *          each level are reduced in parallel.
+ * @param   value    The InfiniteInt to reduce
+ * @pre     Every leaf is positive.
+ * @post    Entry i is value mod level(0)[i], between 0 and level(0)[i] - 1.
+ * @return  The residues, in the same order as the leaves.
+ * @throw   std::domain_error if a leaf is zero.
+*/
+std::vector<InfiniteInt> ProductTree::remainders(const InfiniteInt& value) const {
+   std::vector<InfiniteInt> current(1, value % root());
+   for (std::size_t level = levels_.size() - 1; level-- > 0; ) {
+      current = remainderLevel(current, levels_[level], numThreads_);
+   }
+
+   // Truncating division leaves negative values with negative remainders
+   for (std::size_t i = 0; i < current.size(); ++i) {
+      if (current[i] < InfiniteInt(0)) {
+         current[i] = current[i] + levels_[0][i];
+      }
+   }
+   return current;
+}
+
+/** numThreads()
+ * @brief   Returns the thread count the tree was built with.
+*/
+int ProductTree::numThreads() const {
+   return numThreads_;
+}
+
+/** productLevel(const std::vector<InfiniteInt>&, int)
+ * @brief   Returns the level above a level of a product tree: node k is the
+ *          product of nodes 2k and 2k + 1 below, and an unpaired last node is
+ *          carried up unchanged. The nodes are multiplied in parallel.
+ * @param   below       The nodes of one level
+ * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+ * @pre     below is not empty and numThreads is not negative.
+ * @return  The nodes of the level above, half as many rounded up.
+*/
+std::vector<InfiniteInt> ProductTree::productLevel(const std::vector<InfiniteInt>& below, int numThreads) {
+   std::vector<InfiniteInt> above((below.size() + 1) / 2);
+   parallelFor(above.size(), numThreads, [&](std::size_t k) {
+      above[k] = 2 * k + 1 < below.size() ? below[2 * k] * below[2 * k + 1] : below[2 * k];
+   });
+   return above;
+}
+
+/** remainderLevel(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, int)
+ * @brief   Takes one step down a remainder tree: entry k is the remainder of
+ *          node k's parent reduced modulo node k. The nodes are reduced in parallel.
+ * @param   parentRemainders  The remainders of the level above
+ * @param   moduli            The nodes of this level (or values derived from
+ *                            them, such as their squares)
+ * @param   numThreads        The number of worker threads, or 0 to use one per hardware thread
+ * @pre     parentRemainders has (moduli.size() + 1) / 2 entries and no modulus is zero.
+ * @return  parentRemainders[k / 2] % moduli[k] for every k, truncating like operator%.
+ * @throw   std::domain_error if a modulus is zero.
+*/
+std::vector<InfiniteInt> ProductTree::remainderLevel(const std::vector<InfiniteInt>& parentRemainders,
+                                                     const std::vector<InfiniteInt>& moduli, int numThreads) {
+   std::vector<InfiniteInt> next(moduli.size());
+   parallelFor(moduli.size(), numThreads, [&](std::size_t k) {
+      next[k] = parentRemainders[k / 2] % moduli[k];
+   });
+   return next;
+}
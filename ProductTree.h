@@ -0,0 +1,101 @@
+/** 
+ * @file ProductTree.h
+ * @brief Class definition for ProductTree, a binary tree of partial products
+ *    of a list of InfiniteInts, built level by level, that can also reduce a
+ *    value modulo every leaf as a remainder tree
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef PRODUCTTREE_H
+#define PRODUCTTREE_H
+
+#include "InfiniteInt.h" // Type of the values and products
+#include <stdexcept>     // std::invalid_argument, std::out_of_range and std::domain_error
+#include <vector>        // Tree levels
+
+class ProductTree {
+public:
+   //PUBLIC METHODS
+   /** ProductTree(const std::vector<InfiniteInt>&, int)
+    * @brief   Constructor. Level 0 holds the values; each node of level i + 1 is
+    *          the product of two neighbouring nodes of level i, and an unpaired
+    *          last node is carried up unchanged. The nodes of each level are
+    *          multiplied in parallel.
+    * @param   values      The leaves of the tree
+    * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+    * @pre     values is not empty and numThreads is not negative.
+    * @post    The top level holds one node, the product of all values.
+    * @throw   std::invalid_argument if the preconditions are not met.
+   */
+   explicit ProductTree(const std::vector<InfiniteInt>& values, int numThreads = 0);
+
+   /** root()
+    * @brief   Returns the product of all the values.
+   */
+   const InfiniteInt& root() const;
+
+   /** numLevels()
+    * @brief   Returns the number of levels, counting the leaves and the root.
+   */
+   int numLevels() const;
+
+   /** level(int)
+    * @brief   Returns the nodes of one level.
+    * @param   index    The level, 0 for the leaves and numLevels() - 1 for the root
+    * @return  Reference to the nodes of that level, left to right.
+    * @throw   std::out_of_range if index is not a level.
+   */
+   const std::vector<InfiniteInt>& level(int index) const;
+
+   /** remainders(const InfiniteInt&)
+    * @brief   Reduces a value modulo every leaf with a remainder tree: the value is
+    *          reduced modulo the root, then each node's remainder is reduced
+    *          modulo its children, so every division works on numbers about the
+    *          size of the node rather than the size of the value. The nodes of
+    *          each level are reduced in parallel.
+    * @param   value    The InfiniteInt to reduce
+    * @pre     Every leaf is positive.
+    * @post    Entry i is value mod level(0)[i], between 0 and level(0)[i] - 1.
+    * @return  The residues, in the same order as the leaves.
+    * @throw   std::domain_error if a leaf is zero.
+   */
+   std::vector<InfiniteInt> remainders(const InfiniteInt& value) const;
+
+   /** numThreads()
+    * @brief   Returns the thread count the tree was built with.
+   */
+   int numThreads() const;
+
+   /** productLevel(const std::vector<InfiniteInt>&, int)
+    * @brief   Returns the level above a level of a product tree: node k is the
+    *          product of nodes 2k and 2k + 1 below, and an unpaired last node is
+    *          carried up unchanged. The nodes are multiplied in parallel.
+    * @param   below       The nodes of one level
+    * @param   numThreads  The number of worker threads, or 0 to use one per hardware thread
+    * @pre     below is not empty and numThreads is not negative.
+    * @return  The nodes of the level above, half as many rounded up.
+   */
+   static std::vector<InfiniteInt> productLevel(const std::vector<InfiniteInt>& below, int numThreads);
+
+   /** remainderLevel(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, int)
+    * @brief   Takes one step down a remainder tree: entry k is the remainder of
+    *          node k's parent reduced modulo node k. The nodes are reduced in parallel.
+    * @param   parentRemainders  The remainders of the level above
+    * @param   moduli            The nodes of this level (or values derived from
+    *                            them, such as their squares)
+    * @param   numThreads        The number of worker threads, or 0 to use one per hardware thread
+    * @pre     parentRemainders has (moduli.size() + 1) / 2 entries and no modulus is zero.
+    * @return  parentRemainders[k / 2] % moduli[k] for every k, truncating like operator%.
+    * @throw   std::domain_error if a modulus is zero.
+   */
+   static std::vector<InfiniteInt> remainderLevel(const std::vector<InfiniteInt>& parentRemainders,
+                                                  const std::vector<InfiniteInt>& moduli, int numThreads);
+
+private:
+   // DATA MEMBERS
+   std::vector<std::vector<InfiniteInt>> levels_;  // levels_[0] are the leaves, levels_.back() the root
+   int numThreads_;                                 // thread count used to build levels
+};
+
+#endif // PRODUCTTREE_H
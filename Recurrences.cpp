@@ -0,0 +1,270 @@
+/** 
+ * @file Recurrences.cpp
+ * @brief Fast evaluation of Fibonacci numbers, Lucas numbers and general
+ *    linear recurrences at large indices, exactly or modulo a ModContext
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "Recurrences.h"
+
+// PRIVATE FUNCTIONS
+
+/** ExactArithmetic
+ * @brief   Plain InfiniteInt arithmetic, so that the same doubling and
+ *          polynomial code serves both the exact and the modular variants.
+*/
+struct ExactArithmetic {
+   InfiniteInt reduce(const InfiniteInt& value) const { return value; }
+   InfiniteInt add(const InfiniteInt& lhs, const InfiniteInt& rhs) const { return lhs + rhs; }
+   InfiniteInt subtract(const InfiniteInt& lhs, const InfiniteInt& rhs) const { return lhs - rhs; }
+   InfiniteInt multiply(const InfiniteInt& lhs, const InfiniteInt& rhs) const { return lhs * rhs; }
+};
+
+/** checkIndex(long long)
+ * @brief   Throws std::invalid_argument if the index n is negative.
+*/
+static void checkIndex(long long n) {
+   if (n < 0) {
+      throw std::invalid_argument("Recurrence index must not be negative.");
+   }
+}
+
+/** highestBit(long long)
+ * @brief   Returns the highest set bit of a positive n.
+*/
+static unsigned long long highestBit(long long n) {
+   unsigned long long bit = 1;
+   while (bit <= static_cast<unsigned long long>(n) / 2) {
+      bit <<= 1;
+   }
+   return bit;
+}
+
+/** fibonacciPair(long long, const Arithmetic&, InfiniteInt&, InfiniteInt&)
+ * @brief   Sets current to F(n) and next to F(n+1) by fast doubling, scanning
+ *          the bits of n from the top.
+*/
+template <typename Arithmetic>
+static void fibonacciPair(long long n, const Arithmetic& arithmetic,
+                          InfiniteInt& current, InfiniteInt& next) {
+   current = arithmetic.reduce(InfiniteInt(0));
+   next = arithmetic.reduce(InfiniteInt(1));
+   if (n == 0) {
+      return;
+   }
+   for (unsigned long long bit = highestBit(n); bit != 0; bit >>= 1) {
+      // F(2k) = F(k)(2F(k+1) - F(k)),  F(2k+1) = F(k)^2 + F(k+1)^2
+      InfiniteInt doubled = arithmetic.multiply(current,
+         arithmetic.subtract(arithmetic.add(next, next), current));
+      InfiniteInt doubledPlusOne = arithmetic.add(arithmetic.multiply(current, current),
+                                                  arithmetic.multiply(next, next));
+      if (static_cast<unsigned long long>(n) & bit) {
+         current = doubledPlusOne;
+         next = arithmetic.add(doubled, doubledPlusOne);
+      } else {
+         current = doubled;
+         next = doubledPlusOne;
+      }
+   }
+}
+
+/** lucasNumber(long long, const Arithmetic&)
+ * @brief   Returns L(n) = 2F(n+1) - F(n).
+*/
+template <typename Arithmetic>
+static InfiniteInt lucasNumber(long long n, const Arithmetic& arithmetic) {
+   InfiniteInt current;
+   InfiniteInt next;
+   fibonacciPair(n, arithmetic, current, next);
+   return arithmetic.subtract(arithmetic.add(next, next), current);
+}
+
+/** reduceByRecurrence(std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, const Arithmetic&)
+ * @brief   Reduces poly (coefficients lowest degree first) modulo the
+ *          characteristic polynomial x^k - coeffs[0] x^(k-1) - ... - coeffs[k-1],
+ *          leaving k coefficients.
+*/
+template <typename Arithmetic>
+static void reduceByRecurrence(std::vector<InfiniteInt>& poly, const std::vector<InfiniteInt>& coeffs,
+                               const Arithmetic& arithmetic) {
+   std::size_t order = coeffs.size();
+   for (std::size_t degree = poly.size() - 1; degree >= order; --degree) {
+      // x^degree = sum of coeffs[i] x^(degree-1-i)
+      if (!(poly[degree] == InfiniteInt(0))) {
+         for (std::size_t i = 0; i < order; ++i) {
+            poly[degree - 1 - i] = arithmetic.add(poly[degree - 1 - i],
+                                                  arithmetic.multiply(poly[degree], coeffs[i]));
+         }
+      }
+   }
+   poly.resize(order);
+}
+
+/** squarePolynomial(const std::vector<InfiniteInt>&, const Arithmetic&)
+ * @brief   Returns poly^2, computing each cross product once and doubling it
+ *          (roughly half the multiplications of a general product).
+*/
+template <typename Arithmetic>
+static std::vector<InfiniteInt> squarePolynomial(const std::vector<InfiniteInt>& poly,
+                                                 const Arithmetic& arithmetic) {
+   std::size_t size = poly.size();
+   std::vector<InfiniteInt> cross(2 * size - 1, arithmetic.reduce(InfiniteInt(0)));
+   for (std::size_t i = 0; i < size; ++i) {
+      for (std::size_t j = i + 1; j < size; ++j) {
+         cross[i + j] = arithmetic.add(cross[i + j], arithmetic.multiply(poly[i], poly[j]));
+      }
+   }
+   for (std::size_t i = 0; i < cross.size(); ++i) {
+      cross[i] = arithmetic.add(cross[i], cross[i]);
+   }
+   for (std::size_t i = 0; i < size; ++i) {
+      cross[2 * i] = arithmetic.add(cross[2 * i], arithmetic.multiply(poly[i], poly[i]));
+   }
+   return cross;
+}
+
+/** recurrenceTerm(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, long long, const Arithmetic&)
+ * @brief   Returns term n of the recurrence, by computing x^n modulo its
+ *          characteristic polynomial and dotting the remainder with init.
+ * @throw   std::invalid_argument if coeffs and init are empty or differ in size,
+ *          or n is negative.
+*/
+template <typename Arithmetic>
+static InfiniteInt recurrenceTerm(const std::vector<InfiniteInt>& coeffs, const std::vector<InfiniteInt>& init,
+                                  long long n, const Arithmetic& arithmetic) {
+   if (coeffs.empty() || coeffs.size() != init.size()) {
+      throw std::invalid_argument("Recurrence needs as many initial terms as coefficients.");
+   }
+   checkIndex(n);
+   std::size_t order = coeffs.size();
+   if (static_cast<unsigned long long>(n) < order) {
+      return arithmetic.reduce(init[static_cast<std::size_t>(n)]);
+   }
+
+   std::vector<InfiniteInt> reducedCoeffs;
+   for (std::size_t i = 0; i < order; ++i) {
+      reducedCoeffs.push_back(arithmetic.reduce(coeffs[i]));
+   }
+
+   // power holds x^e mod the characteristic polynomial, for e the bits of n seen so far
+   std::vector<InfiniteInt> power(1, arithmetic.reduce(InfiniteInt(1)));
+   for (unsigned long long bit = highestBit(n); bit != 0; bit >>= 1) {
+      power = squarePolynomial(power, arithmetic);
+      if (static_cast<unsigned long long>(n) & bit) {
+         power.insert(power.begin(), arithmetic.reduce(InfiniteInt(0)));
+      }
+      if (power.size() > order) {
+         reduceByRecurrence(power, reducedCoeffs, arithmetic);
+      }
+   }
+
+   InfiniteInt result = arithmetic.reduce(InfiniteInt(0));
+   for (std::size_t i = 0; i < power.size(); ++i) {
+      result = arithmetic.add(result, arithmetic.multiply(power[i], arithmetic.reduce(init[i])));
+   }
+   return result;
+}
+
+// FIBONACCI AND LUCAS NUMBERS
+
+/** fibonacci(long long)
+ * @brief   Computes the nth Fibonacci number by fast doubling:
+ *          F(2k) = F(k)(2F(k+1) - F(k)) and F(2k+1) = F(k)^2 + F(k+1)^2,
+ *          so only O(log n) multiplications are needed.
+ * @param   n        The index of the Fibonacci number, with F(0) = 0 and F(1) = 1
+ * @pre     n is not negative.
+ * @return  InfiniteInt representing F(n).
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt fibonacci(long long n) {
+   checkIndex(n);
+   InfiniteInt current;
+   InfiniteInt next;
+   fibonacciPair(n, ExactArithmetic(), current, next);
+   return current;
+}
+
+/** fibonacci(long long, const ModContext&)
+ * @brief   Computes the nth Fibonacci number mod the context's modulus by fast
+ *          doubling, reducing after every multiplication.
+ * @param   n        The index of the Fibonacci number, with F(0) = 0 and F(1) = 1
+ * @param   mod      The modulus the result is reduced by
+ * @pre     n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing F(n) mod modulus.
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt fibonacci(long long n, const ModContext& mod) {
+   checkIndex(n);
+   InfiniteInt current;
+   InfiniteInt next;
+   fibonacciPair(n, mod, current, next);
+   return current;
+}
+
+/** lucas(long long)
+ * @brief   Computes the nth Lucas number as L(n) = 2F(n+1) - F(n), with both
+ *          Fibonacci numbers coming out of the same fast-doubling pass.
+ * @param   n        The index of the Lucas number, with L(0) = 2 and L(1) = 1
+ * @pre     n is not negative.
+ * @return  InfiniteInt representing L(n).
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt lucas(long long n) {
+   checkIndex(n);
+   return lucasNumber(n, ExactArithmetic());
+}
+
+/** lucas(long long, const ModContext&)
+ * @brief   Computes the nth Lucas number mod the context's modulus.
+ * @param   n        The index of the Lucas number, with L(0) = 2 and L(1) = 1
+ * @param   mod      The modulus the result is reduced by
+ * @pre     n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing L(n) mod modulus.
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt lucas(long long n, const ModContext& mod) {
+   checkIndex(n);
+   return lucasNumber(n, mod);
+}
+
+// LINEAR RECURRENCES
+
+/** linearRecurrence(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, long long)
+ * @brief   Computes term n of the recurrence
+ *          a(j) = coeffs[0] a(j-1) + coeffs[1] a(j-2) + ... + coeffs[k-1] a(j-k),
+ *          starting from a(0..k-1) = init. x^n is raised to the nth power modulo
+ *          the characteristic polynomial by repeated squaring (Fiduccia's method,
+ *          k^2 multiplications per step rather than the k^3 of squaring the
+ *          k-by-k companion matrix), and a(n) is the remainder's coefficients
+ *          dotted with init.
+ * @param   coeffs   The recurrence coefficients, most recent term first
+ * @param   init     The first k terms
+ * @param   n        The index of the term to compute
+ * @pre     coeffs and init have the same, nonzero size and n is not negative.
+ * @return  InfiniteInt representing a(n).
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt linearRecurrence(const std::vector<InfiniteInt>& coeffs,
+                             const std::vector<InfiniteInt>& init, long long n) {
+   return recurrenceTerm(coeffs, init, n, ExactArithmetic());
+}
+
+/** linearRecurrence(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, long long, const ModContext&)
+ * @brief   Computes term n of the recurrence mod the context's modulus, reducing
+ *          after every multiplication.
+ * @param   coeffs   The recurrence coefficients, most recent term first
+ * @param   init     The first k terms
+ * @param   n        The index of the term to compute
+ * @param   mod      The modulus the result is reduced by
+ * @pre     coeffs and init have the same, nonzero size and n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing a(n) mod modulus.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt linearRecurrence(const std::vector<InfiniteInt>& coeffs,
+                             const std::vector<InfiniteInt>& init, long long n,
+                             const ModContext& mod) {
+   return recurrenceTerm(coeffs, init, n, mod);
+}
@@ -0,0 +1,99 @@
+/** 
+ * @file Recurrences.h
+ * @brief Fast evaluation of Fibonacci numbers, Lucas numbers and general
+ *    linear recurrences at large indices, exactly or modulo a ModContext
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef RECURRENCES_H
+#define RECURRENCES_H
+
+#include "InfiniteInt.h" // Type of the terms
+#include "ModContext.h"  // Modulus for the modular variants
+#include <stdexcept>     // std::invalid_argument
+#include <vector>        // Recurrence coefficients and initial terms
+
+// FIBONACCI AND LUCAS NUMBERS
+
+/** fibonacci(long long)
+ * @brief   Computes the nth Fibonacci number by fast doubling:
+ *          F(2k) = F(k)(2F(k+1) - F(k)) and F(2k+1) = F(k)^2 + F(k+1)^2,
+ *          so only O(log n) multiplications are needed.
+ * @param   n        The index of the Fibonacci number, with F(0) = 0 and F(1) = 1
+ * @pre     n is not negative.
+ * @return  InfiniteInt representing F(n).
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt fibonacci(long long n);
+
+/** fibonacci(long long, const ModContext&)
+ * @brief   Computes the nth Fibonacci number mod the context's modulus by fast
+ *          doubling, reducing after every multiplication.
+ * @param   n        The index of the Fibonacci number, with F(0) = 0 and F(1) = 1
+ * @param   mod      The modulus the result is reduced by
+ * @pre     n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing F(n) mod modulus.
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt fibonacci(long long n, const ModContext& mod);
+
+/** lucas(long long)
+ * @brief   Computes the nth Lucas number as L(n) = 2F(n+1) - F(n), with both
+ *          Fibonacci numbers coming out of the same fast-doubling pass.
+ * @param   n        The index of the Lucas number, with L(0) = 2 and L(1) = 1
+ * @pre     n is not negative.
+ * @return  InfiniteInt representing L(n).
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt lucas(long long n);
+
+/** lucas(long long, const ModContext&)
+ * @brief   Computes the nth Lucas number mod the context's modulus.
+ * @param   n        The index of the Lucas number, with L(0) = 2 and L(1) = 1
+ * @param   mod      The modulus the result is reduced by
+ * @pre     n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing L(n) mod modulus.
+ * @throw   std::invalid_argument if n is negative.
+*/
+InfiniteInt lucas(long long n, const ModContext& mod);
+
+// LINEAR RECURRENCES
+
+/** linearRecurrence(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, long long)
+ * @brief   Computes term n of the recurrence
+ *          a(j) = coeffs[0] a(j-1) + coeffs[1] a(j-2) + ... + coeffs[k-1] a(j-k),
+ *          starting from a(0..k-1) = init. x^n is raised to the nth power modulo
+ *          the characteristic polynomial by repeated squaring (Fiduccia's method,
+ *          k^2 multiplications per step rather than the k^3 of squaring the
+ *          k-by-k companion matrix), and a(n) is the remainder's coefficients
+ *          dotted with init.
+ * @param   coeffs   The recurrence coefficients, most recent term first
+ * @param   init     The first k terms
+ * @param   n        The index of the term to compute
+ * @pre     coeffs and init have the same, nonzero size and n is not negative.
+ * @return  InfiniteInt representing a(n).
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt linearRecurrence(const std::vector<InfiniteInt>& coeffs,
+                             const std::vector<InfiniteInt>& init, long long n);
+
+/** linearRecurrence(const std::vector<InfiniteInt>&, const std::vector<InfiniteInt>&, long long, const ModContext&)
+ * @brief   Computes term n of the recurrence mod the context's modulus, reducing
+ *          after every multiplication.
+ * @param   coeffs   The recurrence coefficients, most recent term first
+ * @param   init     The first k terms
+ * @param   n        The index of the term to compute
+ * @param   mod      The modulus the result is reduced by
+ * @pre     coeffs and init have the same, nonzero size and n is not negative.
+ * @post    The returned value is between 0 and modulus - 1.
+ * @return  InfiniteInt representing a(n) mod modulus.
+ * @throw   std::invalid_argument if the preconditions are not met.
+*/
+InfiniteInt linearRecurrence(const std::vector<InfiniteInt>& coeffs,
+                             const std::vector<InfiniteInt>& init, long long n,
+                             const ModContext& mod);
+
+#endif // RECURRENCES_H
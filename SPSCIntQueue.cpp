@@ -0,0 +1,228 @@
+/** 
+ * @file SPSCIntQueue.cpp
+ * @brief Implementation for SPSCIntQueue, a bounded, wait-free queue of integers
+ *    shared by exactly one producer thread and one consumer thread
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "SPSCIntQueue.h"
+
+/** SPSCIntQueue(int)
+ * @brief   Constructor.
+ * @param   minCapacity    The minimum number of entries the queue must hold
+ * @pre     minCapacity is greater than 0.
+ * @post    This queue is empty and can hold at least minCapacity entries.
+ *          The capacity is rounded up to a power of two.
+ * @throw   std::invalid_argument if minCapacity is less than 1 or too large.
+*/
+SPSCIntQueue::SPSCIntQueue(int minCapacity)
+   : buffer_(nullptr), mask_(0), head_(0), cachedTail_(0), tail_(0), cachedHead_(0) {
+   if (minCapacity < 1 || minCapacity > (1 << 30)) {
+      throw std::invalid_argument("SPSCIntQueue capacity must be between 1 and 2^30.");
+   }
+
+   // Round the capacity up to a power of two so indices can be masked
+   unsigned capacity{1};
+   while (capacity < static_cast<unsigned>(minCapacity)) {
+      capacity <<= 1;
+   }
+   mask_ = capacity - 1;
+   buffer_ = new int[capacity];
+}
+
+/** ~SPSCIntQueue()
+ * @brief   Destructor.
+ * @pre     Neither the producer nor the consumer is using this queue.
+ * @post    All dynamically allocated memory has been returned to the system.
+*/
+SPSCIntQueue::~SPSCIntQueue() {
+   delete[] buffer_;
+   buffer_ = nullptr;
+}
+
+/** pushBack(int)
+ * @brief   Adds an integer to the back of this queue.
+ * @param   newItem  The integer being added to this queue.
+ * @post    newItem has been added to the back of this queue.
+ * @throw   std::overflow_error if this queue is full.
+*/
+void SPSCIntQueue::pushBack(int newItem) {
+   if (!tryPushBack(newItem)) {
+      throw std::overflow_error("SPSCIntQueue::pushBack() called on full queue.");
+   }
+}
+
+/** tryPushBack(int)
+ * @brief   Adds an integer to the back of this queue if there is room.
+ * @param   newItem  The integer being added to this queue.
+ * @post    If this queue was not full, newItem has been added to its back.
+ * @return  True if newItem was added and false if this queue was full.
+*/
+bool SPSCIntQueue::tryPushBack(int newItem) {
+   if (freeSlots(1) == 0) {
+      return false;
+   }
+
+   // Only the producer writes tail_, so a relaxed load is enough
+   unsigned tail = tail_.load(std::memory_order_relaxed);
+   buffer_[tail & mask_] = newItem;
+   tail_.store(tail + 1, std::memory_order_release);  // publish the entry
+   return true;
+}
+
+/** pushBack(const int*, int)
+ * @brief   Adds as many integers from an array as fit to the back of this queue.
+ * @param   items    The integers being added, ordered from first to last
+ * @param   count    The number of integers in items
+ * @post    The first n entries of items have been added to the back of this
+ *          queue in order, where n is the returned value. The consumer sees
+ *          all n at once.
+ * @return  The number of integers added, which may be less than count.
+*/
+int SPSCIntQueue::pushBack(const int* items, int count) {
+   if (count <= 0) {
+      return 0;
+   }
+
+   unsigned available = freeSlots(static_cast<unsigned>(count));
+   unsigned toPush = static_cast<unsigned>(count) < available ? static_cast<unsigned>(count) : available;
+   unsigned tail = tail_.load(std::memory_order_relaxed);
+
+   // Fill the slots, then publish them all with a single store
+   for (unsigned i = 0; i < toPush; ++i) {
+      buffer_[(tail + i) & mask_] = items[i];
+   }
+   tail_.store(tail + toPush, std::memory_order_release);
+   return static_cast<int>(toPush);
+}
+
+/** front()
+ * @brief   Returns the first integer in this queue.
+ * @pre     There is at least one integer in this queue.
+ * @post    The returned value is equal to the first integer in this queue.
+ * @return  The first integer in this queue.
+ * @throw   std::logic_error if this queue is empty.
+*/
+int SPSCIntQueue::front() const {
+   unsigned head = head_.load(std::memory_order_relaxed);
+   if (tail_.load(std::memory_order_acquire) == head) {
+      throw std::logic_error("SPSCIntQueue::front() called on empty queue.");
+   }
+
+   return buffer_[head & mask_];
+}
+
+/** popFront()
+ * @brief   Removes one integer from the front of this queue.
+ * @post    The first integer in this queue has been removed.
+ * @throw   std::logic_error if this queue is empty.
+*/
+void SPSCIntQueue::popFront() {
+   int discarded;  // the removed entry, which the caller does not want
+   if (!tryPopFront(discarded)) {
+      throw std::logic_error("SPSCIntQueue::popFront() called on empty queue.");
+   }
+}
+
+/** tryPopFront(int&)
+ * @brief   Removes one integer from the front of this queue if there is one.
+ * @param   item     Set to the removed integer
+ * @post    If this queue was not empty, its first integer has been removed
+ *          and stored in item. Otherwise item is unchanged.
+ * @return  True if an integer was removed and false if this queue was empty.
+*/
+bool SPSCIntQueue::tryPopFront(int& item) {
+   if (readySlots(1) == 0) {
+      return false;
+   }
+
+   // Only the consumer writes head_, so a relaxed load is enough
+   unsigned head = head_.load(std::memory_order_relaxed);
+   item = buffer_[head & mask_];
+   head_.store(head + 1, std::memory_order_release);  // hand the slot back
+   return true;
+}
+
+/** popFront(int*, int)
+ * @brief   Removes up to maxCount integers from the front of this queue.
+ * @param   items       Array the removed integers are stored in, in order
+ * @param   maxCount    The largest number of integers to remove
+ * @post    The first n integers in this queue have been removed and stored in
+ *          items, where n is the returned value.
+ * @return  The number of integers removed, which may be less than maxCount.
+*/
+int SPSCIntQueue::popFront(int* items, int maxCount) {
+   if (maxCount <= 0) {
+      return 0;
+   }
+
+   unsigned available = readySlots(static_cast<unsigned>(maxCount));
+   unsigned toPop = static_cast<unsigned>(maxCount) < available ? static_cast<unsigned>(maxCount) : available;
+   unsigned head = head_.load(std::memory_order_relaxed);
+
+   // Read the entries, then release all of their slots with a single store
+   for (unsigned i = 0; i < toPop; ++i) {
+      items[i] = buffer_[(head + i) & mask_];
+   }
+   head_.store(head + toPop, std::memory_order_release);
+   return static_cast<int>(toPop);
+}
+
+/** numEntries()
+ * @brief   Returns the number of entries in this queue.
+ * @post    The returned value is between 0 and capacity(). While the other
+ *          thread is active it is only an estimate and may be stale by the
+ *          time the caller uses it.
+ * @return  The number of entries in this queue.
+*/
+int SPSCIntQueue::numEntries() const {
+   // Read head first so the difference is never negative. The consumer may pop
+   // and the producer push between the two loads, so clamp to the capacity.
+   unsigned head = head_.load(std::memory_order_acquire);
+   unsigned tail = tail_.load(std::memory_order_acquire);
+   unsigned count = tail - head;
+   return static_cast<int>(count < mask_ + 1 ? count : mask_ + 1);
+}
+
+/** capacity()
+ * @brief   Returns the largest number of entries this queue can hold.
+ * @return  The capacity of this queue.
+*/
+int SPSCIntQueue::capacity() const {
+   return static_cast<int>(mask_ + 1);
+}
+
+/** freeSlots(unsigned)
+ * @brief   Producer helper. Returns the number of slots that can be filled.
+ * @param   wanted   The number of slots the producer would like to fill
+ * @post    cachedHead_ has been refreshed if the cached value showed fewer
+ *          than wanted free slots.
+ * @return  The number of free slots.
+*/
+unsigned SPSCIntQueue::freeSlots(unsigned wanted) {
+   unsigned tail = tail_.load(std::memory_order_relaxed);
+   unsigned capacity = mask_ + 1;
+
+   // Only touch the consumer's cache line when the cached head shows too little room
+   if (capacity - (tail - cachedHead_) < wanted) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+   }
+   return capacity - (tail - cachedHead_);
+}
+
+/** readySlots(unsigned)
+ * @brief   Consumer helper. Returns the number of entries that can be removed.
+ * @param   wanted   The number of entries the consumer would like to remove
+ * @post    cachedTail_ has been refreshed if the cached value showed fewer
+ *          than wanted entries.
+ * @return  The number of filled slots.
+*/
+unsigned SPSCIntQueue::readySlots(unsigned wanted) {
+   unsigned head = head_.load(std::memory_order_relaxed);
+
+   // Only touch the producer's cache line when the cached tail shows too few entries
+   if (cachedTail_ - head < wanted) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+   }
+   return cachedTail_ - head;
+}
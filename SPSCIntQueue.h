@@ -0,0 +1,164 @@
+/** 
+ * @file SPSCIntQueue.h
+ * @brief Class definition for SPSCIntQueue, a bounded, wait-free queue of integers
+ *    shared by exactly one producer thread and one consumer thread
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef SPSCINTQUEUE_H
+#define SPSCINTQUEUE_H
+
+#include <atomic>    // Indices shared between the producer and consumer
+#include <exception> // Exceptions
+#include <stdexcept> // std::logic_error and std::overflow_error
+
+class SPSCIntQueue {
+public:
+   //PUBLIC METHODS
+   /** SPSCIntQueue(int)
+    * @brief   Constructor.
+    * @param   minCapacity    The minimum number of entries the queue must hold
+    * @pre     minCapacity is greater than 0.
+    * @post    This queue is empty and can hold at least minCapacity entries.
+    *          The capacity is rounded up to a power of two.
+    * @throw   std::invalid_argument if minCapacity is less than 1 or too large.
+   */
+   explicit SPSCIntQueue(int minCapacity);
+
+   /** ~SPSCIntQueue()
+    * @brief   Destructor.
+    * @pre     Neither the producer nor the consumer is using this queue.
+    * @post    All dynamically allocated memory has been returned to the system.
+   */
+   ~SPSCIntQueue();
+
+   // The ring buffer is shared by two threads, so copying it makes no sense
+   SPSCIntQueue(const SPSCIntQueue&) = delete;
+   SPSCIntQueue& operator=(const SPSCIntQueue&) = delete;
+
+   // PRODUCER METHODS - only one thread may call these at a time
+
+   /** pushBack(int)
+    * @brief   Adds an integer to the back of this queue.
+    * @param   newItem  The integer being added to this queue.
+    * @post    newItem has been added to the back of this queue.
+    * @throw   std::overflow_error if this queue is full.
+   */
+   void pushBack(int newItem);
+
+   /** tryPushBack(int)
+    * @brief   Adds an integer to the back of this queue if there is room.
+    * @param   newItem  The integer being added to this queue.
+    * @post    If this queue was not full, newItem has been added to its back.
+    * @return  True if newItem was added and false if this queue was full.
+   */
+   bool tryPushBack(int newItem);
+
+   /** pushBack(const int*, int)
+    * @brief   Adds as many integers from an array as fit to the back of this queue.
+    * @param   items    The integers being added, ordered from first to last
+    * @param   count    The number of integers in items
+    * @post    The first n entries of items have been added to the back of this
+    *          queue in order, where n is the returned value. The consumer sees
+    *          all n at once.
+    * @return  The number of integers added, which may be less than count.
+   */
+   int pushBack(const int* items, int count);
+
+   // CONSUMER METHODS - only one thread may call these at a time
+
+   /** front()
+    * @brief   Returns the first integer in this queue.
+    * @pre     There is at least one integer in this queue.
+    * @post    The returned value is equal to the first integer in this queue.
+    * @return  The first integer in this queue.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   int front() const;
+
+   /** popFront()
+    * @brief   Removes one integer from the front of this queue.
+    * @post    The first integer in this queue has been removed.
+    * @throw   std::logic_error if this queue is empty.
+   */
+   void popFront();
+
+   /** tryPopFront(int&)
+    * @brief   Removes one integer from the front of this queue if there is one.
+    * @param   item     Set to the removed integer
+    * @post    If this queue was not empty, its first integer has been removed
+    *          and stored in item. Otherwise item is unchanged.
+    * @return  True if an integer was removed and false if this queue was empty.
+   */
+   bool tryPopFront(int& item);
+
+   /** popFront(int*, int)
+    * @brief   Removes up to maxCount integers from the front of this queue.
+    * @param   items       Array the removed integers are stored in, in order
+    * @param   maxCount    The largest number of integers to remove
+    * @post    The first n integers in this queue have been removed and stored in
+    *          items, where n is the returned value.
+    * @return  The number of integers removed, which may be less than maxCount.
+   */
+   int popFront(int* items, int maxCount);
+
+   // OBSERVERS - safe from either thread
+
+   /** numEntries()
+    * @brief   Returns the number of entries in this queue.
+    * @post    The returned value is between 0 and capacity(). While the other
+    *          thread is active it is only an estimate and may be stale by the
+    *          time the caller uses it.
+    * @return  The number of entries in this queue.
+   */
+   int numEntries() const;
+
+   /** capacity()
+    * @brief   Returns the largest number of entries this queue can hold.
+    * @return  The capacity of this queue.
+   */
+   int capacity() const;
+
+private:
+   static const int CACHE_LINE_SIZE = 64;  // bytes; keeps producer and consumer state apart
+
+   // DATA MEMBERS
+   // Indices count up forever and wrap around; masking with mask_ gives the slot.
+
+   // Read-only after construction
+   int* buffer_;           // storage for the entries
+   unsigned mask_;         // capacity - 1; capacity is a power of two
+   char pad0_[CACHE_LINE_SIZE];
+
+   // Written by the consumer only
+   std::atomic<unsigned> head_;  // index of the first entry
+   unsigned cachedTail_;         // consumer's last seen value of tail_
+   char pad1_[CACHE_LINE_SIZE - sizeof(std::atomic<unsigned>) - sizeof(unsigned)];
+
+   // Written by the producer only
+   std::atomic<unsigned> tail_;  // index one past the last entry
+   unsigned cachedHead_;         // producer's last seen value of head_
+   char pad2_[CACHE_LINE_SIZE - sizeof(std::atomic<unsigned>) - sizeof(unsigned)];
+
+   // PRIVATE FUNCTIONS
+   /** freeSlots(unsigned)
+    * @brief   Producer helper. Returns the number of slots that can be filled.
+    * @param   wanted   The number of slots the producer would like to fill
+    * @post    cachedHead_ has been refreshed if the cached value showed fewer
+    *          than wanted free slots.
+    * @return  The number of free slots.
+   */
+   unsigned freeSlots(unsigned wanted);
+
+   /** readySlots(unsigned)
+    * @brief   Consumer helper. Returns the number of entries that can be removed.
+    * @param   wanted   The number of entries the consumer would like to remove
+    * @post    cachedTail_ has been refreshed if the cached value showed fewer
+    *          than wanted entries.
+    * @return  The number of filled slots.
+   */
+   unsigned readySlots(unsigned wanted);
+};
+
+#endif // SPSCINTQUEUE_H
@@ -0,0 +1,220 @@
+/** 
+ * @file Sorting.cpp
+ * @brief sortInfiniteInts, which sorts InfiniteInts by sign and length buckets
+ *    and a radix sort on a cached 64-bit prefix of their leading digits
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "Sorting.h"
+#include "ParallelFor.h"  // Reading keys, finishing ranges and placing values in parallel
+#include <algorithm>      // std::sort, std::min and std::max
+#include <cstddef>        // std::size_t
+
+// PRIVATE HELPERS
+
+const int PREFIX_DIGITS = 18;          // leading digits in each sort key; 10^18 < 2^64
+const int INSERTION_SORT_CUTOFF = 32;  // radix ranges this small are finished by insertion sort
+
+/** SortKey
+ * @brief   The part of a value the radix passes look at, and where it came from.
+*/
+struct SortKey {
+   unsigned long long prefix_;   // leading digits, complemented for negatives so larger magnitudes sort first
+   std::size_t index_;           // position of the value in the input
+};
+
+/** Range
+ * @brief   A run of keys, [begin_, end_), that all have the same signed length.
+*/
+struct Range {
+   std::size_t begin_;  // first key of the run
+   std::size_t end_;    // one past the last key of the run
+   int length_;         // number of digits of every value in the run
+};
+
+/** insertionSort(std::vector<SortKey>&, std::size_t, std::size_t)
+ * @brief   Sorts keys[begin, end) by prefix.
+*/
+static void insertionSort(std::vector<SortKey>& keys, std::size_t begin, std::size_t end) {
+   for (std::size_t i = begin + 1; i < end; ++i) {
+      SortKey key = keys[i];
+      std::size_t j = i;
+      while (j > begin && keys[j - 1].prefix_ > key.prefix_) {
+         keys[j] = keys[j - 1];
+         --j;
+      }
+      keys[j] = key;
+   }
+}
+
+/** radixPass(std::vector<SortKey>&, std::vector<SortKey>&, std::size_t, std::size_t, std::vector<Range>&)
+ * @brief   Distributes keys[begin, end) by the highest byte in which their
+ *          prefixes differ and appends the resulting runs of more than one key
+ *          to buckets. Nothing is appended if all the prefixes are equal.
+ * @param   scratch  Buffer at least as large as keys
+ * @return  False if keys[begin, end) all have the same prefix.
+*/
+static bool radixPass(std::vector<SortKey>& keys, std::vector<SortKey>& scratch,
+                      std::size_t begin, std::size_t end, std::vector<Range>& buckets) {
+   unsigned long long differences = 0;
+   for (std::size_t i = begin + 1; i < end; ++i) {
+      differences |= keys[i].prefix_ ^ keys[begin].prefix_;
+   }
+   if (differences == 0) {
+      return false;
+   }
+   int shift = 56;
+   while ((differences >> shift) == 0) {
+      shift -= 8;
+   }
+
+   std::size_t starts[257] = { 0 };
+   for (std::size_t i = begin; i < end; ++i) {
+      ++starts[((keys[i].prefix_ >> shift) & 0xFF) + 1];
+   }
+   for (int b = 0; b < 256; ++b) {
+      starts[b + 1] += starts[b];
+   }
+   std::size_t next[256];
+   std::copy(starts, starts + 256, next);
+   for (std::size_t i = begin; i < end; ++i) {
+      scratch[begin + next[(keys[i].prefix_ >> shift) & 0xFF]++] = keys[i];
+   }
+   std::copy(scratch.begin() + begin, scratch.begin() + end, keys.begin() + begin);
+
+   for (int b = 0; b < 256; ++b) {
+      if (starts[b + 1] - starts[b] > 1) {
+         buckets.push_back(Range{ begin + starts[b], begin + starts[b + 1], 0 });
+      }
+   }
+   return true;
+}
+
+/** radixSort(std::vector<SortKey>&, std::vector<SortKey>&, std::size_t, std::size_t)
+ * @brief   Sorts keys[begin, end) by prefix with MSD radix passes, finishing
+ *          small runs by insertion sort.
+*/
+static void radixSort(std::vector<SortKey>& keys, std::vector<SortKey>& scratch,
+                      std::size_t begin, std::size_t end) {
+   std::vector<Range> pending(1, Range{ begin, end, 0 });
+   while (!pending.empty()) {
+      Range range = pending.back();
+      pending.pop_back();
+      if (range.end_ - range.begin_ <= static_cast<std::size_t>(INSERTION_SORT_CUTOFF)) {
+         insertionSort(keys, range.begin_, range.end_);
+      } else {
+         radixPass(keys, scratch, range.begin_, range.end_, pending);
+      }
+   }
+}
+
+/** sortInfiniteInts(std::vector<InfiniteInt>&, int)
+ * @brief   Sorts values into ascending order without comparing InfiniteInts
+ *          digit by digit. Each value's sign, length and first 18 digits are
+ *          read once into a key. The keys are counting-sorted into
+ *          one bucket per signed length, each bucket is MSD radix sorted a byte
+ *          at a time on the 64-bit prefix (starting at the highest byte in
+ *          which its keys differ), and only runs of values that share a length
+ *          and prefix are ordered with operator<. Finally every value is
+ *          copied once into its place, where std::sort would copy whole
+ *          digit lists O(n log n) times. In parallel mode the keys are read,
+ *          the radix ranges are finished and the values are placed by worker
+ *          threads.
+ * @param   values      The InfiniteInts to sort
+ * @param   numThreads  The number of worker threads, 1 to sort on the calling
+ *                      thread alone, or 0 to use one per hardware thread
+ * @pre     numThreads is not negative.
+ * @post    values holds the same InfiniteInts in ascending order.
+ * @throw   std::invalid_argument if numThreads is negative.
+*/
+void sortInfiniteInts(std::vector<InfiniteInt>& values, int numThreads) {
+   if (numThreads < 0) {
+      throw std::invalid_argument("sortInfiniteInts called with a negative thread count.");
+   }
+   const std::size_t count = values.size();
+   if (count < 2) {
+      return;
+   }
+
+   // Read each value's key: its signed length, and its leading digits as one word
+   std::vector<SortKey> unbucketed(count);
+   std::vector<int> signedLengths(count);
+   parallelFor(count, numThreads, [&](std::size_t i) {
+      const InfiniteInt& value = values[i];
+      unsigned long long prefix = 0;
+      int digitsRead = 0;
+      for (auto digit = value.digits_.begin(); digit != value.digits_.end() && digitsRead < PREFIX_DIGITS;
+           ++digit, ++digitsRead) {
+         prefix = prefix * 10 + static_cast<unsigned long long>(*digit);
+      }
+      unbucketed[i] = SortKey{ value.isNegative_ ? ~prefix : prefix, i };
+      signedLengths[i] = value.isNegative_ ? -value.numDigits() : value.numDigits();
+   });
+
+   // Counting sort into buckets by signed length: longest negatives first, longest positives last
+   int longest = 0;
+   for (int length : signedLengths) {
+      longest = std::max(longest, length < 0 ? -length : length);
+   }
+   std::vector<std::size_t> bucketStarts(2 * static_cast<std::size_t>(longest) + 2, 0);
+   for (int length : signedLengths) {
+      ++bucketStarts[length + longest + 1];
+   }
+   for (std::size_t b = 1; b < bucketStarts.size(); ++b) {
+      bucketStarts[b] += bucketStarts[b - 1];
+   }
+   std::vector<SortKey> keys(count);
+   std::vector<std::size_t> next(bucketStarts.begin(), bucketStarts.end() - 1);
+   for (std::size_t i = 0; i < count; ++i) {
+      keys[next[signedLengths[i] + longest]++] = unbucketed[i];
+   }
+
+   // One radix pass over every large bucket splits the work into independent ranges
+   std::vector<SortKey> scratch(count);
+   std::vector<Range> ranges;
+   for (std::size_t b = 0; b + 1 < bucketStarts.size(); ++b) {
+      const std::size_t begin = bucketStarts[b];
+      const std::size_t end = bucketStarts[b + 1];
+      const int length = static_cast<int>(b) - longest;
+      const int digits = length < 0 ? -length : length;
+      std::size_t firstNew = ranges.size();
+      if (end - begin <= static_cast<std::size_t>(INSERTION_SORT_CUTOFF) ||
+          !radixPass(keys, scratch, begin, end, ranges)) {
+         if (end - begin > 1) {
+            ranges.push_back(Range{ begin, end, digits });
+         }
+      }
+      for (std::size_t r = firstNew; r < ranges.size(); ++r) {
+         ranges[r].length_ = digits;
+      }
+   }
+
+   // Finish each range, then order runs of equal prefixes, which only long values can have
+   parallelFor(ranges.size(), numThreads, [&](std::size_t r) {
+      const Range& range = ranges[r];
+      radixSort(keys, scratch, range.begin_, range.end_);
+      if (range.length_ <= PREFIX_DIGITS) {
+         return;
+      }
+      for (std::size_t runStart = range.begin_; runStart < range.end_; ) {
+         std::size_t runEnd = runStart + 1;
+         while (runEnd < range.end_ && keys[runEnd].prefix_ == keys[runStart].prefix_) {
+            ++runEnd;
+         }
+         if (runEnd - runStart > 1) {
+            std::sort(keys.begin() + runStart, keys.begin() + runEnd,
+                      [&](const SortKey& lhs, const SortKey& rhs) {
+                         return values[lhs.index_] < values[rhs.index_];
+                      });
+         }
+         runStart = runEnd;
+      }
+   });
+
+   // Copy every value into its place once
+   std::vector<InfiniteInt> sorted(count);
+   parallelFor(count, numThreads, [&](std::size_t i) {
+      sorted[i] = values[keys[i].index_];
+   });
+   values.swap(sorted);
+}
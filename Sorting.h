@@ -0,0 +1,37 @@
+/** 
+ * @file Sorting.h
+ * @brief sortInfiniteInts, which sorts InfiniteInts by sign and length buckets
+ *    and a radix sort on a cached 64-bit prefix of their leading digits
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef SORTING_H
+#define SORTING_H
+
+#include "InfiniteInt.h" // Type of the values being sorted
+#include <stdexcept>     // std::invalid_argument
+#include <vector>        // The values being sorted
+
+/** sortInfiniteInts(std::vector<InfiniteInt>&, int)
+ * @brief   Sorts values into ascending order without comparing InfiniteInts
+ *          digit by digit. Each value's sign, length and first 18 digits are
+ *          read once into a key. The keys are counting-sorted into
+ *          one bucket per signed length, each bucket is MSD radix sorted a byte
+ *          at a time on the 64-bit prefix (starting at the highest byte in
+ *          which its keys differ), and only runs of values that share a length
+ *          and prefix are ordered with operator<. Finally every value is
+ *          copied once into its place, where std::sort would copy whole
+ *          digit lists O(n log n) times. In parallel mode the keys are read,
+ *          the radix ranges are finished and the values are placed by worker
+ *          threads.
+ * @param   values      The InfiniteInts to sort
+ * @param   numThreads  The number of worker threads, 1 to sort on the calling
+ *                      thread alone, or 0 to use one per hardware thread
+ * @pre     numThreads is not negative.
+ * @post    values holds the same InfiniteInts in ascending order.
+ * @throw   std::invalid_argument if numThreads is negative.
+*/
+void sortInfiniteInts(std::vector<InfiniteInt>& values, int numThreads = 1);
+
+#endif // SORTING_H
@@ -0,0 +1,278 @@
+/** 
+ * @file BigMatrixTests.cpp
+ * @brief Defines catch2 unit tests for BigMatrix
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../BigMatrix.h"     // class being tested
+#include <sstream>            // building InfiniteInts from text
+
+/** matrixOf(const std::vector<std::vector<int>>&)
+ * @brief   Returns the BigMatrix with the given small entries.
+*/
+static BigMatrix matrixOf(const std::vector<std::vector<int>>& rows) {
+   std::vector<std::vector<InfiniteInt>> entries;
+   for (const std::vector<int>& row : rows) {
+      entries.push_back(std::vector<InfiniteInt>());
+      for (int value : row) {
+         entries.back().push_back(InfiniteInt(value));
+      }
+   }
+   return BigMatrix(entries);
+}
+
+/** pseudoRandomMatrix(int, int, int, long long&)
+ * @brief   Returns a rows-by-cols matrix of signed entries with up to numDigits
+ *          digits, drawn from a linear congruential generator.
+*/
+static BigMatrix pseudoRandomMatrix(int rows, int cols, int numDigits, long long& seed) {
+   BigMatrix result(rows, cols);
+   for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+         std::string text = seed % 2 == 0 ? "-" : "";
+         for (int d = 0; d < numDigits; ++d) {
+            seed = (seed * 1103515245 + 12345) % 2147483648LL;
+            text += static_cast<char>('0' + seed / 7 % 10);
+         }
+         std::stringstream stream(text);
+         stream >> result.at(i, j);
+      }
+   }
+   return result;
+}
+
+/** rowByColumnProduct(const BigMatrix&, const BigMatrix&)
+ * @brief   Multiplies two matrices entry by entry with InfiniteInt arithmetic,
+ *          as a reference for BigMatrix::multiply().
+*/
+static BigMatrix rowByColumnProduct(const BigMatrix& lhs, const BigMatrix& rhs) {
+   BigMatrix product(lhs.rows(), rhs.cols());
+   for (int i = 0; i < lhs.rows(); ++i) {
+      for (int j = 0; j < rhs.cols(); ++j) {
+         for (int k = 0; k < lhs.cols(); ++k) {
+            product.at(i, j) = product.at(i, j) + lhs.at(i, k) * rhs.at(k, j);
+         }
+      }
+   }
+   return product;
+}
+
+// CONSTRUCTION TESTS
+TEST_CASE("[BigMatrix] Construction and entry access", "[BigMatrix]") {
+   // Setup
+   BigMatrix zeroes(2, 3);
+   BigMatrix filled = matrixOf({ { 1, 2 }, { 3, 4 }, { 5, 6 } });
+
+   // Test
+   CHECK(zeroes.rows() == 2);
+   CHECK(zeroes.cols() == 3);
+   CHECK(zeroes.at(1, 2) == InfiniteInt(0));
+   CHECK(filled.rows() == 3);
+   CHECK(filled.at(2, 0) == InfiniteInt(5));
+   filled.at(2, 0) = InfiniteInt(-7);
+   CHECK(filled.at(2, 0) == InfiniteInt(-7));
+   CHECK(BigMatrix::identity(2) == matrixOf({ { 1, 0 }, { 0, 1 } }));
+   REQUIRE_THROWS_AS(filled.at(3, 0), std::out_of_range);
+   REQUIRE_THROWS_AS(filled.at(0, -1), std::out_of_range);
+   REQUIRE_THROWS_AS(BigMatrix(-1, 2), std::invalid_argument);
+   REQUIRE_THROWS_AS(matrixOf({ { 1, 2 }, { 3 } }), std::invalid_argument);
+}
+// END CONSTRUCTION TESTS
+
+// ARITHMETIC TESTS
+TEST_CASE("[BigMatrix] Addition and subtraction work entrywise", "[BigMatrix]") {
+   BigMatrix lhs = matrixOf({ { 1, -2 }, { 3, 4 } });
+   BigMatrix rhs = matrixOf({ { 5, 6 }, { -7, 8 } });
+   CHECK(lhs + rhs == matrixOf({ { 6, 4 }, { -4, 12 } }));
+   CHECK(lhs - rhs == matrixOf({ { -4, -8 }, { 10, -4 } }));
+   REQUIRE_THROWS_AS(lhs + BigMatrix(2, 3), std::invalid_argument);
+   REQUIRE_THROWS_AS(lhs - BigMatrix(3, 2), std::invalid_argument);
+}
+
+TEST_CASE("[BigMatrix] Small products", "[BigMatrix multiply]") {
+   BigMatrix lhs = matrixOf({ { 1, 2, 3 }, { 4, 5, 6 } });
+   BigMatrix rhs = matrixOf({ { 7, -8 }, { 9, 10 }, { -11, 12 } });
+   CHECK(lhs * rhs == matrixOf({ { -8, 48 }, { 7, 90 } }));
+   CHECK(lhs * BigMatrix::identity(3) == lhs);
+   CHECK(matrixOf({ { 0, 0 } }) * matrixOf({ { 5 }, { 6 } }) == matrixOf({ { 0 } }));
+   CHECK(BigMatrix(3, 0) * BigMatrix(0, 2) == BigMatrix(3, 2));
+   REQUIRE_THROWS_AS(lhs * lhs, std::invalid_argument);
+   REQUIRE_THROWS_AS(lhs.multiply(rhs, -1), std::invalid_argument);
+}
+
+TEST_CASE("[BigMatrix] Products spanning several tiles agree with row-by-column products", "[BigMatrix multiply]") {
+   // Setup
+   long long seed = 2020;
+   BigMatrix lhs = pseudoRandomMatrix(BigMatrix::TILE_SIZE + 3, 2 * BigMatrix::TILE_SIZE + 1, 6, seed);
+   BigMatrix rhs = pseudoRandomMatrix(2 * BigMatrix::TILE_SIZE + 1, BigMatrix::TILE_SIZE + 2, 5, seed);
+   BigMatrix expected = rowByColumnProduct(lhs, rhs);
+
+   // Run / Test
+   for (int numThreads : { 1, 3 }) {
+      CHECK(lhs.multiply(rhs, numThreads) == expected);
+   }
+}
+
+TEST_CASE("[BigMatrix] Products of large entries need several primes", "[BigMatrix multiply]") {
+   // Setup
+   long long seed = 7;
+   BigMatrix lhs = pseudoRandomMatrix(3, 4, 60, seed);
+   BigMatrix rhs = pseudoRandomMatrix(4, 2, 45, seed);
+
+   // Run / Test
+   CHECK(lhs.multiply(rhs, 2) == rowByColumnProduct(lhs, rhs));
+}
+
+TEST_CASE("[BigMatrix] Long sums of maximal residues do not overflow", "[BigMatrix multiply]") {
+   // Setup: every entry is -1, so every residue is the largest possible
+   const int depth = 50;
+   std::vector<std::vector<int>> negativeOnes(2, std::vector<int>(depth, -1));
+   BigMatrix lhs = matrixOf(negativeOnes);
+   std::vector<std::vector<int>> transposed(depth, std::vector<int>(2, -1));
+
+   // Test
+   CHECK(lhs * matrixOf(transposed) == matrixOf({ { depth, depth }, { depth, depth } }));
+}
+// END ARITHMETIC TESTS
+
+/** scaleMatrix(const BigMatrix&, const InfiniteInt&)
+ * @brief   Returns every entry of matrix multiplied by factor.
+*/
+static BigMatrix scaleMatrix(const BigMatrix& matrix, const InfiniteInt& factor) {
+   BigMatrix result(matrix.rows(), matrix.cols());
+   for (int i = 0; i < matrix.rows(); ++i) {
+      for (int j = 0; j < matrix.cols(); ++j) {
+         result.at(i, j) = matrix.at(i, j) * factor;
+      }
+   }
+   return result;
+}
+
+// LINEAR ALGEBRA TESTS
+TEST_CASE("[BigMatrix] determinant of small matrices", "[BigMatrix determinant]") {
+   BigMatrix needsSwap = matrixOf({ { 0, 1 }, { 1, 0 } });
+   BigMatrix known = matrixOf({ { 2, -3, 1 }, { 2, 0, -1 }, { 1, 4, 5 } });
+   BigMatrix singular = matrixOf({ { 1, 2 }, { 2, 4 } });
+   BigMatrix vandermonde(6, 6);
+   for (int i = 0; i < 6; ++i) {
+      InfiniteInt power(1);
+      for (int j = 0; j < 6; ++j) {
+         vandermonde.at(i, j) = power;
+         power = power * InfiniteInt(i + 1);
+      }
+   }
+
+   for (int numThreads : { 1, 2 }) {
+      CHECK(needsSwap.determinant() == InfiniteInt(-1));
+      CHECK(needsSwap.determinantMultimodular(numThreads) == InfiniteInt(-1));
+      CHECK(known.determinant() == InfiniteInt(49));
+      CHECK(known.determinantMultimodular(numThreads) == InfiniteInt(49));
+      CHECK(singular.determinant() == InfiniteInt(0));
+      CHECK(singular.determinantMultimodular(numThreads) == InfiniteInt(0));
+      CHECK(vandermonde.determinant() == InfiniteInt(34560));
+      CHECK(vandermonde.determinantMultimodular(numThreads) == InfiniteInt(34560));
+   }
+   CHECK(BigMatrix(0, 0).determinant() == InfiniteInt(1));
+   CHECK(BigMatrix(3, 3).determinantMultimodular(1) == InfiniteInt(0));
+   REQUIRE_THROWS_AS(BigMatrix(2, 3).determinant(), std::invalid_argument);
+   REQUIRE_THROWS_AS(BigMatrix(2, 3).determinantMultimodular(1), std::invalid_argument);
+   REQUIRE_THROWS_AS(known.determinantMultimodular(-1), std::invalid_argument);
+}
+
+TEST_CASE("[BigMatrix] Bareiss and multi-modular determinants agree on large entries", "[BigMatrix determinant]") {
+   // Setup
+   long long seed = 99;
+   BigMatrix matrix = pseudoRandomMatrix(7, 7, 25, seed);
+
+   // Run
+   InfiniteInt bareiss = matrix.determinant();
+
+   // Test
+   CHECK(bareiss.numDigits() > 150);
+   CHECK(matrix.determinantMultimodular(3) == bareiss);
+   matrix.at(6, 0) = InfiniteInt(0) - matrix.at(6, 0);
+   CHECK(matrix.determinantMultimodular(1) == matrix.determinant());
+}
+
+TEST_CASE("[BigMatrix] rank counts independent rows", "[BigMatrix rank]") {
+   long long seed = 5;
+   CHECK(matrixOf({ { 1, 2, 3 }, { 2, 4, 6 }, { 1, 0, 1 } }).rank() == 2);
+   CHECK(matrixOf({ { 0, 0, 1 }, { 0, 0, 2 } }).rank() == 1);
+   CHECK(matrixOf({ { 0, 3 }, { 0, 0 }, { 5, 1 } }).rank() == 2);
+   CHECK(BigMatrix(4, 2).rank() == 0);
+   CHECK(pseudoRandomMatrix(3, 5, 12, seed).rank() == 3);
+}
+
+TEST_CASE("[BigMatrix] solve returns integral numerators over the determinant", "[BigMatrix solve]") {
+   // Setup
+   long long seed = 31;
+   BigMatrix matrix = pseudoRandomMatrix(5, 5, 15, seed);
+   BigMatrix rhs = pseudoRandomMatrix(5, 2, 10, seed);
+   BigMatrix numerators(0, 0);
+   InfiniteInt denominator;
+   BigMatrix modularNumerators(0, 0);
+   InfiniteInt modularDenominator;
+
+   // Run
+   matrix.solve(rhs, numerators, denominator);
+   matrix.solveMultimodular(rhs, modularNumerators, modularDenominator, 2);
+
+   // Test
+   CHECK(denominator == matrix.determinant());
+   CHECK(matrix * numerators == scaleMatrix(rhs, denominator));
+   CHECK(modularDenominator == denominator);
+   CHECK(modularNumerators == numerators);
+}
+
+TEST_CASE("[BigMatrix] solve handles row swaps and unlucky primes", "[BigMatrix solve]") {
+   // Setup: the determinant is the largest prime the multi-modular path tries first
+   BigMatrix swapped = matrixOf({ { 0, 2 }, { 3, 1 } });
+   BigMatrix unlucky = matrixOf({ { 999999937, 0 }, { 0, 1 } });
+   BigMatrix rhs = matrixOf({ { 4 }, { 5 } });
+   BigMatrix numerators(0, 0);
+   InfiniteInt denominator;
+
+   // Run / Test
+   swapped.solve(rhs, numerators, denominator);
+   CHECK(denominator == InfiniteInt(-6));
+   CHECK(numerators == matrixOf({ { -6 }, { -12 } }));
+   swapped.solveMultimodular(rhs, numerators, denominator, 1);
+   CHECK(denominator == InfiniteInt(-6));
+   CHECK(numerators == matrixOf({ { -6 }, { -12 } }));
+   unlucky.solveMultimodular(rhs, numerators, denominator, 1);
+   CHECK(denominator == InfiniteInt(999999937));
+   CHECK(numerators.at(0, 0) == InfiniteInt(4));
+   CHECK(numerators.at(1, 0) == InfiniteInt(999999937) * InfiniteInt(5));
+}
+
+TEST_CASE("[BigMatrix] solveMultimodular rejects singular matrices", "[BigMatrix solve]") {
+   // Setup: the rows of large are combinations of two 30-digit rows, so its
+   // Hadamard bound needs several primes before it can be declared singular
+   long long seed = 47;
+   BigMatrix wide = pseudoRandomMatrix(2, 4, 30, seed);
+   BigMatrix dependent = matrixOf({ { 1, 2, 3 }, { 4, 5, 6 }, { 5, 7, 9 } });
+   BigMatrix large(4, 4);
+   for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+         large.at(r, c) = r < 2 ? wide.at(r, c) : wide.at(0, c) * InfiniteInt(r) + wide.at(1, c);
+      }
+   }
+   BigMatrix rhs = matrixOf({ { 1 }, { 2 }, { 3 }, { 4 } });
+   BigMatrix numerators(0, 0);
+   InfiniteInt denominator;
+
+   // Run / Test
+   REQUIRE(large.determinant() == InfiniteInt(0));
+   REQUIRE_THROWS_AS(matrixOf({ { 1, 2 }, { 2, 4 } }).solveMultimodular(matrixOf({ { 1 }, { 1 } }),
+                                                                        numerators, denominator, 1),
+                     std::domain_error);
+   REQUIRE_THROWS_AS(matrixOf({ { 1, 2 }, { 0, 0 } }).solveMultimodular(matrixOf({ { 1 }, { 1 } }),
+                                                                        numerators, denominator, 1),
+                     std::domain_error);
+   REQUIRE_THROWS_AS(dependent.solveMultimodular(matrixOf({ { 1 }, { 2 }, { 3 } }), numerators, denominator, 2),
+                     std::domain_error);
+   REQUIRE_THROWS_AS(large.solveMultimodular(rhs, numerators, denominator, 2), std::domain_error);
+}
+// END LINEAR ALGEBRA TESTS
@@ -0,0 +1,198 @@
+/** 
+ * @file BigPolyTests.cpp
+ * @brief Defines catch2 unit tests for BigPoly
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../BigPoly.h"       // class being tested
+#include "TestHelpers.h"      // parseInfiniteInt
+
+/** polyOf(const std::vector<int>&)
+ * @brief   Returns the BigPoly with the given small coefficients, constant term first.
+*/
+static BigPoly polyOf(const std::vector<int>& coefficients) {
+   std::vector<InfiniteInt> values;
+   for (int coefficient : coefficients) {
+      values.push_back(InfiniteInt(coefficient));
+   }
+   return BigPoly(values);
+}
+
+/** schoolbookProduct(const BigPoly&, const BigPoly&)
+ * @brief   Multiplies two polynomials term by term, as a reference for operator*.
+*/
+static BigPoly schoolbookProduct(const BigPoly& lhs, const BigPoly& rhs) {
+   if (lhs.degree() < 0 || rhs.degree() < 0) {
+      return BigPoly();
+   }
+   std::vector<InfiniteInt> product(lhs.degree() + rhs.degree() + 1, InfiniteInt(0));
+   for (int i = 0; i <= lhs.degree(); ++i) {
+      for (int j = 0; j <= rhs.degree(); ++j) {
+         product[i + j] = product[i + j] + lhs.coefficient(i) * rhs.coefficient(j);
+      }
+   }
+   return BigPoly(product);
+}
+
+// CONSTRUCTION TESTS
+TEST_CASE("[BigPoly] Construction drops high zero coefficients", "[BigPoly]") {
+   // Setup
+   BigPoly zero;
+   BigPoly trimmed = polyOf({ 3, 0, -2, 0, 0 });
+
+   // Test
+   CHECK(zero.degree() == -1);
+   CHECK(polyOf({ 0, 0 }) == zero);
+   CHECK(trimmed.degree() == 2);
+   CHECK(trimmed.coefficients().size() == 3);
+   CHECK(trimmed.coefficient(2) == InfiniteInt(-2));
+   CHECK(trimmed.coefficient(7) == InfiniteInt(0));
+   REQUIRE_THROWS_AS(trimmed.coefficient(-1), std::out_of_range);
+}
+// END CONSTRUCTION TESTS
+
+// ARITHMETIC TESTS
+TEST_CASE("[BigPoly] Addition and subtraction work coefficientwise", "[BigPoly]") {
+   BigPoly lhs = polyOf({ 1, 2, 3 });
+   BigPoly rhs = polyOf({ 4, -2, -3 });
+   CHECK(lhs + rhs == polyOf({ 5 }));
+   CHECK(lhs - rhs == polyOf({ -3, 4, 6 }));
+   CHECK(lhs - lhs == BigPoly());
+}
+
+TEST_CASE("[BigPoly] Multiplication handles signs and cancellation", "[BigPoly]") {
+   CHECK(polyOf({ 1, 1 }) * polyOf({ -1, 1 }) == polyOf({ -1, 0, 1 }));
+   CHECK(polyOf({ -1, -1 }) * polyOf({ 1, 1 }) == polyOf({ -1, -2, -1 }));
+   CHECK(polyOf({ 5, -9, 9, -9 }) * polyOf({ -9, 9, -9 }) == schoolbookProduct(polyOf({ 5, -9, 9, -9 }), polyOf({ -9, 9, -9 })));
+   CHECK(polyOf({ 7 }) * BigPoly() == BigPoly());
+   CHECK(polyOf({ 0, 0, 3 }) * polyOf({ 0, 2 }) == polyOf({ 0, 0, 0, 6 }));
+}
+
+TEST_CASE("[BigPoly] Karatsuba multiplication agrees with schoolbook products", "[BigPoly]") {
+   // Setup
+   std::vector<InfiniteInt> lhsTerms;
+   std::vector<InfiniteInt> rhsTerms;
+   long long seed = 12345;
+   for (int i = 0; i < 40; ++i) {
+      seed = (seed * 1103515245 + 12345) % 2147483648LL;
+      std::string digits = std::to_string(seed) + std::to_string(seed % 9973);
+      lhsTerms.push_back(parseInfiniteInt((i % 3 == 0 ? "-" : "") + digits));
+      if (i < 25) {
+         rhsTerms.push_back(InfiniteInt(static_cast<int>(seed % 2001) - 1000));
+      }
+   }
+   BigPoly lhs(lhsTerms);
+   BigPoly rhs(rhsTerms);
+
+   // Run
+   BigPoly product = lhs * rhs;
+
+   // Test
+   CHECK(product == schoolbookProduct(lhs, rhs));
+   CHECK(product == rhs * lhs);
+}
+
+TEST_CASE("[BigPoly] Karatsuba multiplication of unbalanced and odd-length operands", "[BigPoly]") {
+   for (int lhsSize : { 2, 7, 33, 64 }) {
+      for (int rhsSize : { 1, 3, 17, 64 }) {
+         // Setup
+         std::vector<int> lhsTerms;
+         std::vector<int> rhsTerms;
+         for (int i = 0; i < lhsSize; ++i) {
+            lhsTerms.push_back((i * 7919 + lhsSize) % 2001 - 1000);
+         }
+         for (int i = 0; i < rhsSize; ++i) {
+            rhsTerms.push_back((i * 104729 + rhsSize) % 199 - 99);
+         }
+         BigPoly lhs = polyOf(lhsTerms);
+         BigPoly rhs = polyOf(rhsTerms);
+
+         // Run and Test
+         CHECK(lhs * rhs == schoolbookProduct(lhs, rhs));
+      }
+   }
+}
+
+TEST_CASE("[BigPoly] divmod satisfies the division identity", "[BigPoly]") {
+   // Setup
+   BigPoly dividend = polyOf({ -7, 4, 0, 3, -1, 2 });
+   BigPoly monic = polyOf({ 3, -2, 1 });
+   BigPoly quotient;
+   BigPoly remainder;
+
+   // Run
+   dividend.divmod(monic, quotient, remainder);
+
+   // Test
+   CHECK(quotient * monic + remainder == dividend);
+   CHECK(remainder.degree() < monic.degree());
+   CHECK(dividend / polyOf({ 0, -1 }) == polyOf({ -4, 0, -3, 1, -2 }));
+   CHECK(dividend % polyOf({ 0, -1 }) == polyOf({ -7 }));
+   CHECK(polyOf({ 2, 3 }) / polyOf({ 1, 1, 1 }) == BigPoly());
+   CHECK(polyOf({ 2, 3 }) % polyOf({ 1, 1, 1 }) == polyOf({ 2, 3 }));
+}
+
+TEST_CASE("[BigPoly] divmod by non-monic divisors", "[BigPoly]") {
+   // Setup
+   BigPoly divisor = polyOf({ 1, 3 });
+   BigPoly quotient = polyOf({ -2, 5, 4 });
+
+   // Test
+   CHECK((quotient * divisor + polyOf({ 6 })) / divisor == quotient);
+   CHECK((quotient * divisor + polyOf({ 6 })) % divisor == polyOf({ 6 }));
+   REQUIRE_THROWS_AS(polyOf({ 1, 1 }) / polyOf({ 1, 2 }), std::domain_error);
+   REQUIRE_THROWS_AS(polyOf({ 1, 1 }) % BigPoly(), std::domain_error);
+}
+// END ARITHMETIC TESTS
+
+// EVALUATION TESTS
+TEST_CASE("[BigPoly] evaluate uses Horner's rule", "[BigPoly evaluate]") {
+   BigPoly poly = polyOf({ 1, -3, 0, 2 });
+   CHECK(poly.evaluate(InfiniteInt(0)) == InfiniteInt(1));
+   CHECK(poly.evaluate(InfiniteInt(2)) == InfiniteInt(11));
+   CHECK(poly.evaluate(InfiniteInt(-3)) == InfiniteInt(-44));
+   CHECK(BigPoly().evaluate(InfiniteInt(5)) == InfiniteInt(0));
+}
+
+TEST_CASE("[BigPoly] Multipoint evaluation agrees with Horner's rule", "[BigPoly evaluate]") {
+   // Setup
+   BigPoly poly = polyOf({ 17, -4, 0, 9, 1, -6, 2, 0, 0, 3, -1 });
+   std::vector<InfiniteInt> points;
+   for (int x = -6; x <= 6; ++x) {
+      points.push_back(InfiniteInt(x * 7 + 1));
+   }
+   points.push_back(parseInfiniteInt("123456789012345"));
+
+   for (int numThreads : { 1, 3 }) {
+      // Run
+      std::vector<InfiniteInt> values = poly.evaluate(points, numThreads);
+
+      // Test
+      REQUIRE(values.size() == points.size());
+      for (std::size_t i = 0; i < points.size(); ++i) {
+         CHECK(values[i] == poly.evaluate(points[i]));
+      }
+   }
+   CHECK(polyOf({ 4 }).evaluate(points, 1) == std::vector<InfiniteInt>(points.size(), InfiniteInt(4)));
+   CHECK(poly.evaluate(std::vector<InfiniteInt>(), 1).empty());
+   REQUIRE_THROWS_AS(poly.evaluate(points, -1), std::invalid_argument);
+}
+
+TEST_CASE("[BigPoly] compose substitutes one polynomial into another", "[BigPoly compose]") {
+   // Setup
+   BigPoly outer = polyOf({ 1, 0, 1 });
+   BigPoly inner = polyOf({ -3, 1 });
+
+   // Test
+   CHECK(outer.compose(inner) == polyOf({ 10, -6, 1 }));
+   CHECK(inner.compose(outer) == polyOf({ -2, 0, 1 }));
+   CHECK(outer.compose(BigPoly()) == polyOf({ 1 }));
+   BigPoly composed = polyOf({ 2, -1, 0, 4 }).compose(polyOf({ 1, 5, -2 }));
+   for (int x = -3; x <= 3; ++x) {
+      CHECK(composed.evaluate(InfiniteInt(x)) ==
+            polyOf({ 2, -1, 0, 4 }).evaluate(polyOf({ 1, 5, -2 }).evaluate(InfiniteInt(x))));
+   }
+}
+// END EVALUATION TESTS
@@ -0,0 +1,184 @@
+/** 
+ * @file ConcurrentDEIntQueueTests.cpp
+ * @brief Defines catch2 unit tests for ConcurrentDEIntQueue
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"                  // catch2 required header
+#include "../ConcurrentDEIntQueue.h"  // class being tested
+#include <thread>                     // worker threads
+#include <vector>                     // per-thread results
+
+// SINGLE THREAD TESTS
+TEST_CASE("ConcurrentDEIntQueue constructor creates empty queue", "[ConcurrentDEIntQueue]") {
+   // Run
+   ConcurrentDEIntQueue queue;
+   int item{-1};
+
+   // Test
+   CHECK(queue.numEntries() == 0);
+   CHECK_FALSE(queue.tryPopFront(item));
+   CHECK_FALSE(queue.tryPopBack(item));
+   CHECK(item == -1);
+}
+
+TEST_CASE("ConcurrentDEIntQueue pushes and pops at both ends", "[ConcurrentDEIntQueue]") {
+   // Setup
+   ConcurrentDEIntQueue queue;
+   int item{0};
+
+   // Run
+   queue.pushBack(2);
+   queue.pushFront(1);
+   queue.pushBack(3);
+
+   // Test
+   CHECK(queue.numEntries() == 3);
+   CHECK(queue.front() == 1);
+   CHECK(queue.back() == 3);
+   REQUIRE(queue.tryPopBack(item));
+   CHECK(item == 3);
+   REQUIRE(queue.tryPopFront(item));
+   CHECK(item == 1);
+   queue.popFront();
+   CHECK(queue.numEntries() == 0);
+}
+
+TEST_CASE("ConcurrentDEIntQueue pops entries pushed at the other end in order", "[ConcurrentDEIntQueue]") {
+   // Setup
+   ConcurrentDEIntQueue queue;
+   int item{0};
+   for (int i = 1; i <= 4; ++i) {
+      queue.pushBack(i);
+   }
+
+   // Test - the front end takes entries that were pushed at the back
+   CHECK(queue.front() == 1);
+   REQUIRE(queue.tryPopFront(item));
+   CHECK(item == 1);
+
+   // Run - the back end now has to take entries back from the front
+   REQUIRE(queue.tryPopBack(item));
+   CHECK(item == 4);
+   queue.pushFront(0);
+   CHECK(queue.back() == 3);
+   CHECK(queue.numEntries() == 3);
+
+   // Test
+   std::vector<int> remaining;
+   while (queue.tryPopBack(item)) {
+      remaining.push_back(item);
+   }
+   CHECK(remaining == std::vector<int>({ 3, 2, 0 }));
+}
+
+TEST_CASE("ConcurrentDEIntQueue throws exceptions for an empty queue", "[ConcurrentDEIntQueue]") {
+   // Setup
+   ConcurrentDEIntQueue queue;
+
+   // Test
+   REQUIRE_THROWS_AS(queue.front(), std::logic_error);
+   REQUIRE_THROWS_AS(queue.back(), std::logic_error);
+   REQUIRE_THROWS_AS(queue.popFront(), std::logic_error);
+   REQUIRE_THROWS_AS(queue.popBack(), std::logic_error);
+}
+
+TEST_CASE("ConcurrentDEIntQueue::clear removes all entries", "[ConcurrentDEIntQueue]") {
+   // Setup
+   ConcurrentDEIntQueue queue;
+   for (int i = 0; i < 10; ++i) {
+      queue.pushBack(i);
+   }
+
+   // Run
+   queue.clear();
+
+   // Test
+   CHECK(queue.numEntries() == 0);
+   REQUIRE_THROWS_AS(queue.front(), std::logic_error);
+}
+// END SINGLE THREAD TESTS
+
+// CONCURRENCY TESTS
+TEST_CASE("ConcurrentDEIntQueue loses no items with many threads at both ends", "[ConcurrentDEIntQueue]") {
+   // Setup
+   const int numThreads = 8;
+   const int itemsPerThread = 20000;
+   ConcurrentDEIntQueue queue;
+   std::vector<long long> poppedSums(numThreads, 0);
+   std::vector<int> poppedCounts(numThreads, 0);
+   std::vector<std::thread> workers;
+
+   // Run - each thread pushes its own items and pops whatever it finds
+   for (int t = 0; t < numThreads; ++t) {
+      workers.emplace_back([&queue, &poppedSums, &poppedCounts, t, itemsPerThread]() {
+         int item;
+         for (int i = 1; i <= itemsPerThread; ++i) {
+            if (i % 2 == 0) {
+               queue.pushBack(i);
+            } else {
+               queue.pushFront(i);
+            }
+            bool popped = (i % 3 == 0) ? queue.tryPopBack(item) : queue.tryPopFront(item);
+            if (popped) {
+               poppedSums[t] += item;
+               ++poppedCounts[t];
+            }
+         }
+      });
+   }
+   for (auto& worker : workers) {
+      worker.join();
+   }
+
+   // Drain what is left
+   long long totalSum{0};
+   int totalCount{0};
+   int item;
+   while (queue.tryPopFront(item)) {
+      totalSum += item;
+      ++totalCount;
+   }
+   for (int t = 0; t < numThreads; ++t) {
+      totalSum += poppedSums[t];
+      totalCount += poppedCounts[t];
+   }
+
+   // Test
+   long long expectedSum = static_cast<long long>(numThreads) * itemsPerThread * (itemsPerThread + 1) / 2;
+   CHECK(totalCount == numThreads * itemsPerThread);
+   CHECK(totalSum == expectedSum);
+}
+
+TEST_CASE("ConcurrentDEIntQueue keeps FIFO order from the back end to the front end", "[ConcurrentDEIntQueue]") {
+   // Setup
+   const int numItems = 50000;
+   ConcurrentDEIntQueue queue;
+   std::vector<int> received;
+
+   // Run - one thread pushes at the back while this thread pops at the front
+   std::thread producer([&queue, numItems]() {
+      for (int i = 0; i < numItems; ++i) {
+         queue.pushBack(i);
+      }
+   });
+   int item;
+   while (static_cast<int>(received.size()) < numItems) {
+      if (queue.tryPopFront(item)) {
+         received.push_back(item);
+      } else {
+         std::this_thread::yield();   // let the producer run on machines with few cores
+      }
+   }
+   producer.join();
+
+   // Test
+   bool inOrder{true};
+   for (int i = 0; i < numItems; ++i) {
+      inOrder = inOrder && received[i] == i;
+   }
+   CHECK(inOrder);
+   CHECK(queue.numEntries() == 0);
+}
+// END CONCURRENCY TESTS
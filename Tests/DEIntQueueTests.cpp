@@ -8,6 +8,7 @@
 #include "catch.hpp"       // catch2 required header
 #include "../DEIntQueue.h" // class being tested
 #include <sstream>         // allow testing of queue contents via printing
+#include <vector>          // source ranges for bulk insertion
 
 // DEFAULT CONSTRUCTOR TESTS
 TEST_CASE("DEIntQueue constructor creates empty queue", "[DEIntQueue]") {
@@ -442,6 +443,171 @@ TEST_CASE("DEIntQueue assignment operator deep copies another queue", "[DEIntQue
 }
 // END BIG THREE TESTS
 
+// BULK INSERTION TESTS
+TEST_CASE("DEIntQueue initializer list constructor stores items in order", "[DEIntQueue]") {
+   // Setup
+   std::stringstream expected{"1 2 3 "};   // Expected output from queue
+   std::stringstream actual;               // Actual output from queue
+
+   // Run
+   DEIntQueue queue{1, 2, 3};
+   actual << queue;
+
+   // Test
+   CHECK(queue.numEntries() == 3);
+   CHECK(actual.str() == expected.str());
+   CHECK(queue.back() == 3);
+}
+
+TEST_CASE("DEIntQueue range constructor stores items in order", "[DEIntQueue]") {
+   // Setup
+   std::vector<int> items;
+   std::stringstream actual;
+
+   SECTION("range is empty") {
+      // Run
+      DEIntQueue queue(items.begin(), items.end());
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 0);
+      CHECK(actual.str() == "");
+      CHECK(queue.begin() == queue.end());
+   }
+
+   SECTION("range has > 1 item") {
+      // Run
+      items = {4, 5, 6};
+      DEIntQueue queue(items.begin(), items.end());
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 3);
+      CHECK(actual.str() == "4 5 6 ");
+   }
+}
+
+TEST_CASE("DEIntQueue::insertBack appends a range to the back of a queue", "[DEIntQueue]") {
+   // Setup
+   std::vector<int> items{7, 8, 9};
+   std::stringstream actual;
+   DEIntQueue queue;
+
+   SECTION("queue is empty") {
+      // Run
+      queue.insertBack(items.begin(), items.end());
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 3);
+      CHECK(actual.str() == "7 8 9 ");
+      CHECK(queue.front() == 7);
+      CHECK(queue.back() == 9);
+   }
+
+   SECTION("queue is not empty") {
+      // Run
+      queue.pushBack(1);
+      queue.insertBack(items.begin(), items.end());
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 4);
+      CHECK(actual.str() == "1 7 8 9 ");
+      CHECK(*(--queue.last()) == 8);
+   }
+
+   SECTION("range is empty") {
+      // Run
+      queue.pushBack(1);
+      queue.insertBack(items.end(), items.end());
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 1);
+      CHECK(actual.str() == "1 ");
+   }
+}
+
+TEST_CASE("DEIntQueue::assign replaces the contents of a queue", "[DEIntQueue]") {
+   // Setup
+   DEIntQueue queue{1, 2, 3, 4};
+   DEIntQueue source{5, 6};
+   std::stringstream actual;
+
+   // Run
+   queue.assign(source.begin(), source.end());
+   actual << queue;
+
+   // Test
+   CHECK(queue.numEntries() == 2);
+   CHECK(actual.str() == "5 6 ");
+   CHECK(source.numEntries() == 2);
+}
+// END BULK INSERTION TESTS
+
+// CLEAR TESTS
+TEST_CASE("DEIntQueue::clear removes all entries", "[DEIntQueue]") {
+   // Setup
+   DEIntQueue queue;
+   std::stringstream actual;
+
+   SECTION("queue is empty") {
+      // Run
+      queue.clear();
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 0);
+      CHECK(actual.str() == "");
+   }
+
+   SECTION("queue has > 1 entry") {
+      // Run
+      for (int i = 0; i < 1000; i++) {
+         queue.pushBack(i);
+      }
+      queue.clear();
+      actual << queue;
+
+      // Test
+      CHECK(queue.numEntries() == 0);
+      CHECK(actual.str() == "");
+      CHECK(queue.begin() == queue.end());
+      REQUIRE_THROWS_AS(queue.front(), std::logic_error);
+   }
+}
+
+TEST_CASE("DEIntQueue::clear leaves a usable queue when release is deferred", "[DEIntQueue]") {
+   // Setup
+   DEIntQueue::setDeferredReleaseThreshold(10);
+   DEIntQueue small{1, 2, 3};
+   DEIntQueue large;
+   for (int i = 0; i < 1000; i++) {
+      large.pushBack(i);
+   }
+
+   // Run
+   small.clear();
+   large.clear();
+   large.pushBack(7);
+   {
+      DEIntQueue destroyed(large);   // destructor also releases through clear()
+      for (int i = 0; i < 100; i++) {
+         destroyed.pushFront(i);
+      }
+   }
+   DEIntQueue::waitForDeferredReleases();
+   DEIntQueue::setDeferredReleaseThreshold(0);
+
+   // Test
+   CHECK(small.numEntries() == 0);
+   CHECK(large.numEntries() == 1);
+   CHECK(large.front() == 7);
+   CHECK(large.back() == 7);
+}
+// END CLEAR TESTS
+
 // ITERATOR TESTS
 TEST_CASE("DEIntQueue iterator can access queue items in forward order", "[DEIntQueue]") {
    // Setup
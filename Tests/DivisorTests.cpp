@@ -0,0 +1,75 @@
+/** 
+ * @file DivisorTests.cpp
+ * @brief Defines catch2 unit tests for Divisor
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../Divisor.h"       // class being tested
+#include "TestHelpers.h"      // parseInfiniteInt
+
+/** checkAgainstOperators(const InfiniteInt&, const InfiniteInt&)
+ * @brief   Checks that a Divisor agrees with InfiniteInt's operator/ and operator%.
+*/
+static void checkAgainstOperators(const InfiniteInt& dividend, const InfiniteInt& divisorValue) {
+   // Setup
+   Divisor divisor(divisorValue);
+
+   // Run
+   InfiniteInt quotient = dividend / divisor;
+   InfiniteInt remainder = dividend % divisor;
+
+   // Test
+   CHECK(quotient == dividend / divisorValue);
+   CHECK(remainder == dividend % divisorValue);
+}
+
+// DIVISION TESTS
+TEST_CASE("[Divisor] Small divisors agree with InfiniteInt division", "[Divisor]") {
+   InfiniteInt dividend = parseInfiniteInt("31415926535897932384626433832795028841971693993751");
+   for (int value : { 1, -1, 7, 10, -12345, 99999999, 100000000, 999999999, -1000000000 }) {
+      checkAgainstOperators(dividend, InfiniteInt(value));
+      checkAgainstOperators(InfiniteInt(0) - dividend, InfiniteInt(value));
+   }
+   checkAgainstOperators(InfiniteInt(0), InfiniteInt(7));
+}
+
+TEST_CASE("[Divisor] Large divisors agree with InfiniteInt division", "[Divisor]") {
+   InfiniteInt dividend = parseInfiniteInt("27182818284590452353602874713526624977572470936999595749669676277240766303535");
+   for (const char* text : { "100000001", "-999999999", "1000000000000", "123456789012345678901",
+                             "27182818284590452353602874713526624977572470936999595749669676277240766303535",
+                             "-271828182845904523536028747135266249775724709369995957496696762772407663035350" }) {
+      checkAgainstOperators(dividend, parseInfiniteInt(text));
+      checkAgainstOperators(InfiniteInt(0) - dividend, parseInfiniteInt(text));
+   }
+}
+
+TEST_CASE("[Divisor] Divisors on both sides of the word arithmetic limit", "[Divisor]") {
+   // Setup: SMALL_DIVISOR_LIMIT is 10^9; dividend lengths cover partial and full leading chunks
+   InfiniteInt limit = parseInfiniteInt("1000000000");
+   for (const char* dividendText : { "999999999", "1000000000", "1999999999", "123456789012345678",
+                                     "9999999999999999999999999999", "1000000000000000000000000000" }) {
+      InfiniteInt dividend = parseInfiniteInt(dividendText);
+
+      // Run and Test: limit - 1 and limit use words, limit + 1 uses the multiples table
+      checkAgainstOperators(dividend, limit - InfiniteInt(1));
+      checkAgainstOperators(dividend, limit);
+      checkAgainstOperators(dividend, limit + InfiniteInt(1));
+      checkAgainstOperators(InfiniteInt(0) - dividend, InfiniteInt(0) - limit);
+   }
+   CHECK(parseInfiniteInt("999999999999999999") % Divisor(limit) == parseInfiniteInt("999999999"));
+}
+
+TEST_CASE("[Divisor] Dividends whose chunks are all zeroes or nines", "[Divisor]") {
+   InfiniteInt divisor = parseInfiniteInt("9999999999");
+   checkAgainstOperators(parseInfiniteInt("100000000000000000000000000000"), divisor);
+   checkAgainstOperators(parseInfiniteInt("99999999999999999999999999999"), divisor);
+   checkAgainstOperators(parseInfiniteInt("99999999990000000000"), divisor);
+}
+
+TEST_CASE("[Divisor] Zero divisors throw an exception", "[Divisor]") {
+   REQUIRE_THROWS_AS(Divisor(InfiniteInt(0)), std::domain_error);
+   CHECK(Divisor(InfiniteInt(-5)).value() == InfiniteInt(-5));
+}
+// END DIVISION TESTS
@@ -0,0 +1,93 @@
+/** 
+ * @file FactorizationTests.cpp
+ * @brief Defines catch2 unit tests for primality testing and factorization
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"            // catch2 required header
+#include "../Factorization.h"   // functions being tested
+#include "TestHelpers.h"        // parseInfiniteInt
+
+// PRIMALITY TESTS
+TEST_CASE("[Factorization] isProbablePrime accepts primes", "[Factorization primality]") {
+   CHECK(isProbablePrime(InfiniteInt(2)));
+   CHECK(isProbablePrime(InfiniteInt(97)));
+   CHECK(isProbablePrime(InfiniteInt(1000000007)));
+   CHECK(isProbablePrime(parseInfiniteInt("2305843009213693951")));
+}
+
+TEST_CASE("[Factorization] isProbablePrime rejects composites and small values", "[Factorization primality]") {
+   CHECK_FALSE(isProbablePrime(InfiniteInt(-7)));
+   CHECK_FALSE(isProbablePrime(InfiniteInt(0)));
+   CHECK_FALSE(isProbablePrime(InfiniteInt(1)));
+   CHECK_FALSE(isProbablePrime(InfiniteInt(561)));          // Carmichael number
+   CHECK_FALSE(isProbablePrime(InfiniteInt(3215031751)));   // strong pseudoprime to bases 2, 3, 5 and 7
+   CHECK_FALSE(isProbablePrime(parseInfiniteInt("998244359987710471")));
+   REQUIRE_THROWS_AS(isProbablePrime(InfiniteInt(7), 0), std::invalid_argument);
+   REQUIRE_THROWS_AS(isProbablePrime(InfiniteInt(7), 26), std::invalid_argument);
+}
+// END PRIMALITY TESTS
+
+// SPLITTING TESTS
+TEST_CASE("[Factorization] pollardBrent splits a semiprime", "[Factorization rho]") {
+   // Setup
+   InfiniteInt n = parseInfiniteInt("1000036000099");   // 1000003 * 1000033
+
+   // Run
+   InfiniteInt divisor = pollardBrent(n);
+
+   // Test
+   CHECK((divisor == InfiniteInt(1000003) || divisor == InfiniteInt(1000033)));
+}
+
+TEST_CASE("[Factorization] pollardBrent returns n when it runs out of steps", "[Factorization rho]") {
+   InfiniteInt n = parseInfiniteInt("1000036000099");
+   CHECK(pollardBrent(n, 1, 3) == n);
+}
+
+TEST_CASE("[Factorization] ecmFactor splits a semiprime", "[Factorization ECM]") {
+   // Setup
+   InfiniteInt n = parseInfiniteInt("1000036000099");
+
+   // Run
+   InfiniteInt divisor = ecmFactor(n, 16, 300, 2);
+
+   // Test
+   CHECK((divisor == InfiniteInt(1000003) || divisor == InfiniteInt(1000033)));
+   REQUIRE_THROWS_AS(ecmFactor(n, 0, 300), std::invalid_argument);
+   REQUIRE_THROWS_AS(ecmFactor(n, 4, 0), std::invalid_argument);
+   REQUIRE_THROWS_AS(ecmFactor(n, 4, 300, 1, 5), std::invalid_argument);
+}
+
+TEST_CASE("[Factorization] ecmFactor starting from a later sigma tries different curves", "[Factorization ECM]") {
+   // Setup
+   InfiniteInt n = parseInfiniteInt("1000036000099");
+
+   // Run - the curves factor() would use in its second round
+   InfiniteInt divisor = ecmFactor(n, 16, 300, 2, 6 + ECM_CURVES_PER_ROUND);
+
+   // Test
+   CHECK((divisor == InfiniteInt(1000003) || divisor == InfiniteInt(1000033)));
+}
+// END SPLITTING TESTS
+
+// FACTOR TESTS
+TEST_CASE("[Factorization] factor returns the primes in increasing order", "[Factorization factor]") {
+   // 2^5 * 3 * 97 * 1000003 * 1000033, negated
+   InfiniteInt n = parseInfiniteInt("-9312335232921888");
+   std::vector<InfiniteInt> expected = { InfiniteInt(2), InfiniteInt(2), InfiniteInt(2), InfiniteInt(2),
+                                         InfiniteInt(2), InfiniteInt(3), InfiniteInt(97),
+                                         InfiniteInt(1000003), InfiniteInt(1000033) };
+   CHECK(factor(n) == expected);
+}
+
+TEST_CASE("[Factorization] factor handles units, primes and prime powers", "[Factorization factor]") {
+   CHECK(factor(InfiniteInt(1)).empty());
+   CHECK(factor(InfiniteInt(-1)).empty());
+   CHECK(factor(InfiniteInt(1000000007)) == std::vector<InfiniteInt>{ InfiniteInt(1000000007) });
+   CHECK(factor(parseInfiniteInt("1000006000009")) ==
+         std::vector<InfiniteInt>{ InfiniteInt(1000003), InfiniteInt(1000003) });
+   REQUIRE_THROWS_AS(factor(InfiniteInt(0)), std::invalid_argument);
+}
+// END FACTOR TESTS
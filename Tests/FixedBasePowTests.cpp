@@ -0,0 +1,59 @@
+/** 
+ * @file FixedBasePowTests.cpp
+ * @brief Defines catch2 unit tests for FixedBasePow
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"            // catch2 required header
+#include "../FixedBasePow.h"    // class being tested
+#include "../NumberTheory.h"    // powmod as the reference
+#include <sstream>              // allow testing of InfiniteInt contents via printing
+
+// POW TESTS
+TEST_CASE("[FixedBasePow] pow computes small powers", "[FixedBasePow]") {
+   // Setup
+   FixedBasePow twos(InfiniteInt(2), InfiniteInt(1000000), 3);
+   std::stringstream actual;
+
+   // Run
+   actual << twos.pow(InfiniteInt(0)) << ' ' << twos.pow(InfiniteInt(1)) << ' '
+          << twos.pow(InfiniteInt(10)) << ' ' << twos.pow(InfiniteInt(19));
+
+   // Test
+   CHECK(actual.str() == "1 2 1024 524288");
+}
+
+TEST_CASE("[FixedBasePow] pow matches powmod for every exponent size up to the maximum", "[FixedBasePow]") {
+   // Setup
+   InfiniteInt base(-987654);
+   InfiniteInt modulus(1000000007);
+   FixedBasePow fixed(base, modulus, 12);
+   InfiniteInt exponent(0);
+
+   for (int numDigits = 1; numDigits <= 12; ++numDigits) {
+      // exponent = 90..., 909..., growing by one digit each round
+      exponent = exponent * InfiniteInt(10) + InfiniteInt(numDigits % 2 == 1 ? 9 : 0);
+
+      // Run and Test
+      CHECK(fixed.pow(exponent) == powmod(base, exponent, modulus));
+   }
+}
+
+TEST_CASE("[FixedBasePow] modulus of one always gives zero", "[FixedBasePow]") {
+   FixedBasePow fixed(InfiniteInt(5), InfiniteInt(1), 2);
+   CHECK(fixed.pow(InfiniteInt(0)) == InfiniteInt(0));
+   CHECK(fixed.pow(InfiniteInt(42)) == InfiniteInt(0));
+}
+
+TEST_CASE("[FixedBasePow] bad arguments throw exceptions", "[FixedBasePow]") {
+   REQUIRE_THROWS_AS(FixedBasePow(InfiniteInt(2), InfiniteInt(0), 3), std::invalid_argument);
+   REQUIRE_THROWS_AS(FixedBasePow(InfiniteInt(2), InfiniteInt(7), 0), std::invalid_argument);
+
+   FixedBasePow fixed(InfiniteInt(2), InfiniteInt(7), 3);
+   CHECK(fixed.maxExponentDigits() == 3);
+   CHECK(fixed.modulus() == InfiniteInt(7));
+   REQUIRE_THROWS_AS(fixed.pow(InfiniteInt(-1)), std::invalid_argument);
+   REQUIRE_THROWS_AS(fixed.pow(InfiniteInt(1000)), std::out_of_range);
+}
+// END POW TESTS
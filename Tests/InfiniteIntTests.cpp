@@ -7,7 +7,10 @@
 
 #include "catch.hpp"          // catch2 required header
 #include "../InfiniteInt.h"   // class being tested
+#include "TestHelpers.h"      // parseInfiniteInt
 #include <sstream>            // allow testing of InfiniteInt contents via printing
+#include <thread>             // concurrent toString() calls
+#include <vector>             // reader threads
 
 // CONSTRUCTOR TESTS
 TEST_CASE("[InfiniteInt] Default constructor creates an InfiniteInt representing 0", "[InfiniteInt constructors]") {
@@ -371,6 +374,66 @@ TEST_CASE("[InfiniteInt] Multiplication handles both arguments having > 1 digit"
 }
 // END MULTIPLICATION TESTS
 
+// DIVISION TESTS
+static void testDivision(const std::string& inputDescription,
+                         const InfiniteInt& lhs,
+                         const InfiniteInt& rhs,
+                         const std::string& expectedQuotient,
+                         const std::string& expectedRemainder)
+{
+   SECTION(inputDescription) {
+      // Setup
+      std::stringstream actualQuotient;
+      std::stringstream actualRemainder;
+
+      // Run
+      actualQuotient << lhs / rhs;
+      actualRemainder << lhs % rhs;
+
+      // Test
+      CHECK(actualQuotient.str() == expectedQuotient);
+      CHECK(actualRemainder.str() == expectedRemainder);
+   }
+}
+
+TEST_CASE("[InfiniteInt] Division truncates toward zero and the remainder takes the dividend's sign", "[InfiniteInt::operator/]") {
+   testDivision("lhs > 0, rhs > 0", parseInfiniteInt("56393342787"), InfiniteInt(123456), "456789", "3");
+   testDivision("lhs < 0, rhs > 0", InfiniteInt(-17), InfiniteInt(5), "-3", "-2");
+   testDivision("lhs > 0, rhs < 0", InfiniteInt(17), InfiniteInt(-5), "-3", "2");
+   testDivision("lhs < 0, rhs < 0", InfiniteInt(-17), InfiniteInt(-5), "3", "-2");
+   testDivision("Exact division", parseInfiniteInt("-646242752934"), InfiniteInt(987654), "-654321", "0");
+}
+
+TEST_CASE("[InfiniteInt] Division handles small dividends and zero", "[InfiniteInt::operator/]") {
+   testDivision("|lhs| < |rhs|", InfiniteInt(-42), InfiniteInt(1000), "0", "-42");
+   testDivision("lhs = 0", InfiniteInt(0), InfiniteInt(-7), "0", "0");
+   testDivision("rhs = 1", InfiniteInt(98765), InfiniteInt(1), "98765", "0");
+   testDivision("lhs = rhs", InfiniteInt(-98765), InfiniteInt(-98765), "1", "0");
+   testDivision("Zeroes inside the quotient", InfiniteInt(100000007), InfiniteInt(10), "10000000", "7");
+}
+
+TEST_CASE("[InfiniteInt] Division by zero throws an exception", "[InfiniteInt::operator/]") {
+   REQUIRE_THROWS_AS(InfiniteInt(5) / InfiniteInt(0), std::domain_error);
+   REQUIRE_THROWS_AS(InfiniteInt(-5) % InfiniteInt(0), std::domain_error);
+}
+
+TEST_CASE("[InfiniteInt] divExact divides exact multiples", "[InfiniteInt::divExact]") {
+   CHECK(parseInfiniteInt("56393342784").divExact(InfiniteInt(123456)) == InfiniteInt(456789));
+   CHECK(parseInfiniteInt("-646242752934").divExact(InfiniteInt(987654)) == InfiniteInt(-654321));
+   CHECK(InfiniteInt(-91).divExact(InfiniteInt(-7)) == InfiniteInt(13));
+   CHECK(InfiniteInt(0).divExact(InfiniteInt(-7)) == InfiniteInt(0));
+   CHECK(InfiniteInt(42).divExact(InfiniteInt(42)) == InfiniteInt(1));
+}
+
+TEST_CASE("[InfiniteInt] divExact handles divisors with factors of 2 and 5", "[InfiniteInt::divExact]") {
+   CHECK(InfiniteInt(123000).divExact(InfiniteInt(1000)) == InfiniteInt(123));
+   CHECK(InfiniteInt(98765 * 16).divExact(InfiniteInt(16)) == InfiniteInt(98765));
+   CHECK(InfiniteInt(4321 * 625).divExact(InfiniteInt(625)) == InfiniteInt(4321));
+   CHECK(InfiniteInt(777 * 2560).divExact(InfiniteInt(-2560)) == InfiniteInt(-777));
+   REQUIRE_THROWS_AS(InfiniteInt(5).divExact(InfiniteInt(0)), std::domain_error);
+}
+// END DIVISION TESTS
+
 // OPERATOR>> TESTS
 void testStreamInput(const std::string& inputDescription,
                      const std::string& inputText,
@@ -439,4 +502,116 @@ TEST_CASE("[InfiniteInt] Operator>> sets the InfiniteInt to zero for bad inputs"
    testStreamInput("First character after whitespace is non-digit", " z1234", InfiniteInt(456), "0", 1);
    testStreamInput("Minus sign followed by non-digit", "--1234", InfiniteInt(456), "0", 0);
 }
-// END OPERATOR>> TESTS
\ No newline at end of file
+// END OPERATOR>> TESTS
+// SHIFT TESTS
+static void testShift(const std::string& inputDescription,
+                      const InfiniteInt& input,
+                      int places,
+                      const std::string& expectedLeft,
+                      const std::string& expectedRight)
+{
+   SECTION(inputDescription) {
+      // Setup
+      std::stringstream actualLeft;
+      std::stringstream actualRight;
+
+      // Run
+      actualLeft << input.shiftLeft(places);
+      actualRight << input.shiftRight(places);
+
+      // Test
+      CHECK(actualLeft.str() == expectedLeft);
+      CHECK(actualRight.str() == expectedRight);
+   }
+}
+
+TEST_CASE("[InfiniteInt] shiftLeft and shiftRight multiply and divide by powers of ten", "[InfiniteInt shifts]") {
+   testShift("Positive, shift by 0", InfiniteInt(123), 0, "123", "123");
+   testShift("Positive, shift by < # of digits", InfiniteInt(12345), 2, "1234500", "123");
+   testShift("Negative, shift by < # of digits", InfiniteInt(-12345), 3, "-12345000", "-12");
+   testShift("Positive, shift by # of digits", InfiniteInt(987), 3, "987000", "0");
+   testShift("Negative, shift by > # of digits", InfiniteInt(-987), 5, "-98700000", "0");
+   testShift("Zero", InfiniteInt(0), 4, "0", "0");
+}
+
+TEST_CASE("[InfiniteInt] shifts throw an exception for negative places", "[InfiniteInt shifts]") {
+   REQUIRE_THROWS_AS(InfiniteInt(5).shiftLeft(-1), std::invalid_argument);
+   REQUIRE_THROWS_AS(InfiniteInt(5).shiftRight(-1), std::invalid_argument);
+}
+// END SHIFT TESTS
+
+// TO STRING TESTS
+TEST_CASE("[InfiniteInt] toString matches operator<< and is stable across calls", "[InfiniteInt::toString]") {
+   // Setup
+   InfiniteInt value = InfiniteInt(-123456789) * InfiniteInt(987654321);
+   std::stringstream printed;
+
+   // Run
+   std::string first = value.toString();
+   std::string second = value.toString();
+   printed << value;
+
+   // Test
+   CHECK(first == "-121932631112635269");
+   CHECK(second == first);
+   CHECK(printed.str() == first);
+   CHECK(InfiniteInt().toString() == "0");
+}
+
+TEST_CASE("[InfiniteInt] The cached text follows assignment and input", "[InfiniteInt::toString]") {
+   // Setup
+   InfiniteInt value(42);
+   CHECK(value.toString() == "42");
+
+   // Run and Test - assignment replaces the cached text
+   value = InfiniteInt(-7);
+   CHECK(value.toString() == "-7");
+
+   // Run and Test - reading into a printed InfiniteInt replaces the cached text
+   std::stringstream input("-9001 xyz");
+   input >> value;
+   CHECK(value.toString() == "-9001");
+   input >> value;
+   CHECK(value.toString() == "0");
+}
+
+TEST_CASE("[InfiniteInt] Results built from printed values print correctly", "[InfiniteInt::toString]") {
+   // Setup - cache the text of each operand first
+   InfiniteInt lhs(-1234);
+   InfiniteInt rhs(100);
+   lhs.toString();
+   rhs.toString();
+
+   // Run and Test
+   CHECK(InfiniteInt(lhs).toString() == "-1234");
+   CHECK(lhs.shiftLeft(2).toString() == "-123400");
+   CHECK(lhs.shiftRight(2).toString() == "-12");
+   CHECK((lhs % rhs).toString() == "-34");
+   CHECK((rhs % lhs).toString() == "100");
+   CHECK((lhs / rhs).toString() == "-12");
+}
+
+TEST_CASE("[InfiniteInt] toString can be called from several threads at once", "[InfiniteInt::toString]") {
+   // Setup
+   InfiniteInt value = InfiniteInt(2147483647) * InfiniteInt(2147483647) * InfiniteInt(-3);
+   std::vector<std::string> results(4);
+   std::vector<std::thread> readers;
+
+   // Run
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      readers.emplace_back([&value, &results, i]() {
+         for (int repeat = 0; repeat < 100; ++repeat) {
+            results[i] = value.toString();
+         }
+      });
+   }
+   for (std::thread& reader : readers) {
+      reader.join();
+   }
+
+   // Test
+   for (const std::string& result : results) {
+      CHECK(result == "-13835058042397261827");
+   }
+}
+// END TO STRING TESTS
@@ -0,0 +1,125 @@
+/** 
+ * @file InfiniteIntVectorTests.cpp
+ * @brief Defines catch2 unit tests for InfiniteIntVector
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"                // catch2 required header
+#include "../InfiniteIntVector.h"   // class being tested
+#include "TestHelpers.h"            // parseInfiniteInt
+#include <sstream>                  // printing views
+
+// STORAGE TESTS
+TEST_CASE("[InfiniteIntVector] Values round trip through the arena", "[InfiniteIntVector]") {
+   // Setup
+   std::vector<InfiniteInt> values;
+   for (const char* text : { "0", "-7", "123456789012345678901234567890", "-1000000000000000000001", "42" }) {
+      values.push_back(parseInfiniteInt(text));
+   }
+
+   // Run
+   InfiniteIntVector arena(values);
+
+   // Test
+   REQUIRE(arena.size() == values.size());
+   CHECK_FALSE(arena.empty());
+   CHECK(arena.toVector() == values);
+   CHECK(arena.get(2) == values[2]);
+   CHECK(arena[1].isNegative());
+   CHECK(arena[1].numDigits() == 1);
+   CHECK(arena[3].toString() == "-1000000000000000000001");
+   CHECK(arena[2].digit(0) == 1);
+   CHECK(arena[2].digit(29) == 0);
+   std::stringstream printed;
+   printed << arena[4];
+   CHECK(printed.str() == "42");
+   REQUIRE_THROWS_AS(arena[2].digit(30), std::out_of_range);
+   REQUIRE_THROWS_AS(arena.at(5), std::out_of_range);
+   REQUIRE_THROWS_AS(arena.get(5), std::out_of_range);
+}
+
+TEST_CASE("[InfiniteIntVector] pushBack, popBack and iteration", "[InfiniteIntVector]") {
+   // Setup
+   InfiniteIntVector arena;
+   arena.reserve(4, 20);
+   arena.pushBack(parseInfiniteInt("-98765"));
+   arena.pushBack(InfiniteInt(310));
+
+   // Run: copy a view of the vector's own value onto its end
+   arena.pushBack(arena[0]);
+   arena.pushBack(arena[1]);
+
+   // Test
+   std::vector<std::string> texts;
+   for (InfiniteIntVector::View view : arena) {
+      texts.push_back(view.toString());
+   }
+   CHECK(texts == std::vector<std::string>({ "-98765", "310", "-98765", "310" }));
+   arena.popBack();
+   CHECK(arena.size() == 3);
+   CHECK(arena[2] == arena[0]);
+   arena.clear();
+   CHECK(arena.empty());
+   CHECK(arena.begin() == arena.end());
+   REQUIRE_THROWS_AS(arena.popBack(), std::out_of_range);
+}
+
+TEST_CASE("[InfiniteIntVector] The arena is over ten times smaller than separate InfiniteInts", "[InfiniteIntVector]") {
+   // Setup
+   std::vector<InfiniteInt> values(1000, parseInfiniteInt("12345678901234567890"));
+
+   // Run
+   InfiniteIntVector arena(values);
+
+   // Test: 20 digit bytes, an offset, a length and a sign per value
+   CHECK(arena.memoryBytes() <= values.size() * (20 + sizeof(std::size_t) + sizeof(int) + 1));
+
+   // Test: a std::vector<InfiniteInt> holds each InfiniteInt plus one DEIntQueue
+   // node (a digit and two links) per digit; this lower bound ignores padding
+   // and allocator overhead, so the real saving is larger
+   std::size_t separateBytes = values.size() * (sizeof(InfiniteInt) + 20 * (sizeof(int) + 2 * sizeof(void*)));
+   CHECK(arena.memoryBytes() * 10 < separateBytes);
+}
+// END STORAGE TESTS
+
+// VIEW ARITHMETIC TESTS
+TEST_CASE("[InfiniteIntVector] Views compare like InfiniteInts", "[InfiniteIntVector]") {
+   // Setup
+   std::vector<InfiniteInt> values;
+   for (const char* text : { "-1000", "-999", "-5", "0", "3", "12", "998", "1000", "1000" }) {
+      values.push_back(parseInfiniteInt(text));
+   }
+   InfiniteIntVector arena(values);
+
+   // Test
+   for (std::size_t i = 0; i < values.size(); ++i) {
+      for (std::size_t j = 0; j < values.size(); ++j) {
+         CHECK((arena[i] < arena[j]) == (values[i] < values[j]));
+         CHECK((arena[i] == arena[j]) == (values[i] == values[j]));
+         CHECK((arena[i] != arena[j]) == (values[i] != values[j]));
+      }
+   }
+}
+
+TEST_CASE("[InfiniteIntVector] View arithmetic agrees with InfiniteInt arithmetic", "[InfiniteIntVector]") {
+   // Setup
+   std::vector<InfiniteInt> values;
+   for (const char* text : { "0", "1", "-1", "9999999999", "-10000000000", "123456789123456789",
+                             "-987654321987654321987654321", "500", "-499" }) {
+      values.push_back(parseInfiniteInt(text));
+   }
+   InfiniteIntVector arena(values);
+
+   // Test
+   for (std::size_t i = 0; i < values.size(); ++i) {
+      for (std::size_t j = 0; j < values.size(); ++j) {
+         CHECK(arena[i] + arena[j] == values[i] + values[j]);
+         CHECK(arena[i] - arena[j] == values[i] - values[j]);
+         CHECK(arena[i] * arena[j] == values[i] * values[j]);
+      }
+   }
+   CHECK((arena[0] - arena[0]).toString() == "0");
+   CHECK((arena[2] * arena[0]).toString() == "0");
+}
+// END VIEW ARITHMETIC TESTS
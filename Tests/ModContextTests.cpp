@@ -0,0 +1,44 @@
+/** 
+ * @file ModContextTests.cpp
+ * @brief Defines catch2 unit tests for ModContext
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../ModContext.h"    // class being tested
+#include "TestHelpers.h"      // parseInfiniteInt
+
+// MODULAR ARITHMETIC TESTS
+TEST_CASE("[ModContext] reduce maps values into range", "[ModContext]") {
+   // Setup
+   ModContext mod(InfiniteInt(97));
+
+   // Test
+   CHECK(mod.modulus() == InfiniteInt(97));
+   CHECK(mod.reduce(InfiniteInt(0)) == InfiniteInt(0));
+   CHECK(mod.reduce(InfiniteInt(200)) == InfiniteInt(6));
+   CHECK(mod.reduce(InfiniteInt(-1)) == InfiniteInt(96));
+   CHECK(mod.reduce(InfiniteInt(-194)) == InfiniteInt(0));
+}
+
+TEST_CASE("[ModContext] add, subtract and multiply wrap around the modulus", "[ModContext]") {
+   // Setup
+   InfiniteInt modulus = parseInfiniteInt("1000000000000000000000007");
+   ModContext mod(modulus);
+   InfiniteInt large = modulus - InfiniteInt(5);
+
+   // Test
+   CHECK(mod.add(large, InfiniteInt(9)) == InfiniteInt(4));
+   CHECK(mod.add(InfiniteInt(3), InfiniteInt(4)) == InfiniteInt(7));
+   CHECK(mod.subtract(InfiniteInt(3), InfiniteInt(4)) == modulus - InfiniteInt(1));
+   CHECK(mod.subtract(large, large) == InfiniteInt(0));
+   CHECK(mod.multiply(large, large) == InfiniteInt(25));
+}
+
+TEST_CASE("[ModContext] Moduli that are not positive throw an exception", "[ModContext]") {
+   REQUIRE_THROWS_AS(ModContext(InfiniteInt(0)), std::invalid_argument);
+   REQUIRE_THROWS_AS(ModContext(InfiniteInt(-7)), std::invalid_argument);
+   CHECK(ModContext(InfiniteInt(1)).reduce(InfiniteInt(12345)) == InfiniteInt(0));
+}
+// END MODULAR ARITHMETIC TESTS
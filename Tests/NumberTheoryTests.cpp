@@ -0,0 +1,269 @@
+/** 
+ * @file NumberTheoryTests.cpp
+ * @brief Defines catch2 unit tests for the number-theoretic functions
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../NumberTheory.h"  // functions being tested
+#include "TestHelpers.h"      // parseInfiniteInt and toText
+
+// POWMOD TESTS
+TEST_CASE("[NumberTheory] powmod computes small powers", "[NumberTheory powmod]") {
+   CHECK(toText(powmod(InfiniteInt(4), InfiniteInt(13), InfiniteInt(497))) == "445");
+   CHECK(toText(powmod(InfiniteInt(2), InfiniteInt(10), InfiniteInt(1000000))) == "1024");
+   CHECK(toText(powmod(InfiniteInt(7), InfiniteInt(0), InfiniteInt(13))) == "1");
+   CHECK(toText(powmod(InfiniteInt(0), InfiniteInt(5), InfiniteInt(13))) == "0");
+   CHECK(toText(powmod(InfiniteInt(123), InfiniteInt(456), InfiniteInt(1))) == "0");
+}
+
+TEST_CASE("[NumberTheory] powmod reduces negative bases into range", "[NumberTheory powmod]") {
+   CHECK(toText(powmod(InfiniteInt(-2), InfiniteInt(3), InfiniteInt(5))) == "2");
+   CHECK(toText(powmod(InfiniteInt(-2), InfiniteInt(2), InfiniteInt(5))) == "4");
+}
+
+TEST_CASE("[NumberTheory] powmod handles multi-digit exponents and moduli", "[NumberTheory powmod]") {
+   // Fermat: a^(p-1) = 1 mod p for the prime p = 2^61 - 1
+   InfiniteInt prime = parseInfiniteInt("2305843009213693951");
+   CHECK(toText(powmod(InfiniteInt(3), prime - InfiniteInt(1), prime)) == "1");
+   CHECK(toText(powmod(InfiniteInt(2), InfiniteInt(61), prime)) == "1");
+
+   // Exponents with zero digits inside: 2^1000 mod 10^9 + 7
+   CHECK(toText(powmod(InfiniteInt(2), InfiniteInt(1000), InfiniteInt(1000000007))) == "688423210");
+}
+
+TEST_CASE("[NumberTheory] powmod rejects bad arguments", "[NumberTheory powmod]") {
+   REQUIRE_THROWS_AS(powmod(InfiniteInt(2), InfiniteInt(-1), InfiniteInt(7)), std::invalid_argument);
+   REQUIRE_THROWS_AS(powmod(InfiniteInt(2), InfiniteInt(3), InfiniteInt(0)), std::invalid_argument);
+   REQUIRE_THROWS_AS(powmod(InfiniteInt(2), InfiniteInt(3), InfiniteInt(-7)), std::invalid_argument);
+}
+
+TEST_CASE("[NumberTheory] powmodBatch matches powmod entry by entry", "[NumberTheory powmod]") {
+   // Setup
+   InfiniteInt modulus = parseInfiniteInt("1000000000000000003");
+   std::vector<InfiniteInt> bases;
+   std::vector<InfiniteInt> exponents;
+   for (int i = 0; i < 23; ++i) {
+      bases.push_back(InfiniteInt(1000 * i - 7));
+      exponents.push_back(InfiniteInt(37 * i * i + i));
+   }
+
+   for (int numThreads : { 0, 1, 3, 64 }) {
+      // Run
+      std::vector<InfiniteInt> results = powmodBatch(bases, exponents, modulus, numThreads);
+
+      // Test
+      REQUIRE(results.size() == bases.size());
+      for (std::size_t i = 0; i < bases.size(); ++i) {
+         CHECK(results[i] == powmod(bases[i], exponents[i], modulus));
+      }
+   }
+}
+
+TEST_CASE("[NumberTheory] powmodBatch agrees with powmod for odd, even, small and very large moduli", "[NumberTheory powmod]") {
+   // Setup - odd moduli take the Montgomery path, including ones that fill
+   // whole 32-bit limbs; even moduli, 1 and moduli over 4096 bits do not
+   std::vector<std::string> moduli = { "1", "3", "4294967295", "4294967297", "18446744073709551557",
+                                       "340282366920938463463374607431768211507",
+                                       "123456789012345678901234567890123456789012345678901234567891",
+                                       "1000000000000000000000000000000000000000000000000000000000000",
+                                       "1" + std::string(1300, '0') + "1" };
+   std::vector<InfiniteInt> bases;
+   std::vector<InfiniteInt> exponents;
+   for (int i = 0; i < 11; ++i) {
+      bases.push_back(parseInfiniteInt(i % 2 == 0 ? "98765432109876543210987654321098765432109876543210987654321"
+                                               : "-31415926535897932384626433832795028841971"));
+      bases.back() = bases.back() * InfiniteInt(i + 1) + InfiniteInt(i);
+      exponents.push_back(InfiniteInt(i == 0 ? 0 : 1234567 * i));
+   }
+   bases.push_back(InfiniteInt(0));
+   exponents.push_back(InfiniteInt(5));
+
+   for (const std::string& modulusText : moduli) {
+      InfiniteInt modulus = parseInfiniteInt(modulusText);
+      std::vector<InfiniteInt> batchBases = bases;
+      std::vector<InfiniteInt> batchExponents = exponents;
+      if (modulusText.size() > 1000) {
+         // Keep the reference powmods quick
+         batchBases = { InfiniteInt(3), InfiniteInt(2), InfiniteInt(5) };
+         batchExponents = { InfiniteInt(0), InfiniteInt(1), InfiniteInt(3) };
+      }
+
+      // Run
+      std::vector<InfiniteInt> results = powmodBatch(batchBases, batchExponents, modulus, 2);
+
+      // Test
+      REQUIRE(results.size() == batchBases.size());
+      for (std::size_t i = 0; i < batchBases.size(); ++i) {
+         CHECK(results[i] == powmod(batchBases[i], batchExponents[i], modulus));
+      }
+   }
+}
+
+TEST_CASE("[NumberTheory] powmodBatch handles empty batches and rejects bad arguments", "[NumberTheory powmod]") {
+   CHECK(powmodBatch({}, {}, InfiniteInt(7)).empty());
+   REQUIRE_THROWS_AS(powmodBatch({ InfiniteInt(2) }, {}, InfiniteInt(7)), std::invalid_argument);
+   REQUIRE_THROWS_AS(powmodBatch({ InfiniteInt(2) }, { InfiniteInt(-1) }, InfiniteInt(7)), std::invalid_argument);
+   REQUIRE_THROWS_AS(powmodBatch({ InfiniteInt(2) }, { InfiniteInt(1) }, InfiniteInt(0)), std::invalid_argument);
+   REQUIRE_THROWS_AS(powmodBatch({ InfiniteInt(2) }, { InfiniteInt(1) }, InfiniteInt(7), -1), std::invalid_argument);
+}
+// END POWMOD TESTS
+
+// MULTIPOWMOD TESTS
+TEST_CASE("[NumberTheory] multiPowmod matches the product of separate powmods", "[NumberTheory multiPowmod]") {
+   // Setup
+   InfiniteInt modulus = parseInfiniteInt("99999999977");
+   std::vector<InfiniteInt> bases = { InfiniteInt(2), InfiniteInt(-3), InfiniteInt(123456789), InfiniteInt(0) };
+   std::vector<InfiniteInt> exponents = { parseInfiniteInt("1000000000000"), InfiniteInt(7), InfiniteInt(90509), InfiniteInt(0) };
+   InfiniteInt expected(1);
+   for (std::size_t i = 0; i < bases.size(); ++i) {
+      expected = (expected * powmod(bases[i], exponents[i], modulus)) % modulus;
+   }
+
+   // Run
+   InfiniteInt actual = multiPowmod(bases, exponents, modulus);
+
+   // Test
+   CHECK(actual == expected);
+}
+
+TEST_CASE("[NumberTheory] multiPowmod handles small cases", "[NumberTheory multiPowmod]") {
+   CHECK(toText(multiPowmod({ InfiniteInt(2), InfiniteInt(3) }, { InfiniteInt(10), InfiniteInt(2) }, InfiniteInt(100000))) == "9216");
+   CHECK(toText(multiPowmod({ InfiniteInt(5) }, { InfiniteInt(3) }, InfiniteInt(7))) == "6");
+   CHECK(toText(multiPowmod({}, {}, InfiniteInt(7))) == "1");
+   CHECK(toText(multiPowmod({ InfiniteInt(5) }, { InfiniteInt(3) }, InfiniteInt(1))) == "0");
+}
+
+TEST_CASE("[NumberTheory] multiPowmod rejects bad arguments", "[NumberTheory multiPowmod]") {
+   REQUIRE_THROWS_AS(multiPowmod({ InfiniteInt(2) }, {}, InfiniteInt(7)), std::invalid_argument);
+   REQUIRE_THROWS_AS(multiPowmod({ InfiniteInt(2) }, { InfiniteInt(-1) }, InfiniteInt(7)), std::invalid_argument);
+   REQUIRE_THROWS_AS(multiPowmod({ InfiniteInt(2) }, { InfiniteInt(1) }, InfiniteInt(0)), std::invalid_argument);
+}
+// END MULTIPOWMOD TESTS
+
+// GCD AND INVERSE TESTS
+TEST_CASE("[NumberTheory] gcd handles signs and zero", "[NumberTheory gcd]") {
+   CHECK(gcd(InfiniteInt(1071), InfiniteInt(462)) == InfiniteInt(21));
+   CHECK(gcd(InfiniteInt(-1071), InfiniteInt(462)) == InfiniteInt(21));
+   CHECK(gcd(InfiniteInt(0), InfiniteInt(-5)) == InfiniteInt(5));
+   CHECK(gcd(InfiniteInt(0), InfiniteInt(0)) == InfiniteInt(0));
+   CHECK(gcd(parseInfiniteInt("2305843009213693951"), parseInfiniteInt("1000000007")) == InfiniteInt(1));
+}
+
+TEST_CASE("[NumberTheory] modInverse returns the inverse in range", "[NumberTheory gcd]") {
+   CHECK(modInverse(InfiniteInt(17), InfiniteInt(3120)) == InfiniteInt(2753));
+   CHECK(modInverse(InfiniteInt(-3), InfiniteInt(7)) == InfiniteInt(2));
+   CHECK(modInverse(InfiniteInt(5), InfiniteInt(1)) == InfiniteInt(0));
+}
+
+TEST_CASE("[NumberTheory] modInverse rejects non-invertible values", "[NumberTheory gcd]") {
+   REQUIRE_THROWS_AS(modInverse(InfiniteInt(6), InfiniteInt(9)), std::domain_error);
+   REQUIRE_THROWS_AS(modInverse(InfiniteInt(0), InfiniteInt(9)), std::domain_error);
+   REQUIRE_THROWS_AS(modInverse(InfiniteInt(2), InfiniteInt(0)), std::invalid_argument);
+}
+// END GCD AND INVERSE TESTS
+
+// CRT TESTS
+TEST_CASE("[NumberTheory] crt solves small systems", "[NumberTheory crt]") {
+   CHECK(crt({ InfiniteInt(2), InfiniteInt(3), InfiniteInt(2) }, { InfiniteInt(3), InfiniteInt(5), InfiniteInt(7) }) == InfiniteInt(23));
+   CHECK(crt({ InfiniteInt(-1) }, { InfiniteInt(10) }) == InfiniteInt(9));
+   CHECK(crt({ InfiniteInt(4), InfiniteInt(0) }, { InfiniteInt(5), InfiniteInt(1) }) == InfiniteInt(4));
+}
+
+TEST_CASE("[NumberTheory] crt reconstructs a large number from many prime moduli", "[NumberTheory crt]") {
+   // Setup - the first 60 primes, whose product exceeds the value
+   InfiniteInt value = parseInfiniteInt("31415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679");
+   std::vector<InfiniteInt> moduli;
+   std::vector<InfiniteInt> residues;
+   for (int candidate = 2; moduli.size() < 60; ++candidate) {
+      bool isPrime{true};
+      for (int divisor = 2; divisor * divisor <= candidate; ++divisor) {
+         isPrime = isPrime && candidate % divisor != 0;
+      }
+      if (isPrime) {
+         moduli.push_back(InfiniteInt(candidate));
+         residues.push_back(value % InfiniteInt(candidate));
+      }
+   }
+
+   for (int numThreads : { 1, 4 }) {
+      // Run and Test
+      CHECK(crt(residues, moduli, numThreads) == value);
+   }
+}
+
+TEST_CASE("[NumberTheory] crt rejects bad arguments", "[NumberTheory crt]") {
+   REQUIRE_THROWS_AS(crt({}, {}), std::invalid_argument);
+   REQUIRE_THROWS_AS(crt({ InfiniteInt(1) }, {}), std::invalid_argument);
+   REQUIRE_THROWS_AS(crt({ InfiniteInt(1) }, { InfiniteInt(0) }), std::invalid_argument);
+   REQUIRE_THROWS_AS(crt({ InfiniteInt(1), InfiniteInt(2) }, { InfiniteInt(6), InfiniteInt(9) }), std::domain_error);
+}
+// END CRT TESTS
+
+// BATCH GCD TESTS
+TEST_CASE("[NumberTheory] batchGcd finds the factors each value shares with the rest", "[NumberTheory batchGcd]") {
+   // Setup
+   std::vector<InfiniteInt> values = { InfiniteInt(6), InfiniteInt(10), InfiniteInt(15), InfiniteInt(7),
+                                       InfiniteInt(35), InfiniteInt(11), InfiniteInt(143), InfiniteInt(1) };
+   std::vector<InfiniteInt> expected = { InfiniteInt(6), InfiniteInt(10), InfiniteInt(15), InfiniteInt(7),
+                                         InfiniteInt(35), InfiniteInt(11), InfiniteInt(11), InfiniteInt(1) };
+
+   // Run and Test
+   CHECK(batchGcd(values, 1) == expected);
+   CHECK(batchGcd(values, 3) == expected);
+}
+
+TEST_CASE("[NumberTheory] batchGcd finds a prime shared by two large moduli", "[NumberTheory batchGcd]") {
+   // Setup - RSA-style moduli, two of which share the prime 1000000007
+   std::vector<InfiniteInt> values = { InfiniteInt(1000000007) * InfiniteInt(998244353),
+                                       InfiniteInt(1000000009) * InfiniteInt(999999937),
+                                       InfiniteInt(1000000007) * InfiniteInt(2147483647) };
+
+   // Run
+   std::vector<InfiniteInt> results = batchGcd(values, 2, ".");
+
+   // Test
+   CHECK(results[0] == InfiniteInt(1000000007));
+   CHECK(results[1] == InfiniteInt(1));
+   CHECK(results[2] == InfiniteInt(1000000007));
+   CHECK(batchGcd(values, 2) == results);
+}
+
+TEST_CASE("[NumberTheory] batchGcd handles trivial input and rejects bad values", "[NumberTheory batchGcd]") {
+   CHECK(batchGcd({}).empty());
+   CHECK(batchGcd({ InfiniteInt(12) }) == std::vector<InfiniteInt>{ InfiniteInt(1) });
+   REQUIRE_THROWS_AS(batchGcd({ InfiniteInt(3), InfiniteInt(0) }), std::invalid_argument);
+   REQUIRE_THROWS_AS(batchGcd({ InfiniteInt(3), InfiniteInt(2), InfiniteInt(5) }, 1, "/nonexistent/directory"), std::runtime_error);
+}
+// END BATCH GCD TESTS
+
+// MULTIMOD TESTS
+TEST_CASE("[NumberTheory] multiMod matches one division per modulus", "[NumberTheory multiMod]") {
+   // Setup
+   InfiniteInt value = parseInfiniteInt("-27182818284590452353602874713526624977572470936999595749669676277");
+   std::vector<InfiniteInt> moduli;
+   for (int i = 1; i <= 40; ++i) {
+      moduli.push_back(InfiniteInt(i * i * 7919 + 3));
+   }
+   moduli.push_back(parseInfiniteInt("100000000000000000000000000000000000000000000000000000000000000000000000"));
+
+   // Run
+   std::vector<InfiniteInt> residues = multiMod(value, moduli, 3);
+
+   // Test
+   REQUIRE(residues.size() == moduli.size());
+   for (std::size_t i = 0; i < moduli.size(); ++i) {
+      InfiniteInt expected = value % moduli[i];
+      if (expected < InfiniteInt(0)) {
+         expected = expected + moduli[i];
+      }
+      CHECK(residues[i] == expected);
+   }
+}
+
+TEST_CASE("[NumberTheory] multiMod handles empty input and rejects bad moduli", "[NumberTheory multiMod]") {
+   CHECK(multiMod(InfiniteInt(5), {}).empty());
+   REQUIRE_THROWS_AS(multiMod(InfiniteInt(5), { InfiniteInt(3), InfiniteInt(-3) }), std::invalid_argument);
+}
+// END MULTIMOD TESTS
@@ -0,0 +1,121 @@
+/** 
+ * @file PowerCacheTests.cpp
+ * @brief Defines catch2 unit tests for PowerCache
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../PowerCache.h"    // class being tested
+#include <sstream>            // allow testing of InfiniteInt contents via printing
+#include <thread>             // concurrent readers
+#include <vector>             // reader threads
+
+/** repeatedProduct(int, int)
+ * @brief   Reference result: base multiplied by itself exponent times.
+*/
+static InfiniteInt repeatedProduct(int base, int exponent) {
+   InfiniteInt result(1);
+   for (int i = 0; i < exponent; ++i) {
+      result = result * InfiniteInt(base);
+   }
+   return result;
+}
+
+// POWER TESTS
+TEST_CASE("[PowerCache] power returns base^exponent for small exponents", "[PowerCache]") {
+   // Setup
+   PowerCache twos(2);
+   PowerCache sevens(7);
+   std::stringstream actual;
+
+   // Run
+   actual << twos.power(10) << ' ' << sevens.power(3) << ' ' << twos.power(0) << ' ' << sevens.power(1);
+
+   // Test
+   CHECK(actual.str() == "1024 343 1 7");
+}
+
+TEST_CASE("[PowerCache] power handles exponents beyond the direct table", "[PowerCache]") {
+   // Setup
+   PowerCache threes(3);
+   int exponent = PowerCache::DIRECT_EXPONENTS + 37;
+
+   // Run and Test
+   CHECK(threes.power(exponent) == repeatedProduct(3, exponent));
+}
+
+TEST_CASE("[PowerCache] powers of ten are digit shifts", "[PowerCache]") {
+   // Setup
+   std::stringstream actual;
+
+   // Run
+   actual << PowerCache::shared(10).power(12) << ' ' << PowerCache::shared(10).tower(2);
+
+   // Test
+   CHECK(actual.str() == "1000000000000 10000");
+}
+
+TEST_CASE("[PowerCache] tower returns base^(2^level)", "[PowerCache]") {
+   // Setup
+   PowerCache twos(2);
+
+   // Run and Test
+   CHECK(twos.tower(0) == InfiniteInt(2));
+   CHECK(twos.tower(4) == InfiniteInt(65536));
+   CHECK(twos.tower(7) == repeatedProduct(2, 128));
+   REQUIRE_THROWS_AS(twos.tower(PowerCache::TOWER_LEVELS), std::out_of_range);
+   REQUIRE_THROWS_AS(twos.power(-1), std::invalid_argument);
+}
+// END POWER TESTS
+
+// CACHE BEHAVIOUR TESTS
+TEST_CASE("[PowerCache] cache never holds more digits than its budget", "[PowerCache]") {
+   // Setup
+   PowerCache limited(2, 40);
+
+   // Run
+   InfiniteInt big = limited.power(200);
+
+   // Test
+   CHECK(big == repeatedProduct(2, 200));
+   CHECK(limited.cachedDigits() <= 40);
+   CHECK(limited.cachedDigits() > 0);
+}
+
+TEST_CASE("[PowerCache] shared returns one cache per base", "[PowerCache]") {
+   CHECK(&PowerCache::shared(5) == &PowerCache::shared(5));
+   CHECK(&PowerCache::shared(5) != &PowerCache::shared(6));
+   CHECK(PowerCache::shared(6).base() == 6);
+   REQUIRE_THROWS_AS(PowerCache::shared(1), std::invalid_argument);
+   REQUIRE_THROWS_AS(PowerCache::shared(PowerCache::MAX_SHARED_BASE + 1), std::invalid_argument);
+}
+
+TEST_CASE("[PowerCache] concurrent readers all see the same powers", "[PowerCache]") {
+   // Setup
+   PowerCache elevens(11);
+   const int numThreads = 4;
+   std::vector<int> mismatches(numThreads, 0);
+   std::vector<std::thread> readers;
+   InfiniteInt expected = repeatedProduct(11, 150);
+
+   // Run
+   for (int t = 0; t < numThreads; ++t) {
+      readers.emplace_back([&elevens, &mismatches, &expected, t]() {
+         for (int i = 0; i < 20; ++i) {
+            if (elevens.power(150) != expected) {
+               ++mismatches[t];
+            }
+         }
+      });
+   }
+   for (auto& reader : readers) {
+      reader.join();
+   }
+
+   // Test
+   for (int t = 0; t < numThreads; ++t) {
+      CHECK(mismatches[t] == 0);
+   }
+}
+// END CACHE BEHAVIOUR TESTS
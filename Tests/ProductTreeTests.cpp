@@ -0,0 +1,72 @@
+/** 
+ * @file ProductTreeTests.cpp
+ * @brief Defines catch2 unit tests for ProductTree
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../ProductTree.h"   // class being tested
+
+// CONSTRUCTOR TESTS
+TEST_CASE("[ProductTree] Levels hold pairwise products with unpaired nodes carried up", "[ProductTree]") {
+   // Setup
+   std::vector<InfiniteInt> values = { InfiniteInt(2), InfiniteInt(3), InfiniteInt(5), InfiniteInt(7), InfiniteInt(11) };
+
+   // Run
+   ProductTree tree(values, 2);
+
+   // Test
+   REQUIRE(tree.numLevels() == 4);
+   CHECK(tree.level(0) == values);
+   CHECK(tree.level(1) == std::vector<InfiniteInt>{ InfiniteInt(6), InfiniteInt(35), InfiniteInt(11) });
+   CHECK(tree.level(2) == std::vector<InfiniteInt>{ InfiniteInt(210), InfiniteInt(11) });
+   CHECK(tree.root() == InfiniteInt(2310));
+   CHECK(tree.numThreads() == 2);
+}
+
+TEST_CASE("[ProductTree] A single value is its own root", "[ProductTree]") {
+   ProductTree tree({ InfiniteInt(-42) });
+   CHECK(tree.numLevels() == 1);
+   CHECK(tree.root() == InfiniteInt(-42));
+}
+
+TEST_CASE("[ProductTree] Bad arguments throw exceptions", "[ProductTree]") {
+   REQUIRE_THROWS_AS(ProductTree({}), std::invalid_argument);
+   REQUIRE_THROWS_AS(ProductTree({ InfiniteInt(2) }, -1), std::invalid_argument);
+
+   ProductTree tree({ InfiniteInt(2), InfiniteInt(3) });
+   REQUIRE_THROWS_AS(tree.level(-1), std::out_of_range);
+   REQUIRE_THROWS_AS(tree.level(2), std::out_of_range);
+}
+// END CONSTRUCTOR TESTS
+
+// REMAINDER TESTS
+TEST_CASE("[ProductTree] remainders reduces a value modulo every leaf", "[ProductTree]") {
+   // Setup
+   ProductTree tree({ InfiniteInt(7), InfiniteInt(10), InfiniteInt(13), InfiniteInt(1), InfiniteInt(1000) }, 2);
+
+   // Run
+   std::vector<InfiniteInt> positive = tree.remainders(InfiniteInt(123456789));
+   std::vector<InfiniteInt> negative = tree.remainders(InfiniteInt(-123456789));
+
+   // Test
+   CHECK(positive == std::vector<InfiniteInt>{ InfiniteInt(1), InfiniteInt(9), InfiniteInt(1), InfiniteInt(0), InfiniteInt(789) });
+   CHECK(negative == std::vector<InfiniteInt>{ InfiniteInt(6), InfiniteInt(1), InfiniteInt(12), InfiniteInt(0), InfiniteInt(211) });
+}
+
+TEST_CASE("[ProductTree] Single levels can be built and reduced without a tree", "[ProductTree]") {
+   // Setup
+   std::vector<InfiniteInt> values = { InfiniteInt(2), InfiniteInt(3), InfiniteInt(5), InfiniteInt(7), InfiniteInt(11) };
+
+   // Run
+   std::vector<InfiniteInt> above = ProductTree::productLevel(values, 2);
+   std::vector<InfiniteInt> reduced = ProductTree::remainderLevel(
+      { InfiniteInt(100), InfiniteInt(-50), InfiniteInt(23) }, values, 2);
+
+   // Test
+   CHECK(above == ProductTree(values).level(1));
+   CHECK(reduced == std::vector<InfiniteInt>{ InfiniteInt(0), InfiniteInt(1), InfiniteInt(0), InfiniteInt(-1), InfiniteInt(1) });
+   REQUIRE_THROWS_AS(ProductTree::remainderLevel({ InfiniteInt(1) }, { InfiniteInt(0) }, 1), std::domain_error);
+}
+// END REMAINDER TESTS
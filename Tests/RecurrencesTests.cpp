@@ -0,0 +1,94 @@
+/** 
+ * @file RecurrencesTests.cpp
+ * @brief Defines catch2 unit tests for the Fibonacci, Lucas and linear-recurrence functions
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../Recurrences.h"   // functions being tested
+#include "TestHelpers.h"      // toText
+
+// FIBONACCI AND LUCAS TESTS
+TEST_CASE("[Recurrences] fibonacci matches repeated addition", "[Recurrences fibonacci]") {
+   // Setup
+   InfiniteInt previous(0);
+   InfiniteInt current(1);
+
+   // Run / Test
+   CHECK(fibonacci(0) == InfiniteInt(0));
+   for (long long n = 1; n <= 120; ++n) {
+      CHECK(fibonacci(n) == current);
+      InfiniteInt next = previous + current;
+      previous = current;
+      current = next;
+   }
+   CHECK(toText(fibonacci(100)) == "354224848179261915075");
+}
+
+TEST_CASE("[Recurrences] lucas computes known values", "[Recurrences lucas]") {
+   const int expected[] = { 2, 1, 3, 4, 7, 11, 18, 29, 47, 76, 123 };
+   for (int n = 0; n <= 10; ++n) {
+      CHECK(lucas(n) == InfiniteInt(expected[n]));
+   }
+   CHECK(toText(lucas(50)) == "28143753123");
+   CHECK(toText(lucas(200)) == "627376215338105766356982006981782561278127");
+}
+
+TEST_CASE("[Recurrences] Modular fibonacci and lucas reach huge indices", "[Recurrences fibonacci lucas]") {
+   // Setup
+   ModContext mod(InfiniteInt(1000000007));
+
+   // Test
+   CHECK(toText(fibonacci(1000000000000000000LL, mod)) == "209783453");
+   CHECK(toText(lucas(1000000000000000000LL, mod)) == "150331332");
+   CHECK(fibonacci(300, mod) == mod.reduce(fibonacci(300)));
+   CHECK(lucas(300, mod) == mod.reduce(lucas(300)));
+}
+
+TEST_CASE("[Recurrences] Negative indices throw an exception", "[Recurrences fibonacci lucas]") {
+   ModContext mod(InfiniteInt(10));
+   REQUIRE_THROWS_AS(fibonacci(-1), std::invalid_argument);
+   REQUIRE_THROWS_AS(fibonacci(-1, mod), std::invalid_argument);
+   REQUIRE_THROWS_AS(lucas(-1), std::invalid_argument);
+   REQUIRE_THROWS_AS(lucas(-1, mod), std::invalid_argument);
+}
+// END FIBONACCI AND LUCAS TESTS
+
+// LINEAR RECURRENCE TESTS
+TEST_CASE("[Recurrences] linearRecurrence reproduces fibonacci and lucas", "[Recurrences linearRecurrence]") {
+   // Setup
+   std::vector<InfiniteInt> coeffs = { InfiniteInt(1), InfiniteInt(1) };
+
+   // Test
+   for (long long n = 0; n <= 60; ++n) {
+      CHECK(linearRecurrence(coeffs, { InfiniteInt(0), InfiniteInt(1) }, n) == fibonacci(n));
+      CHECK(linearRecurrence(coeffs, { InfiniteInt(2), InfiniteInt(1) }, n) == lucas(n));
+   }
+}
+
+TEST_CASE("[Recurrences] linearRecurrence handles tribonacci and signed coefficients", "[Recurrences linearRecurrence]") {
+   // Setup
+   std::vector<InfiniteInt> tribonacci = { InfiniteInt(1), InfiniteInt(1), InfiniteInt(1) };
+   std::vector<InfiniteInt> start = { InfiniteInt(0), InfiniteInt(0), InfiniteInt(1) };
+   // a(j) = 3a(j-1) - 2a(j-2) with a(0) = 0, a(1) = 1 gives 2^j - 1
+   std::vector<InfiniteInt> mersenne = { InfiniteInt(3), InfiniteInt(-2) };
+
+   // Test
+   CHECK(toText(linearRecurrence(tribonacci, start, 37)) == "1132436852");
+   CHECK(toText(linearRecurrence(tribonacci, start, 100000, ModContext(InfiniteInt(998244353))))
+         == "845115824");
+   CHECK(toText(linearRecurrence(mersenne, { InfiniteInt(0), InfiniteInt(1) }, 64))
+         == "18446744073709551615");
+   CHECK(toText(linearRecurrence(mersenne, { InfiniteInt(0), InfiniteInt(1) }, 64, ModContext(InfiniteInt(1000))))
+         == "615");
+   CHECK(linearRecurrence({ InfiniteInt(5) }, { InfiniteInt(-3) }, 4) == InfiniteInt(-1875));
+}
+
+TEST_CASE("[Recurrences] linearRecurrence rejects bad arguments", "[Recurrences linearRecurrence]") {
+   std::vector<InfiniteInt> coeffs = { InfiniteInt(1), InfiniteInt(1) };
+   REQUIRE_THROWS_AS(linearRecurrence({}, {}, 3), std::invalid_argument);
+   REQUIRE_THROWS_AS(linearRecurrence(coeffs, { InfiniteInt(0) }, 3), std::invalid_argument);
+   REQUIRE_THROWS_AS(linearRecurrence(coeffs, { InfiniteInt(0), InfiniteInt(1) }, -1), std::invalid_argument);
+}
+// END LINEAR RECURRENCE TESTS
@@ -0,0 +1,169 @@
+/** 
+ * @file SPSCIntQueueTests.cpp
+ * @brief Defines catch2 unit tests for SPSCIntQueue
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../SPSCIntQueue.h"  // class being tested
+#include <thread>             // producer and consumer threads
+#include <vector>             // batch buffers
+
+// CONSTRUCTOR TESTS
+TEST_CASE("SPSCIntQueue constructor creates empty queue with power of two capacity", "[SPSCIntQueue]") {
+   // Run
+   SPSCIntQueue queue(5);
+
+   // Test
+   CHECK(queue.numEntries() == 0);
+   CHECK(queue.capacity() == 8);
+}
+
+TEST_CASE("SPSCIntQueue constructor rejects non-positive capacities", "[SPSCIntQueue]") {
+   REQUIRE_THROWS_AS(SPSCIntQueue(0), std::invalid_argument);
+   REQUIRE_THROWS_AS(SPSCIntQueue(-1), std::invalid_argument);
+}
+// END CONSTRUCTOR TESTS
+
+// PUSH/POP TESTS
+TEST_CASE("SPSCIntQueue returns items in first-in first-out order", "[SPSCIntQueue]") {
+   // Setup
+   SPSCIntQueue queue(4);
+
+   // Run
+   queue.pushBack(1);
+   queue.pushBack(2);
+   queue.pushBack(3);
+
+   // Test
+   CHECK(queue.numEntries() == 3);
+   CHECK(queue.front() == 1);
+   queue.popFront();
+   CHECK(queue.front() == 2);
+   queue.popFront();
+   CHECK(queue.front() == 3);
+   queue.popFront();
+   CHECK(queue.numEntries() == 0);
+}
+
+TEST_CASE("SPSCIntQueue throws exceptions when empty or full", "[SPSCIntQueue]") {
+   // Setup
+   SPSCIntQueue queue(2);
+   int item{-1};
+
+   SECTION("queue is empty") {
+      REQUIRE_THROWS_AS(queue.front(), std::logic_error);
+      REQUIRE_THROWS_AS(queue.popFront(), std::logic_error);
+      CHECK_FALSE(queue.tryPopFront(item));
+      CHECK(item == -1);
+   }
+
+   SECTION("queue is full") {
+      queue.pushBack(1);
+      queue.pushBack(2);
+      REQUIRE_THROWS_AS(queue.pushBack(3), std::overflow_error);
+      CHECK_FALSE(queue.tryPushBack(3));
+      CHECK(queue.numEntries() == 2);
+   }
+}
+
+TEST_CASE("SPSCIntQueue reuses slots after wrapping around", "[SPSCIntQueue]") {
+   // Setup
+   SPSCIntQueue queue(4);
+   int item{0};
+
+   // Run and Test
+   for (int i = 0; i < 100; ++i) {
+      REQUIRE(queue.tryPushBack(i));
+      REQUIRE(queue.tryPushBack(i + 1000));
+      REQUIRE(queue.tryPopFront(item));
+      CHECK(item == i);
+      REQUIRE(queue.tryPopFront(item));
+      CHECK(item == i + 1000);
+   }
+   CHECK(queue.numEntries() == 0);
+}
+// END PUSH/POP TESTS
+
+// BATCH TESTS
+TEST_CASE("SPSCIntQueue batch push adds only as many items as fit", "[SPSCIntQueue]") {
+   // Setup
+   SPSCIntQueue queue(4);
+   std::vector<int> items{1, 2, 3, 4, 5, 6};
+   std::vector<int> popped(6, 0);
+   queue.pushBack(0);
+
+   // Run
+   int numPushed = queue.pushBack(items.data(), static_cast<int>(items.size()));
+   int numPopped = queue.popFront(popped.data(), static_cast<int>(popped.size()));
+
+   // Test
+   CHECK(numPushed == 3);
+   CHECK(numPopped == 4);
+   CHECK(popped[0] == 0);
+   CHECK(popped[1] == 1);
+   CHECK(popped[2] == 2);
+   CHECK(popped[3] == 3);
+   CHECK(queue.numEntries() == 0);
+}
+
+TEST_CASE("SPSCIntQueue batch pop returns zero for an empty queue", "[SPSCIntQueue]") {
+   // Setup
+   SPSCIntQueue queue(4);
+   int items[2] = {-1, -1};
+
+   // Run and Test
+   CHECK(queue.popFront(items, 2) == 0);
+   CHECK(items[0] == -1);
+}
+// END BATCH TESTS
+
+// CONCURRENCY TESTS
+TEST_CASE("SPSCIntQueue hands items from a producer thread to a consumer thread in order", "[SPSCIntQueue]") {
+   // Setup
+   const int numItems = 200000;
+   SPSCIntQueue queue(64);
+   std::vector<int> received;
+   received.reserve(numItems);
+
+   // Run - the producer alternates single and batch pushes
+   std::thread producer([&queue, numItems]() {
+      int batch[16];
+      int next{0};
+      while (next < numItems) {
+         int pushed{0};
+         if (next % 2 == 0) {
+            pushed = queue.tryPushBack(next) ? 1 : 0;
+         } else {
+            int count{0};
+            for (; count < 16 && next + count < numItems; ++count) {
+               batch[count] = next + count;
+            }
+            pushed = queue.pushBack(batch, count);
+         }
+         next += pushed;
+         if (pushed == 0) {
+            std::this_thread::yield();   // let the consumer run on machines with few cores
+         }
+      }
+   });
+   int batch[8];
+   while (static_cast<int>(received.size()) < numItems) {
+      int count = queue.popFront(batch, 8);
+      received.insert(received.end(), batch, batch + count);
+      if (count == 0) {
+         std::this_thread::yield();
+      }
+   }
+   producer.join();
+
+   // Test
+   bool inOrder{true};
+   for (int i = 0; i < numItems; ++i) {
+      inOrder = inOrder && (received[i] == i);
+   }
+   CHECK(inOrder);
+   CHECK(queue.numEntries() == 0);
+}
+// END CONCURRENCY TESTS
@@ -0,0 +1,85 @@
+/** 
+ * @file SortingTests.cpp
+ * @brief Defines catch2 unit tests for sortInfiniteInts
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"          // catch2 required header
+#include "../Sorting.h"       // function being tested
+#include "TestHelpers.h"      // parseInfiniteInt
+#include <algorithm>          // std::sort as the reference order
+
+/** checkSortedLikeStdSort(const std::vector<InfiniteInt>&, int)
+ * @brief   Checks that sortInfiniteInts puts values in the same order as std::sort.
+*/
+static void checkSortedLikeStdSort(const std::vector<InfiniteInt>& values, int numThreads) {
+   // Setup
+   std::vector<InfiniteInt> expected = values;
+   std::sort(expected.begin(), expected.end());
+   std::vector<InfiniteInt> actual = values;
+
+   // Run
+   sortInfiniteInts(actual, numThreads);
+
+   // Test
+   CHECK(actual == expected);
+}
+
+// SORTING TESTS
+TEST_CASE("[Sorting] Short lists and small values", "[Sorting]") {
+   std::vector<InfiniteInt> empty;
+   sortInfiniteInts(empty);
+   CHECK(empty.empty());
+
+   std::vector<InfiniteInt> small;
+   for (int value : { 5, -3, 0, 12, -40, 7, 0, -3, 100, -1, 9 }) {
+      small.push_back(InfiniteInt(value));
+   }
+   checkSortedLikeStdSort(small, 1);
+   checkSortedLikeStdSort(std::vector<InfiniteInt>(1, InfiniteInt(-8)), 1);
+}
+
+TEST_CASE("[Sorting] Long values that share their leading digits", "[Sorting]") {
+   // Setup: every value has the same first 20 digits, so only full comparisons can order them
+   std::vector<InfiniteInt> values;
+   const std::string shared = "12345678901234567890";
+   for (const char* tail : { "5", "3", "9", "3", "0", "71", "70", "" }) {
+      values.push_back(parseInfiniteInt(shared + tail));
+      values.push_back(parseInfiniteInt("-" + shared + tail));
+   }
+   values.push_back(parseInfiniteInt("123456789012345678"));
+   values.push_back(parseInfiniteInt("-123456789012345679"));
+
+   // Test
+   checkSortedLikeStdSort(values, 1);
+   checkSortedLikeStdSort(values, 3);
+}
+
+TEST_CASE("[Sorting] Many values of mixed signs and lengths", "[Sorting]") {
+   // Setup
+   std::vector<InfiniteInt> values;
+   unsigned long long seed = 42;
+   for (int i = 0; i < 3000; ++i) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      int length = static_cast<int>(seed >> 58) % 30 + 1;
+      std::string text = (seed >> 20) % 2 == 0 ? "-" : "";
+      for (int d = 0; d < length; ++d) {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         // Few distinct leading digits make long radix runs and ties likely
+         text += static_cast<char>('0' + (d < 19 ? (seed >> 61) % 2 + 1 : (seed >> 60) % 10));
+      }
+      values.push_back(parseInfiniteInt(text));
+   }
+
+   // Test
+   for (int numThreads : { 1, 2, 4 }) {
+      checkSortedLikeStdSort(values, numThreads);
+   }
+}
+
+TEST_CASE("[Sorting] Negative thread counts throw an exception", "[Sorting]") {
+   std::vector<InfiniteInt> values(3, InfiniteInt(1));
+   REQUIRE_THROWS_AS(sortInfiniteInts(values, -1), std::invalid_argument);
+}
+// END SORTING TESTS
@@ -0,0 +1,36 @@
+/** 
+ * @file TestHelpers.h
+ * @brief Helpers shared by the catch2 unit tests for converting InfiniteInts
+ *    to and from decimal text
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+#include "../InfiniteInt.h"  // Type being converted
+#include <sstream>           // Reading and printing decimal text
+#include <string>            // Decimal text
+
+/** parseInfiniteInt(const std::string&)
+ * @brief   Parses decimal text, with an optional leading minus sign, into an
+ *          InfiniteInt. Lets tests use values too large for an int.
+*/
+inline InfiniteInt parseInfiniteInt(const std::string& text) {
+   std::stringstream stream(text);
+   InfiniteInt result;
+   stream >> result;
+   return result;
+}
+
+/** toText(const InfiniteInt&)
+ * @brief   Returns the decimal text of an InfiniteInt.
+*/
+inline std::string toText(const InfiniteInt& value) {
+   std::stringstream stream;
+   stream << value;
+   return stream.str();
+}
+
+#endif // TESTHELPERS_H
@@ -0,0 +1,157 @@
+/** 
+ * @file WorkStealingDequeTests.cpp
+ * @brief Defines catch2 unit tests and a stress harness for WorkStealingDeque
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#include "catch.hpp"               // catch2 required header
+#include "../WorkStealingDeque.h"  // class being tested
+#include <atomic>                  // shared stop flag
+#include <thread>                  // owner and thief threads
+#include <vector>                  // per-item take counts
+
+// SINGLE THREAD TESTS
+TEST_CASE("WorkStealingDeque constructor creates empty deque", "[WorkStealingDeque]") {
+   // Setup
+   int item{-1};
+
+   // Run
+   WorkStealingDeque deque(3);
+
+   // Test
+   CHECK(deque.numEntries() == 0);
+   CHECK(deque.capacity() == 4);
+   CHECK_FALSE(deque.popBack(item));
+   CHECK_FALSE(deque.steal(item));
+   CHECK(item == -1);
+   REQUIRE_THROWS_AS(WorkStealingDeque(0), std::invalid_argument);
+}
+
+TEST_CASE("WorkStealingDeque owner pops in last-in first-out order", "[WorkStealingDeque]") {
+   // Setup
+   WorkStealingDeque deque;
+   int item{0};
+
+   // Run
+   deque.pushBack(1);
+   deque.pushBack(2);
+   deque.pushBack(3);
+
+   // Test
+   REQUIRE(deque.popBack(item));
+   CHECK(item == 3);
+   REQUIRE(deque.popBack(item));
+   CHECK(item == 2);
+   REQUIRE(deque.popBack(item));
+   CHECK(item == 1);
+   CHECK_FALSE(deque.popBack(item));
+   CHECK(deque.numEntries() == 0);
+}
+
+TEST_CASE("WorkStealingDeque thieves steal in first-in first-out order", "[WorkStealingDeque]") {
+   // Setup
+   WorkStealingDeque deque;
+   int item{0};
+   deque.pushBack(1);
+   deque.pushBack(2);
+   deque.pushBack(3);
+
+   // Run and Test
+   REQUIRE(deque.steal(item));
+   CHECK(item == 1);
+   REQUIRE(deque.popBack(item));
+   CHECK(item == 3);
+   REQUIRE(deque.steal(item));
+   CHECK(item == 2);
+   CHECK_FALSE(deque.steal(item));
+}
+
+TEST_CASE("WorkStealingDeque grows and keeps entries in order", "[WorkStealingDeque]") {
+   // Setup
+   WorkStealingDeque deque(2);
+   int item{0};
+   deque.pushBack(0);
+   REQUIRE(deque.steal(item));   // move top away from index 0 before growing
+
+   // Run
+   for (int i = 1; i <= 100; ++i) {
+      deque.pushBack(i);
+   }
+
+   // Test
+   CHECK(deque.capacity() >= 100);
+   CHECK(deque.numEntries() == 100);
+   for (int i = 1; i <= 50; ++i) {
+      REQUIRE(deque.steal(item));
+      CHECK(item == i);
+   }
+   for (int i = 100; i > 50; --i) {
+      REQUIRE(deque.popBack(item));
+      CHECK(item == i);
+   }
+}
+// END SINGLE THREAD TESTS
+
+// STRESS TESTS
+TEST_CASE("WorkStealingDeque hands every item to exactly one thread under contention", "[WorkStealingDeque]") {
+   // Setup
+   const int numItems = 200000;
+   const int numThieves = 4;
+   WorkStealingDeque deque(4);   // small, so the owner grows it while thieves work
+   std::vector<std::atomic<int>> takeCounts(numItems);
+   for (auto& count : takeCounts) {
+      count.store(0);
+   }
+   std::atomic<bool> done(false);
+
+   // Run - thieves steal until the owner is finished and the deque is empty
+   std::vector<std::thread> thieves;
+   for (int t = 0; t < numThieves; ++t) {
+      thieves.emplace_back([&deque, &takeCounts, &done]() {
+         int item;
+         while (!done.load() || deque.numEntries() > 0) {
+            if (deque.steal(item)) {
+               takeCounts[item].fetch_add(1);
+            } else {
+               std::this_thread::yield();   // let the owner run on machines with few cores
+            }
+         }
+      });
+   }
+
+   // The owner pushes in bursts and pops some of its own work back
+   int item;
+   for (int next = 0; next < numItems;) {
+      for (int burst = 0; burst < 64 && next < numItems; ++burst, ++next) {
+         deque.pushBack(next);
+      }
+      for (int pops = 0; pops < 16; ++pops) {
+         if (deque.popBack(item)) {
+            takeCounts[item].fetch_add(1);
+         }
+      }
+   }
+   while (deque.popBack(item)) {
+      takeCounts[item].fetch_add(1);
+   }
+   done.store(true);
+   for (auto& thief : thieves) {
+      thief.join();
+   }
+
+   // Test
+   int missing{0};
+   int duplicated{0};
+   for (auto& count : takeCounts) {
+      if (count.load() == 0) {
+         ++missing;
+      } else if (count.load() > 1) {
+         ++duplicated;
+      }
+   }
+   CHECK(missing == 0);
+   CHECK(duplicated == 0);
+   CHECK(deque.numEntries() == 0);
+}
+// END STRESS TESTS
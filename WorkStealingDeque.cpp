@@ -0,0 +1,193 @@
+/** 
+ * @file WorkStealingDeque.cpp
+ * @brief Implementation for WorkStealingDeque, a lock-free Chase-Lev deque of
+ *    integers. One owner thread pushes and pops at the back; any number of
+ *    other threads steal from the front.
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+#include "WorkStealingDeque.h"
+
+/* The memory orderings follow Le, Pop, Cohen and Zappa Nardelli, "Correct
+   and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). The
+   seq_cst fences in popBack and steal order the owner's write of bottom_
+   against a thief's read of it when both go after the last entry. */
+
+/** Array(long long)
+ * @brief   Creates an array with the given power-of-two capacity.
+*/
+WorkStealingDeque::Array::Array(long long capacity)
+   : mask_(capacity - 1), slots_(new std::atomic<int>[capacity]), retired_(nullptr) { }
+
+/** ~Array()
+ * @brief   Frees the slots of this array (but not of retired arrays).
+*/
+WorkStealingDeque::Array::~Array() {
+   delete[] slots_;
+   slots_ = nullptr;
+}
+
+/** WorkStealingDeque(int)
+ * @brief   Constructor.
+ * @param   initialCapacity   The number of entries the deque holds before it
+ *                            first grows
+ * @pre     initialCapacity is greater than 0.
+ * @post    This deque is empty. Its capacity is initialCapacity rounded up
+ *          to a power of two.
+ * @throw   std::invalid_argument if initialCapacity is less than 1 or too large.
+*/
+WorkStealingDeque::WorkStealingDeque(int initialCapacity) : top_(0), bottom_(0), array_(nullptr) {
+   if (initialCapacity < 1 || initialCapacity > (1 << 30)) {
+      throw std::invalid_argument("WorkStealingDeque capacity must be between 1 and 2^30.");
+   }
+
+   // Round the capacity up to a power of two so indices can be masked
+   long long capacity{1};
+   while (capacity < initialCapacity) {
+      capacity <<= 1;
+   }
+   array_.store(new Array(capacity), std::memory_order_relaxed);
+}
+
+/** ~WorkStealingDeque()
+ * @brief   Destructor.
+ * @pre     No other thread is using this deque.
+ * @post    All dynamically allocated memory, including arrays retired by
+ *          growth, has been returned to the system.
+*/
+WorkStealingDeque::~WorkStealingDeque() {
+   Array* toDelete = array_.load(std::memory_order_relaxed);
+   while (toDelete != nullptr) {
+      Array* retired = toDelete->retired_;
+      delete toDelete;
+      toDelete = retired;
+   }
+}
+
+/** pushBack(int)
+ * @brief   Adds an integer to the back of this deque.
+ * @param   newItem  The integer being added to this deque.
+ * @post    newItem is the last entry of this deque. If the array was full,
+ *          it has been replaced by one twice as large.
+*/
+void WorkStealingDeque::pushBack(int newItem) {
+   long long bottom = bottom_.load(std::memory_order_relaxed);
+   long long top = top_.load(std::memory_order_acquire);
+   Array* array = array_.load(std::memory_order_relaxed);
+
+   // Grow if the array is full
+   if (bottom - top > array->capacity() - 1) {
+      array = grow(array, bottom, top);
+   }
+
+   // Write the entry, then make it visible to thieves
+   array->put(bottom, newItem);
+   std::atomic_thread_fence(std::memory_order_release);
+   bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+/** popBack(int&)
+ * @brief   Removes the last integer from this deque, if there is one.
+ * @param   item     Set to the removed integer
+ * @post    If this deque was not empty and no thief took the last entry
+ *          first, that entry has been removed and stored in item.
+ * @return  True if an integer was removed and false otherwise.
+*/
+bool WorkStealingDeque::popBack(int& item) {
+   // Claim the last entry before looking at top_
+   long long bottom = bottom_.load(std::memory_order_relaxed) - 1;
+   Array* array = array_.load(std::memory_order_relaxed);
+   bottom_.store(bottom, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   long long top = top_.load(std::memory_order_relaxed);
+
+   if (top > bottom) {
+      // The deque was empty - undo the claim
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+   }
+
+   bool taken{true};  // whether the owner got the entry
+   int candidate = array->get(bottom);
+   if (top == bottom) {
+      // Only one entry left - race the thieves for it by advancing top_
+      taken = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+   }
+
+   if (taken) {
+      item = candidate;
+   }
+   return taken;
+}
+
+/** steal(int&)
+ * @brief   Removes the first integer from this deque, if there is one.
+ * @param   item     Set to the removed integer
+ * @post    If this deque was not empty and no other thread removed the first
+ *          entry first, that entry has been removed and stored in item.
+ * @return  True if an integer was removed. False if this deque was empty or
+ *          another thread won the race; callers may simply try again.
+*/
+bool WorkStealingDeque::steal(int& item) {
+   long long top = top_.load(std::memory_order_acquire);
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   long long bottom = bottom_.load(std::memory_order_acquire);
+
+   if (top >= bottom) {
+      // Empty
+      return false;
+   }
+
+   // Read the entry before claiming it; the claim fails if anyone else got there first
+   Array* array = array_.load(std::memory_order_acquire);
+   int candidate = array->get(top);
+   if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      return false;
+   }
+
+   item = candidate;
+   return true;
+}
+
+/** numEntries()
+ * @brief   Returns the number of entries in this deque.
+ * @post    The returned value is an estimate that may be stale by the time
+ *          the caller uses it. It is never negative.
+ * @return  The number of entries in this deque.
+*/
+int WorkStealingDeque::numEntries() const {
+   long long bottom = bottom_.load(std::memory_order_acquire);
+   long long top = top_.load(std::memory_order_acquire);
+   return bottom > top ? static_cast<int>(bottom - top) : 0;
+}
+
+/** capacity()
+ * @brief   Returns the number of entries the current array can hold.
+ * @return  The capacity of this deque's current array.
+*/
+int WorkStealingDeque::capacity() const {
+   return static_cast<int>(array_.load(std::memory_order_acquire)->capacity());
+}
+
+/** grow(Array*, long long, long long)
+ * @brief   Owner helper. Replaces the current array with one twice as large.
+ * @param   old      The current array
+ * @param   bottom   The current value of bottom_
+ * @param   top      A value of top_ read after bottom_
+ * @post    The entries in [top, bottom) have been copied to the new array,
+ *          which has been published. The old array is kept until this
+ *          deque is destroyed, since thieves may still be reading it.
+ * @return  The new array.
+*/
+WorkStealingDeque::Array* WorkStealingDeque::grow(Array* old, long long bottom, long long top) {
+   Array* bigger = new Array(old->capacity() * 2);
+   for (long long i = top; i < bottom; ++i) {
+      bigger->put(i, old->get(i));
+   }
+   bigger->retired_ = old;
+   array_.store(bigger, std::memory_order_release);
+   return bigger;
+}
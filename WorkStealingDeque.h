@@ -0,0 +1,137 @@
+/** 
+ * @file WorkStealingDeque.h
+ * @brief Class definition for WorkStealingDeque, a lock-free Chase-Lev deque of
+ *    integers. One owner thread pushes and pops at the back; any number of
+ *    other threads steal from the front.
+ * @author Carl Mofjeld
+ * @date 11/23/2020
+*/
+
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include <atomic>    // Indices and slots shared between threads
+#include <exception> // Exceptions
+#include <stdexcept> // std::invalid_argument
+
+class WorkStealingDeque {
+public:
+   //PUBLIC METHODS
+   /** WorkStealingDeque(int)
+    * @brief   Constructor.
+    * @param   initialCapacity   The number of entries the deque holds before it
+    *                            first grows
+    * @pre     initialCapacity is greater than 0.
+    * @post    This deque is empty. Its capacity is initialCapacity rounded up
+    *          to a power of two.
+    * @throw   std::invalid_argument if initialCapacity is less than 1 or too large.
+   */
+   explicit WorkStealingDeque(int initialCapacity = 64);
+
+   /** ~WorkStealingDeque()
+    * @brief   Destructor.
+    * @pre     No other thread is using this deque.
+    * @post    All dynamically allocated memory, including arrays retired by
+    *          growth, has been returned to the system.
+   */
+   ~WorkStealingDeque();
+
+   // Thieves hold pointers into the arrays, so the deque cannot be copied
+   WorkStealingDeque(const WorkStealingDeque&) = delete;
+   WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+   // OWNER METHODS - only the owning thread may call these
+
+   /** pushBack(int)
+    * @brief   Adds an integer to the back of this deque.
+    * @param   newItem  The integer being added to this deque.
+    * @post    newItem is the last entry of this deque. If the array was full,
+    *          it has been replaced by one twice as large.
+   */
+   void pushBack(int newItem);
+
+   /** popBack(int&)
+    * @brief   Removes the last integer from this deque, if there is one.
+    * @param   item     Set to the removed integer
+    * @post    If this deque was not empty and no thief took the last entry
+    *          first, that entry has been removed and stored in item.
+    * @return  True if an integer was removed and false otherwise.
+   */
+   bool popBack(int& item);
+
+   // THIEF METHODS - any thread may call these
+
+   /** steal(int&)
+    * @brief   Removes the first integer from this deque, if there is one.
+    * @param   item     Set to the removed integer
+    * @post    If this deque was not empty and no other thread removed the first
+    *          entry first, that entry has been removed and stored in item.
+    * @return  True if an integer was removed. False if this deque was empty or
+    *          another thread won the race; callers may simply try again.
+   */
+   bool steal(int& item);
+
+   // OBSERVERS - safe from any thread
+
+   /** numEntries()
+    * @brief   Returns the number of entries in this deque.
+    * @post    The returned value is an estimate that may be stale by the time
+    *          the caller uses it. It is never negative.
+    * @return  The number of entries in this deque.
+   */
+   int numEntries() const;
+
+   /** capacity()
+    * @brief   Returns the number of entries the current array can hold.
+    * @return  The capacity of this deque's current array.
+   */
+   int capacity() const;
+
+private:
+   /** Array
+    * @brief   Circular array of slots used by WorkStealingDeque. Indices are
+    *          masked, so they may grow without bound.
+   */
+   struct Array {
+      long long mask_;             // capacity - 1; capacity is a power of two
+      std::atomic<int>* slots_;    // the entries
+      Array* retired_;             // the array this one replaced, if any
+
+      /** Array(long long)
+       * @brief   Creates an array with the given power-of-two capacity.
+      */
+      explicit Array(long long capacity);
+
+      /** ~Array()
+       * @brief   Frees the slots of this array (but not of retired arrays).
+      */
+      ~Array();
+
+      long long capacity() const { return mask_ + 1; }
+      int get(long long index) const { return slots_[index & mask_].load(std::memory_order_relaxed); }
+      void put(long long index, int item) { slots_[index & mask_].store(item, std::memory_order_relaxed); }
+   };
+
+   // DATA MEMBERS
+   static const int CACHE_LINE_SIZE = 64;  // bytes; keeps thief and owner state apart
+
+   std::atomic<long long> top_;     // index of the first entry; advanced by thieves and the owner
+   char pad0_[CACHE_LINE_SIZE - sizeof(std::atomic<long long>)];
+   std::atomic<long long> bottom_;  // index one past the last entry; written by the owner only
+   std::atomic<Array*> array_;      // current array; replaced by the owner only
+
+   // PRIVATE FUNCTIONS
+   /** grow(Array*, long long, long long)
+    * @brief   Owner helper. Replaces the current array with one twice as large.
+    * @param   old      The current array
+    * @param   bottom   The current value of bottom_
+    * @param   top      A value of top_ read after bottom_
+    * @post    The entries in [top, bottom) have been copied to the new array,
+    *          which has been published. The old array is kept until this
+    *          deque is destroyed, since thieves may still be reading it.
+    * @return  The new array.
+   */
+   Array* grow(Array* old, long long bottom, long long top);
+};
+
+#endif // WORKSTEALINGDEQUE_H
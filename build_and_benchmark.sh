@@ -0,0 +1,11 @@
+#!/usr/bin/env bash
+
+# compile benchmarks with optimization
+g++ -std=c++11 -O2 -pthread ./Benchmarks/ArithmeticBenchmark.cpp InfiniteInt.cpp DEIntQueue.cpp SPSCIntQueue.cpp ConcurrentDEIntQueue.cpp WorkStealingDeque.cpp PowerCache.cpp NumberTheory.cpp FixedBasePow.cpp ProductTree.cpp Factorization.cpp Divisor.cpp ModContext.cpp Recurrences.cpp BigPoly.cpp BigMatrix.cpp Sorting.cpp InfiniteIntVector.cpp -o ./Build/ArithmeticBenchmark
+g++ -std=c++11 -O2 -pthread ./Benchmarks/ConcurrentDEIntQueueBenchmark.cpp ConcurrentDEIntQueue.cpp -o ./Build/ConcurrentDEIntQueueBenchmark
+g++ -std=c++11 -O2 -pthread ./Benchmarks/ContainerBenchmark.cpp DEIntQueue.cpp -o ./Build/ContainerBenchmark
+
+# run compiled benchmarks
+./Build/ArithmeticBenchmark
+./Build/ConcurrentDEIntQueueBenchmark
+./Build/ContainerBenchmark
@@ -1,7 +1,7 @@
 #!/usr/bin/env bash
 
 # compile test code
-g++ -std=c++11 -g ./Tests/*.cpp InfiniteInt.cpp DEIntQueue.cpp -o ./Build/TestMain
+g++ -std=c++11 -g -pthread ./Tests/*.cpp InfiniteInt.cpp DEIntQueue.cpp SPSCIntQueue.cpp ConcurrentDEIntQueue.cpp WorkStealingDeque.cpp PowerCache.cpp NumberTheory.cpp FixedBasePow.cpp ProductTree.cpp Factorization.cpp Divisor.cpp ModContext.cpp Recurrences.cpp BigPoly.cpp BigMatrix.cpp Sorting.cpp InfiniteIntVector.cpp -o ./Build/TestMain
 
 # run compiled tests
 valgrind ./Build/TestMain
\ No newline at end of file
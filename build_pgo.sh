@@ -0,0 +1,16 @@
+#!/usr/bin/env bash
+# Two-stage profile-guided optimized build in ./Build/pgo.
+# Extra arguments are passed to both configure steps (e.g. -DINFINITEINT_ENABLE_LTO=ON).
+set -e
+
+BUILD_DIR=./Build/pgo
+
+# stage 1: instrumented build, trained on the benchmark suite
+cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DINFINITEINT_PGO=GENERATE "$@"
+cmake --build "$BUILD_DIR" -j
+cmake --build "$BUILD_DIR" --target pgo-train
+
+# stage 2: rebuild everything using the recorded profiles
+cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DINFINITEINT_PGO=USE "$@"
+cmake --build "$BUILD_DIR" -j --clean-first
+ctest --test-dir "$BUILD_DIR" --output-on-failure